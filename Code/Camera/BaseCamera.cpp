@@ -1,9 +1,13 @@
 #include "BaseCamera.h"
 
+#include <string.h>
+
 // ------------------------------------------------------------ //
 
 BaseCamera::BaseCamera()
-	: mViewMatrix()
+	: mInputHandler(nullptr)
+	, mViewMatrix()
+	, mPerspectiveMatrix()
 	, mPosition(0.0f, 0.0f, 0.0f)
 	, mRight(1.0f, 0.0f, 0.0)
 	, mUp(0.0f, 1.0f, 0.0f)
@@ -11,10 +15,17 @@ BaseCamera::BaseCamera()
 	, mNearPlane(0.01f)
 	, mFarPlane(100.0f)
 	, mAspectRatio(16.0f / 9.0f)
-	, mPerspectiveMatrix()
-	, mInputHandler(nullptr)
 	, mMovementSpeed(1.0f)
 	, mRotationSpeed(0.1f)
+	, mTransposedViewMatrix()
+	, mTransposedPerspectiveMatrix()
+	, mTransposedViewProjectionMatrix()
+	, mInverseViewMatrix()
+	, mInversePerspectiveMatrix()
+	, mInverseViewProjectionMatrix()
+	, mViewVersion(0)
+	, mPerspectiveVersion(0)
+	, mFrustum()
 {
 	//ReCalculateViewMatrix();
 	//ReCalculatePerspectiveMatrix();
@@ -23,7 +34,9 @@ BaseCamera::BaseCamera()
 // ------------------------------------------------------------ //
 
 BaseCamera::BaseCamera(InputHandler* inputHandler, Vector3D startPos, Vector3D right, Vector3D up, float FOV, float nearPlane, float farPlane, float aspect, float movementSpeed, float rotationSpeed)
-	: mViewMatrix()
+	: mInputHandler(inputHandler)
+	, mViewMatrix()
+	, mPerspectiveMatrix()
 	, mPosition(startPos)
 	, mRight(right.Normalise())
 	, mUp(up.Normalise())
@@ -31,10 +44,17 @@ BaseCamera::BaseCamera(InputHandler* inputHandler, Vector3D startPos, Vector3D r
 	, mNearPlane(nearPlane)
 	, mFarPlane(farPlane)
 	, mAspectRatio(aspect)
-	, mPerspectiveMatrix()
-	, mInputHandler(inputHandler)
 	, mMovementSpeed(movementSpeed)
 	, mRotationSpeed(rotationSpeed)
+	, mTransposedViewMatrix()
+	, mTransposedPerspectiveMatrix()
+	, mTransposedViewProjectionMatrix()
+	, mInverseViewMatrix()
+	, mInversePerspectiveMatrix()
+	, mInverseViewProjectionMatrix()
+	, mViewVersion(0)
+	, mPerspectiveVersion(0)
+	, mFrustum()
 {
 	//ReCalculateViewMatrix();
 	//ReCalculatePerspectiveMatrix();
@@ -62,9 +82,12 @@ void BaseCamera::ReCalculateViewMatrix()
 	Vector3D viewDir    = mRight.Cross(mUp);
 	Vector3D focalPoint = mPosition + viewDir;
 
-	DirectX::XMStoreFloat4x4(&mViewMatrix, DirectX::XMMatrixLookAtLH(DirectX::XMVectorSet(mPosition.x, mPosition.y, mPosition.z, 0.0f), 
-																	 DirectX::XMVectorSet(focalPoint.x, focalPoint.y, focalPoint.z, 0.0f), 
-																	 DirectX::XMVectorSet(mUp.x, mUp.y, mUp.z, 0.0f)));
+	DirectX::XMFLOAT4X4 viewMatrix;
+	DirectX::XMStoreFloat4x4(&viewMatrix, DirectX::XMMatrixLookAtLH(DirectX::XMVectorSet(mPosition.x, mPosition.y, mPosition.z, 0.0f), 
+																	DirectX::XMVectorSet(focalPoint.x, focalPoint.y, focalPoint.z, 0.0f), 
+																	DirectX::XMVectorSet(mUp.x, mUp.y, mUp.z, 0.0f)));
+
+	SetViewMatrix(viewMatrix);
 }
 
 // ------------------------------------------------------------ //
@@ -72,7 +95,64 @@ void BaseCamera::ReCalculateViewMatrix()
 void BaseCamera::ReCalculatePerspectiveMatrix()
 {
 	// We are going to be mainly using perspective so re-calculate the view matrix of a perspective view
-	DirectX::XMStoreFloat4x4(&mPerspectiveMatrix, DirectX::XMMatrixPerspectiveFovLH(mFOV, mAspectRatio, mNearPlane, mFarPlane));
+	DirectX::XMFLOAT4X4 perspectiveMatrix;
+	DirectX::XMStoreFloat4x4(&perspectiveMatrix, DirectX::XMMatrixPerspectiveFovLH(mFOV, mAspectRatio, mNearPlane, mFarPlane));
+
+	SetPerspectiveMatrix(perspectiveMatrix);
+}
+
+// ------------------------------------------------------------ //
+
+void BaseCamera::SetViewMatrix(const DirectX::XMFLOAT4X4& viewMatrix)
+{
+	if (memcmp(&viewMatrix, &mViewMatrix, sizeof(DirectX::XMFLOAT4X4)) == 0)
+		return;
+
+	mViewMatrix = viewMatrix;
+
+	DirectX::XMMATRIX view = DirectX::XMLoadFloat4x4(&mViewMatrix);
+
+	DirectX::XMStoreFloat4x4(&mTransposedViewMatrix, DirectX::XMMatrixTranspose(view));
+	DirectX::XMStoreFloat4x4(&mInverseViewMatrix,    DirectX::XMMatrixInverse(nullptr, view));
+
+	mViewVersion++;
+
+	ReCalculateViewProjection();
+}
+
+// ------------------------------------------------------------ //
+
+void BaseCamera::SetPerspectiveMatrix(const DirectX::XMFLOAT4X4& perspectiveMatrix)
+{
+	if (memcmp(&perspectiveMatrix, &mPerspectiveMatrix, sizeof(DirectX::XMFLOAT4X4)) == 0)
+		return;
+
+	mPerspectiveMatrix = perspectiveMatrix;
+
+	DirectX::XMMATRIX perspective = DirectX::XMLoadFloat4x4(&mPerspectiveMatrix);
+
+	DirectX::XMStoreFloat4x4(&mTransposedPerspectiveMatrix, DirectX::XMMatrixTranspose(perspective));
+	DirectX::XMStoreFloat4x4(&mInversePerspectiveMatrix,    DirectX::XMMatrixInverse(nullptr, perspective));
+
+	mPerspectiveVersion++;
+
+	ReCalculateViewProjection();
+}
+
+// ------------------------------------------------------------ //
+
+void BaseCamera::ReCalculateViewProjection()
+{
+	DirectX::XMMATRIX viewProjection = DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&mViewMatrix), DirectX::XMLoadFloat4x4(&mPerspectiveMatrix));
+
+	DirectX::XMStoreFloat4x4(&mTransposedViewProjectionMatrix, DirectX::XMMatrixTranspose(viewProjection));
+	DirectX::XMStoreFloat4x4(&mInverseViewProjectionMatrix,    DirectX::XMMatrixInverse(nullptr, viewProjection));
+
+	// The frustum planes are extracted in world space, so they need both the view and the projection
+	DirectX::XMFLOAT4X4 viewProjectionMatrix;
+	DirectX::XMStoreFloat4x4(&viewProjectionMatrix, viewProjection);
+
+	mFrustum.ExtractFromViewProjection(viewProjectionMatrix);
 }
 
 // ------------------------------------------------------------ //
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _BASE_CAMERA_H_
 
 #include "../Maths/CommonMaths.h"
+#include "Frustum.h"
 
 #include "../Input/InputHandler.h"
 
@@ -24,15 +25,40 @@ public:
 	virtual void Update(const float deltaTime);
 
 
-	DirectX::XMFLOAT4X4 GetViewMatrix()        { return mViewMatrix; };
-	DirectX::XMFLOAT4X4 GetPerspectiveMatrix() { return mPerspectiveMatrix; };
+	const DirectX::XMFLOAT4X4& GetViewMatrix()        const { return mViewMatrix; };
+	const DirectX::XMFLOAT4X4& GetPerspectiveMatrix() const { return mPerspectiveMatrix; };
+
+	// Transposed copies, ready to be copied straight into a constant buffer
+	const DirectX::XMFLOAT4X4& GetTransposedViewMatrix()           const { return mTransposedViewMatrix; }
+	const DirectX::XMFLOAT4X4& GetTransposedPerspectiveMatrix()    const { return mTransposedPerspectiveMatrix; }
+	const DirectX::XMFLOAT4X4& GetTransposedViewProjectionMatrix() const { return mTransposedViewProjectionMatrix; }
+
+	// Inverses are kept in the same (un-transposed) layout as GetViewMatrix(), for use on the CPU
+	const DirectX::XMFLOAT4X4& GetInverseViewMatrix()              const { return mInverseViewMatrix; }
+	const DirectX::XMFLOAT4X4& GetInversePerspectiveMatrix()       const { return mInversePerspectiveMatrix; }
+	const DirectX::XMFLOAT4X4& GetInverseViewProjectionMatrix()    const { return mInverseViewProjectionMatrix; }
+
+	// Bumped only when the matrix actually changes, so a consumer holding onto the last version it saw knows whether it needs to re-upload.
+	// Both counters only ever increase, so their sum changes whenever either of them does.
+	unsigned int GetViewVersion()           const { return mViewVersion; }
+	unsigned int GetPerspectiveVersion()    const { return mPerspectiveVersion; }
+	unsigned int GetViewProjectionVersion() const { return mViewVersion + mPerspectiveVersion; }
 
 	Vector3D GetPosition() { return mPosition; }
 
+	const Frustum& GetFrustum() const { return mFrustum; }
+
+	// Pixels covered by one unit at a distance of one unit, for Model::SelectLod() - the projection's y scale is 1 / tan(fov / 2)
+	float GetLodProjectionScale(float screenHeight) const { return mPerspectiveMatrix._22 * screenHeight * 0.5f; }
+
 protected:
 	virtual void ReCalculateViewMatrix();
 	        void ReCalculatePerspectiveMatrix();
 
+	// Store a newly built matrix and update everything derived from it - does nothing if it matches the current one
+	        void SetViewMatrix(const DirectX::XMFLOAT4X4& viewMatrix);
+	        void SetPerspectiveMatrix(const DirectX::XMFLOAT4X4& perspectiveMatrix);
+
 	InputHandler* mInputHandler;
 
 	DirectX::XMFLOAT4X4 mViewMatrix;
@@ -51,6 +77,22 @@ protected:
 	float    mMovementSpeed;
 
 	float    mRotationSpeed;
+
+private:
+	void ReCalculateViewProjection();
+
+	DirectX::XMFLOAT4X4 mTransposedViewMatrix;
+	DirectX::XMFLOAT4X4 mTransposedPerspectiveMatrix;
+	DirectX::XMFLOAT4X4 mTransposedViewProjectionMatrix;
+
+	DirectX::XMFLOAT4X4 mInverseViewMatrix;
+	DirectX::XMFLOAT4X4 mInversePerspectiveMatrix;
+	DirectX::XMFLOAT4X4 mInverseViewProjectionMatrix;
+
+	unsigned int        mViewVersion;
+	unsigned int        mPerspectiveVersion;
+
+	Frustum             mFrustum;
 };
 
 #endif
\ No newline at end of file
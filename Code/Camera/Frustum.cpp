@@ -0,0 +1,231 @@
+#include "Frustum.h"
+
+#include <math.h>
+
+#include "../Maths/SIMDLanes.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	unsigned int CountSetBits(unsigned int value)
+	{
+		value = value - ((value >> 1) & 0x55555555u);
+		value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+
+		return (((value + (value >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+Frustum::Frustum()
+	: mPlanes()
+{
+	// Default to planes that everything is inside of
+	for (unsigned int i = 0; i < (unsigned int)FrustumPlane::MAX; i++)
+	{
+		mPlanes[i] = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+Frustum::~Frustum()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+void Frustum::ExtractFromViewProjection(const DirectX::XMFLOAT4X4& m)
+{
+	// Clip space is (point * matrix), so each plane is a combination of the matrix's columns
+	// DirectX clip space runs 0 <= z <= w, so the near plane is just the third column
+	mPlanes[(unsigned int)FrustumPlane::LEFT]       = DirectX::XMFLOAT4(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41);
+	mPlanes[(unsigned int)FrustumPlane::RIGHT]      = DirectX::XMFLOAT4(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41);
+	mPlanes[(unsigned int)FrustumPlane::BOTTOM]     = DirectX::XMFLOAT4(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42);
+	mPlanes[(unsigned int)FrustumPlane::TOP]        = DirectX::XMFLOAT4(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42);
+	mPlanes[(unsigned int)FrustumPlane::NEAR_PLANE] = DirectX::XMFLOAT4(m._13,         m._23,         m._33,         m._43);
+	mPlanes[(unsigned int)FrustumPlane::FAR_PLANE]  = DirectX::XMFLOAT4(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43);
+
+	// Normalise so that the plane distances are in world units, which the sphere test needs
+	for (unsigned int i = 0; i < (unsigned int)FrustumPlane::MAX; i++)
+	{
+		DirectX::XMFLOAT4& plane = mPlanes[i];
+
+		float lengthSquared = (plane.x * plane.x) + (plane.y * plane.y) + (plane.z * plane.z);
+
+		// A degenerate matrix (e.g. a camera that has not built its view yet) - leave the plane accepting everything
+		if (lengthSquared <= 0.0f)
+		{
+			plane = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+			continue;
+		}
+
+		float inverseLength = 1.0f / sqrtf(lengthSquared);
+
+		plane.x *= inverseLength;
+		plane.y *= inverseLength;
+		plane.z *= inverseLength;
+		plane.w *= inverseLength;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool Frustum::IsSphereVisible(const Vector3D& centre, float radius) const
+{
+	for (unsigned int i = 0; i < (unsigned int)FrustumPlane::MAX; i++)
+	{
+		const DirectX::XMFLOAT4& plane = mPlanes[i];
+
+		if ((plane.x * centre.x) + (plane.y * centre.y) + (plane.z * centre.z) + plane.w < -radius)
+			return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool Frustum::IsBoxVisible(const Vector3D& centre, const Vector3D& halfExtents) const
+{
+	for (unsigned int i = 0; i < (unsigned int)FrustumPlane::MAX; i++)
+	{
+		const DirectX::XMFLOAT4& plane = mPlanes[i];
+
+		// How far the box reaches towards the plane's normal
+		float reach = (fabsf(plane.x) * halfExtents.x) + (fabsf(plane.y) * halfExtents.y) + (fabsf(plane.z) * halfExtents.z);
+
+		if ((plane.x * centre.x) + (plane.y * centre.y) + (plane.z * centre.z) + plane.w < -reach)
+			return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int Frustum::CullSpheres(const Vector3Batch& centres, const float* radii, std::vector<unsigned int>& visibilityMask) const
+{
+	unsigned int count        = centres.Count();
+	unsigned int visibleCount = 0;
+
+	visibilityMask.assign((count + 31) / 32, 0u);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane planeX[(unsigned int)FrustumPlane::MAX], planeY[(unsigned int)FrustumPlane::MAX], planeZ[(unsigned int)FrustumPlane::MAX], planeW[(unsigned int)FrustumPlane::MAX];
+
+	for (unsigned int plane = 0; plane < (unsigned int)FrustumPlane::MAX; plane++)
+	{
+		planeX[plane] = LaneSet(mPlanes[plane].x);
+		planeY[plane] = LaneSet(mPlanes[plane].y);
+		planeZ[plane] = LaneSet(mPlanes[plane].z);
+		planeW[plane] = LaneSet(mPlanes[plane].w);
+	}
+
+	Lane         zero      = LaneSet(0.0f);
+	unsigned int laneMask  = (1u << kLaneWidth) - 1u;
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane centreX = LaneLoad(&centres.x[i]), centreY = LaneLoad(&centres.y[i]), centreZ = LaneLoad(&centres.z[i]);
+		Lane negativeRadius = LaneSub(zero, LaneLoad(&radii[i]));
+		Lane outside        = LaneSet(0.0f);
+
+		for (unsigned int plane = 0; plane < (unsigned int)FrustumPlane::MAX; plane++)
+		{
+			// Summed in the same order as the scalar tests, so the rounding and with it the result match theirs
+			Lane distance = LaneAdd(LaneAdd(LaneAdd(LaneMul(planeX[plane], centreX), LaneMul(planeY[plane], centreY)), LaneMul(planeZ[plane], centreZ)), planeW[plane]);
+
+			outside = LaneOr(outside, LaneLess(distance, negativeRadius));
+		}
+
+		// kLaneWidth always divides 32, so a group of lanes never straddles two mask entries
+		unsigned int visibleBits = ~LaneMoveMask(outside) & laneMask;
+
+		visibilityMask[i >> 5] |= visibleBits << (i & 31);
+		visibleCount           += CountSetBits(visibleBits);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		if (IsSphereVisible(centres.Get(i), radii[i]))
+		{
+			visibilityMask[i >> 5] |= 1u << (i & 31);
+			visibleCount++;
+		}
+	}
+
+	return visibleCount;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int Frustum::CullBoxes(const Vector3Batch& centres, const Vector3Batch& halfExtents, std::vector<unsigned int>& visibilityMask) const
+{
+	unsigned int count        = centres.Count();
+	unsigned int visibleCount = 0;
+
+	visibilityMask.assign((count + 31) / 32, 0u);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane planeX[(unsigned int)FrustumPlane::MAX], planeY[(unsigned int)FrustumPlane::MAX], planeZ[(unsigned int)FrustumPlane::MAX], planeW[(unsigned int)FrustumPlane::MAX];
+	Lane absX[(unsigned int)FrustumPlane::MAX],   absY[(unsigned int)FrustumPlane::MAX],   absZ[(unsigned int)FrustumPlane::MAX];
+
+	for (unsigned int plane = 0; plane < (unsigned int)FrustumPlane::MAX; plane++)
+	{
+		planeX[plane] = LaneSet(mPlanes[plane].x);
+		planeY[plane] = LaneSet(mPlanes[plane].y);
+		planeZ[plane] = LaneSet(mPlanes[plane].z);
+		planeW[plane] = LaneSet(mPlanes[plane].w);
+
+		absX[plane]   = LaneSet(fabsf(mPlanes[plane].x));
+		absY[plane]   = LaneSet(fabsf(mPlanes[plane].y));
+		absZ[plane]   = LaneSet(fabsf(mPlanes[plane].z));
+	}
+
+	Lane         zero     = LaneSet(0.0f);
+	unsigned int laneMask = (1u << kLaneWidth) - 1u;
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane centreX = LaneLoad(&centres.x[i]),     centreY = LaneLoad(&centres.y[i]),     centreZ = LaneLoad(&centres.z[i]);
+		Lane extentX = LaneLoad(&halfExtents.x[i]), extentY = LaneLoad(&halfExtents.y[i]), extentZ = LaneLoad(&halfExtents.z[i]);
+		Lane outside = LaneSet(0.0f);
+
+		for (unsigned int plane = 0; plane < (unsigned int)FrustumPlane::MAX; plane++)
+		{
+			// In the scalar tests' order, as in CullSpheres()
+			Lane distance = LaneAdd(LaneAdd(LaneAdd(LaneMul(planeX[plane], centreX), LaneMul(planeY[plane], centreY)), LaneMul(planeZ[plane], centreZ)), planeW[plane]);
+			Lane reach    = LaneAdd(LaneAdd(LaneMul(absX[plane], extentX),   LaneMul(absY[plane], extentY)),   LaneMul(absZ[plane], extentZ));
+
+			outside = LaneOr(outside, LaneLess(distance, LaneSub(zero, reach)));
+		}
+
+		unsigned int visibleBits = ~LaneMoveMask(outside) & laneMask;
+
+		visibilityMask[i >> 5] |= visibleBits << (i & 31);
+		visibleCount           += CountSetBits(visibleBits);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		if (IsBoxVisible(centres.Get(i), halfExtents.Get(i)))
+		{
+			visibilityMask[i >> 5] |= 1u << (i & 31);
+			visibleCount++;
+		}
+	}
+
+	return visibleCount;
+}
+
+// -------------------------------------------------------------------- //
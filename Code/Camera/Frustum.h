@@ -0,0 +1,52 @@
+#ifndef _FRUSTUM_H_
+#define _FRUSTUM_H_
+
+#include <vector>
+
+#include "../Maths/CommonMaths.h"
+#include "../Maths/VectorBatch.h"
+
+// -------------------------------------------------------------------- //
+
+enum class FrustumPlane : unsigned int
+{
+	LEFT = 0,
+	RIGHT,
+	BOTTOM,
+	TOP,
+	NEAR_PLANE,
+	FAR_PLANE,
+
+	MAX
+};
+
+// -------------------------------------------------------------------- //
+
+// The six planes of a view-projection, stored as (normal.x, normal.y, normal.z, distance) with the normals pointing inwards.
+// The batch culling functions write one bit per object into visibilityMask, 32 objects per entry, set when the object is visible.
+class Frustum final
+{
+public:
+	Frustum();
+	~Frustum();
+
+	// Expects the DirectX row-vector layout, so pass (view * projection) un-transposed
+	void ExtractFromViewProjection(const DirectX::XMFLOAT4X4& viewProjection);
+
+	bool IsSphereVisible(const Vector3D& centre, float radius) const;
+	bool IsBoxVisible(const Vector3D& centre, const Vector3D& halfExtents) const;
+
+	unsigned int CullSpheres(const Vector3Batch& centres, const float* radii,              std::vector<unsigned int>& visibilityMask) const;
+	unsigned int CullBoxes(  const Vector3Batch& centres, const Vector3Batch& halfExtents, std::vector<unsigned int>& visibilityMask) const;
+
+	static bool  GetIsVisible(const std::vector<unsigned int>& visibilityMask, unsigned int index) { return (visibilityMask[index >> 5] & (1u << (index & 31))) != 0; }
+
+	const DirectX::XMFLOAT4& GetPlane(FrustumPlane plane) const { return mPlanes[(unsigned int)plane]; }
+
+private:
+	DirectX::XMFLOAT4 mPlanes[(unsigned int)FrustumPlane::MAX];
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
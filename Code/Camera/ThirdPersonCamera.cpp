@@ -8,6 +8,9 @@ ThirdPersonCamera::ThirdPersonCamera()
 	: BaseCamera()
 	, mFocalPoint(0.0f, 0.0f, 0.0f)
 	, mDistanceFromFocalPoint(10.0f)
+	, mOrientation()
+	, mBaseRight(mRight)
+	, mBaseUp(mUp)
 	, mYRotationAngle(0.0f)
 	, mXRotationAngle(0.0f)
 {
@@ -33,6 +36,9 @@ ThirdPersonCamera::ThirdPersonCamera(InputHandler* inputHandler,
 	: BaseCamera(inputHandler, Vector3D::zero, right, up, FOV, nearPlane, farPlane, aspect, movementSpeed, rotationSpeed)
 	, mFocalPoint(focalPoint)
 	, mDistanceFromFocalPoint(distanceFromFocalPoint)
+	, mOrientation()
+	, mBaseRight(mRight)
+	, mBaseUp(mUp)
 	, mYRotationAngle(0.0f)
 	, mXRotationAngle(0.0f)
 {
@@ -81,9 +87,12 @@ void ThirdPersonCamera::Update(const float deltaTime)
 void ThirdPersonCamera::ReCalculateViewMatrix()
 {
 	// Calculate view matrix
-	DirectX::XMStoreFloat4x4(&mViewMatrix, DirectX::XMMatrixLookAtLH(DirectX::XMVectorSet(mPosition.x,   mPosition.y,   mPosition.z,   0.0f), 
-																	 DirectX::XMVectorSet(mFocalPoint.x, mFocalPoint.y, mFocalPoint.z, 0.0f),
-																	 DirectX::XMVectorSet(mUp.x,         mUp.y,         mUp.z,         0.0f)));
+	DirectX::XMFLOAT4X4 viewMatrix;
+	DirectX::XMStoreFloat4x4(&viewMatrix, DirectX::XMMatrixLookAtLH(DirectX::XMVectorSet(mPosition.x,   mPosition.y,   mPosition.z,   0.0f), 
+																	DirectX::XMVectorSet(mFocalPoint.x, mFocalPoint.y, mFocalPoint.z, 0.0f),
+																	DirectX::XMVectorSet(mUp.x,         mUp.y,         mUp.z,         0.0f)));
+
+	SetViewMatrix(viewMatrix);
 }
 
 // ------------------------------------------------------------ //
@@ -193,64 +202,45 @@ void ThirdPersonCamera::RotationalCheck(bool& changed, const float deltaTime)
 			// Set that the view matrix has changed
 			changed = true;
 
-			// Get the offset vector - from the focal point to the position
-			Vector3D offsetVector = mPosition - mFocalPoint;
-
 			Vector2D fractions = Vector2D(mouseDelta.x / GameScreenManager::ScreenWidth, mouseDelta.y / GameScreenManager::ScreenHeight);
 			fractions.x *= TWOPI;
 			fractions.y *= PI;
 
-			// Now calculate the rotation amount
-			float angle;
+			// Build up the whole rotation for this frame first, so each axis only costs one sin/cos pair
+			Quaternion rotation;
+			float      angle;
 
-			// Now rotate around the camera's right vector
-			if (mouseDelta.y > 0.0f)
+			// Rotate around the camera's right vector
+			if (mouseDelta.y != 0.0f)
 			{
 				angle = fractions.y * mRotationSpeed * deltaTime;
 
 				CapToYRotationBounds(angle);
 
-				offsetVector *= MatrixMaths::AxisRotationMatrix(mRight, angle);
-				mRight       *= MatrixMaths::AxisRotationMatrix(mRight, angle);
-				mUp          *= MatrixMaths::AxisRotationMatrix(mRight, angle);
+				// The matrices used to be applied as (vector * matrix), which rotates by the negative angle, so keep that direction
+				rotation = Quaternion::FromAxisAngle(mRight, -angle);
 			}
-			else if (mouseDelta.y < 0.0f)
-			{
-				angle = fractions.y * mRotationSpeed * deltaTime;
-
-				CapToYRotationBounds(angle);
 
-				offsetVector *= MatrixMaths::AxisRotationMatrix(mRight, angle);
-				mRight       *= MatrixMaths::AxisRotationMatrix(mRight, angle);
-				mUp          *= MatrixMaths::AxisRotationMatrix(mRight, angle);
-			}
-			
-			// Now rotate that offset around the world up if we need to
-			if (mouseDelta.x > 0.0f)
+			// Now rotate around the world up
+			if (mouseDelta.x != 0.0f)
 			{
 				angle = fractions.x * mRotationSpeed * deltaTime;
 
 				//CapToXRotationBounds(angle);
 
-				offsetVector *= MatrixMaths::GetYAxisRotationMatrix(angle);
-				mRight       *= MatrixMaths::GetYAxisRotationMatrix(angle);
-				mUp          *= MatrixMaths::GetYAxisRotationMatrix(angle);
+				rotation = Quaternion::FromAxisAngle(Vector3D::worldUp, -angle) * rotation;
 			}
-			else if (mouseDelta.x < 0.0f)
-			{
-				angle = fractions.x * mRotationSpeed * deltaTime;
 
-				//CapToXRotationBounds(angle);
+			mOrientation = rotation * mOrientation;
 
-				offsetVector *= MatrixMaths::GetYAxisRotationMatrix(angle);
-				mRight       *= MatrixMaths::GetYAxisRotationMatrix(angle);
-				mUp          *= MatrixMaths::GetYAxisRotationMatrix(angle);
-			}
+			// Products of unit quaternions drift very slowly, so only pull it back once it has moved noticeably
+			if (fabs(mOrientation.LengthSquared() - 1.0f) > kOrientationDriftTolerance)
+				mOrientation.Normalise();
 
-			mRight.Normalise();
-			mUp.Normalise();
+			mRight = mOrientation.RotateVector(mBaseRight);
+			mUp    = mOrientation.RotateVector(mBaseUp);
 
-			mPosition = mFocalPoint + offsetVector;
+			ReCalculatePosition();
 		}
 	}
 }
@@ -37,11 +37,17 @@ private:
 	void CapToXRotationBounds(float& angleToRotateBy);
 	void CapToYRotationBounds(float& angleToRotateBy);
 
-	const float kMaxDistance = 15.0f;
-	const float kMinDistance = 2.0f;
+	const float kMaxDistance               = 15.0f;
+	const float kMinDistance               = 2.0f;
+	const float kOrientationDriftTolerance = 0.0001f;
 
-	Vector3D mFocalPoint;
-	float    mDistanceFromFocalPoint;
+	Vector3D   mFocalPoint;
+	float      mDistanceFromFocalPoint;
+
+	// mRight and mUp are derived from these so that they never need re-normalising
+	Quaternion mOrientation;
+	Vector3D   mBaseRight;
+	Vector3D   mBaseUp;
 
 	float    mXRotationAngle;
 	float    mYRotationAngle;
@@ -0,0 +1,1571 @@
+#include "CollisionBVH.h"
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+
+#include "../Maths/CommonMaths.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const unsigned int kSAHBinCount      = 16;
+
+	// Cost of visiting a node relative to testing a triangle
+	const float        kTraversalCost    = 1.0f;
+
+	// Leaves are kept small even where the heuristic would rather not split, so that a query never tests a long run of triangles
+	const unsigned int kMaxLeafTriangles = 8;
+
+	// Past this depth nodes are split at the median instead, which halves them every level - together these keep the depth within
+	// kMaxDepth, the size of the query stacks
+	const unsigned int kMaxSAHDepth      = 32;
+	const unsigned int kMaxDepth         = 64;
+
+	// Direction components smaller than this are treated as this, so that the slab tests never multiply 0 by infinity
+	const float        kMinDirection     = 1e-30f;
+
+	// Triangle corners are stored as this many steps across the mesh's bounds
+	const float        kQuantisationSteps = 65535.0f;
+
+	// -------------------------------------------------------------------- //
+
+	inline Vector3D ToVector(const DirectX::XMFLOAT3& value)
+	{
+		return Vector3D(value.x, value.y, value.z);
+	}
+
+	inline float GetAxis(const Vector3D& value, unsigned int axis)
+	{
+		return axis == 0 ? value.x : (axis == 1 ? value.y : value.z);
+	}
+
+	// Turns a triangle's quantised corners back into positions. The hierarchy is built around the decoded triangles, so the node bounds
+	// hold exactly what the queries test.
+	struct TriangleDecoder final
+	{
+		Vector3D origin;
+		Vector3D scale;   // Never 0, even along an axis the mesh is flat in
+
+		// The corners as they are stored, for queries that have moved into quantised space
+		void GetQuantisedCorners(const CollisionTriangle& triangle, Vector3D (&cornersOut)[3]) const
+		{
+			for (unsigned int corner = 0; corner < 3; corner++)
+				cornersOut[corner] = Vector3D((float)triangle.positions[corner][0], (float)triangle.positions[corner][1], (float)triangle.positions[corner][2]);
+		}
+
+		void GetCorners(const CollisionTriangle& triangle, Vector3D (&cornersOut)[3]) const
+		{
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				const unsigned short* position = triangle.positions[corner];
+
+				cornersOut[corner] = Vector3D(origin.x + (float)position[0] * scale.x, origin.y + (float)position[1] * scale.y, origin.z + (float)position[2] * scale.z);
+			}
+		}
+	};
+
+	inline unsigned short Quantise(float value, float origin, float scale)
+	{
+		return (unsigned short)std::min(std::max((value - origin) / scale + 0.5f, 0.0f), kQuantisationSteps);
+	}
+
+	inline float GetStepSize(float boundsMin, float boundsMax)
+	{
+		return boundsMax > boundsMin ? (boundsMax - boundsMin) / kQuantisationSteps : 1.0f;
+	}
+
+	struct Bounds final
+	{
+		Vector3D boundsMin;
+		Vector3D boundsMax;
+
+		Bounds()
+			: boundsMin(FLT_MAX, FLT_MAX, FLT_MAX)
+			, boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+		{
+
+		}
+
+		void Grow(const Vector3D& point)
+		{
+			boundsMin = Vector3D(std::min(boundsMin.x, point.x), std::min(boundsMin.y, point.y), std::min(boundsMin.z, point.z));
+			boundsMax = Vector3D(std::max(boundsMax.x, point.x), std::max(boundsMax.y, point.y), std::max(boundsMax.z, point.z));
+		}
+
+		void Grow(const Bounds& other)
+		{
+			Grow(other.boundsMin);
+			Grow(other.boundsMax);
+		}
+
+		// Half the surface area - only ever compared, so the factor of two does not matter
+		float GetArea() const
+		{
+			Vector3D size = boundsMax - boundsMin;
+
+			return size.x < 0.0f ? 0.0f : size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+	};
+
+	// -------------------------------------------------------------------- //
+
+	struct BuildState final
+	{
+		std::vector<Bounds>           triangleBounds;
+		std::vector<Vector3D>         centroids;
+		std::vector<unsigned int>     order;
+
+		std::vector<CollisionBVHNode> nodes;
+		unsigned int                  depth;
+	};
+
+	void MakeNode(const Bounds& bounds, CollisionBVHNode& node)
+	{
+		node.boundsMin = bounds.boundsMin.ConvertToDirectXFloat3();
+		node.boundsMax = bounds.boundsMax.ConvertToDirectXFloat3();
+	}
+
+	// Builds the node for order[first, first + count) and everything below it, appending them depth first
+	void BuildNode(BuildState& state, unsigned int first, unsigned int count, unsigned int depth)
+	{
+		unsigned int nodeIndex = (unsigned int)state.nodes.size();
+		state.nodes.push_back(CollisionBVHNode());
+		state.depth = std::max(state.depth, depth + 1);
+
+		Bounds bounds;
+		Bounds centroidBounds;
+
+		for (unsigned int i = first; i < first + count; i++)
+		{
+			bounds.Grow(state.triangleBounds[state.order[i]]);
+			centroidBounds.Grow(state.centroids[state.order[i]]);
+		}
+
+		MakeNode(bounds, state.nodes[nodeIndex]);
+
+		// Find the cheapest split between bins of centroids along any axis
+		float        parentArea = bounds.GetArea();
+		float        bestCost   = FLT_MAX;
+		unsigned int bestAxis   = 0;
+		unsigned int bestSplit  = 0;
+
+		for (unsigned int axis = 0; axis < 3 && depth < kMaxSAHDepth && count > 2 && parentArea > 0.0f; axis++)
+		{
+			float axisMin = GetAxis(centroidBounds.boundsMin, axis);
+			float extent  = GetAxis(centroidBounds.boundsMax, axis) - axisMin;
+
+			if (!(extent > 0.0f))
+				continue;
+
+			Bounds       binBounds[kSAHBinCount];
+			unsigned int binCounts[kSAHBinCount] = {};
+			float        scale                   = kSAHBinCount / extent;
+
+			for (unsigned int i = first; i < first + count; i++)
+			{
+				unsigned int triangle = state.order[i];
+				unsigned int bin      = std::min((unsigned int)((GetAxis(state.centroids[triangle], axis) - axisMin) * scale), kSAHBinCount - 1);
+
+				binBounds[bin].Grow(state.triangleBounds[triangle]);
+				binCounts[bin]++;
+			}
+
+			// Sweep from the right first so that the left sweep can price each split as it goes
+			float        rightAreas[kSAHBinCount];
+			unsigned int rightCounts[kSAHBinCount];
+			Bounds       right;
+			unsigned int rightCount = 0;
+
+			for (unsigned int bin = kSAHBinCount - 1; bin > 0; bin--)
+			{
+				right.Grow(binBounds[bin]);
+				rightCount      += binCounts[bin];
+				rightAreas[bin]  = right.GetArea();
+				rightCounts[bin] = rightCount;
+			}
+
+			Bounds       left;
+			unsigned int leftCount = 0;
+
+			for (unsigned int split = 1; split < kSAHBinCount; split++)
+			{
+				left.Grow(binBounds[split - 1]);
+				leftCount += binCounts[split - 1];
+
+				if (leftCount == 0 || rightCounts[split] == 0)
+					continue;
+
+				float cost = kTraversalCost + (left.GetArea() * leftCount + rightAreas[split] * rightCounts[split]) / parentArea;
+
+				if (cost < bestCost)
+				{
+					bestCost  = cost;
+					bestAxis  = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		unsigned int* order     = state.order.data();
+		unsigned int  leftCount = 0;
+
+		if (bestCost < (float)count || (bestCost < FLT_MAX && count > kMaxLeafTriangles))
+		{
+			float axisMin = GetAxis(centroidBounds.boundsMin, bestAxis);
+			float scale   = kSAHBinCount / (GetAxis(centroidBounds.boundsMax, bestAxis) - axisMin);
+
+			// The same sum as the binning, so every triangle lands on the side its bin was counted on
+			leftCount = (unsigned int)(std::partition(order + first, order + first + count, [&](unsigned int triangle)
+			{
+				return std::min((unsigned int)((GetAxis(state.centroids[triangle], bestAxis) - axisMin) * scale), kSAHBinCount - 1) < bestSplit;
+			}) - (order + first));
+		}
+		else if (count > kMaxLeafTriangles)
+		{
+			// Too deep for the heuristic, or every centroid is in the same place - split down the middle of the widest axis
+			Vector3D extent = centroidBounds.boundsMax - centroidBounds.boundsMin;
+
+			bestAxis  = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+			leftCount = count / 2;
+
+			std::nth_element(order + first, order + first + leftCount, order + first + count, [&](unsigned int a, unsigned int b)
+			{
+				return GetAxis(state.centroids[a], bestAxis) < GetAxis(state.centroids[b], bestAxis);
+			});
+		}
+
+		if (leftCount == 0)
+		{
+			state.nodes[nodeIndex].offset        = first;
+			state.nodes[nodeIndex].triangleCount = (unsigned short)count;
+			state.nodes[nodeIndex].splitAxis     = 0;
+			return;
+		}
+
+		state.nodes[nodeIndex].triangleCount = 0;
+		state.nodes[nodeIndex].splitAxis     = (unsigned short)bestAxis;
+
+		BuildNode(state, first, leftCount, depth + 1);
+
+		state.nodes[nodeIndex].offset = (unsigned int)state.nodes.size();
+
+		BuildNode(state, first + leftCount, count - leftCount, depth + 1);
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// A ray set up for slab tests
+	struct PreparedRay final
+	{
+		Vector3D origin;
+		Vector3D direction; // Unit length
+		Vector3D inverse;   // 1 / direction, with the zeros nudged off zero
+	};
+
+	inline float NudgeOffZero(float value)
+	{
+		return fabsf(value) >= kMinDirection ? value : (value < 0.0f ? -kMinDirection : kMinDirection);
+	}
+
+	bool PrepareRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, PreparedRay& rayOut)
+	{
+		Vector3D vector = ToVector(direction);
+		float    length = vector.Length();
+
+		if (!(length > 0.0f))
+			return false;
+
+		rayOut.origin    = ToVector(origin);
+		rayOut.direction = vector / length;
+		rayOut.inverse   = Vector3D(1.0f / NudgeOffZero(rayOut.direction.x), 1.0f / NudgeOffZero(rayOut.direction.y), 1.0f / NudgeOffZero(rayOut.direction.z));
+
+		return true;
+	}
+
+	// The ray moved into the space the triangles are quantised in, where their corners need no decoding. It is stretched along with
+	// the triangles, so the distance at which it crosses one is the same. Only its origin and direction are moved.
+	inline PreparedRay ToQuantisedSpace(const PreparedRay& ray, const TriangleDecoder& decoder)
+	{
+		PreparedRay quantisedRay = ray;
+
+		quantisedRay.origin    = Vector3D((ray.origin.x - decoder.origin.x) / decoder.scale.x, (ray.origin.y - decoder.origin.y) / decoder.scale.y, (ray.origin.z - decoder.origin.z) / decoder.scale.z);
+		quantisedRay.direction = Vector3D(ray.direction.x / decoder.scale.x, ray.direction.y / decoder.scale.y, ray.direction.z / decoder.scale.z);
+
+		return quantisedRay;
+	}
+
+	// Where the ray enters the node's bounds grown by padding on each side, if it does so before maxDistance
+	inline bool RayHitsNode(const PreparedRay& ray, const CollisionBVHNode& node, const Vector3D& padding, float maxDistance, float& enterOut)
+	{
+		float x0 = (node.boundsMin.x - padding.x - ray.origin.x) * ray.inverse.x, x1 = (node.boundsMax.x + padding.x - ray.origin.x) * ray.inverse.x;
+		float y0 = (node.boundsMin.y - padding.y - ray.origin.y) * ray.inverse.y, y1 = (node.boundsMax.y + padding.y - ray.origin.y) * ray.inverse.y;
+		float z0 = (node.boundsMin.z - padding.z - ray.origin.z) * ray.inverse.z, z1 = (node.boundsMax.z + padding.z - ray.origin.z) * ray.inverse.z;
+
+		// std::min/max rather than fminf/fmaxf, whose NaN rules stop them compiling down to single instructions
+		float enter = std::max(std::max(std::min(x0, x1), std::min(y0, y1)), std::max(std::min(z0, z1), 0.0f));
+		float exit  = std::min(std::min(std::max(x0, x1), std::max(y0, y1)), std::min(std::max(z0, z1), maxDistance));
+
+		enterOut = enter;
+
+		return enter <= exit;
+	}
+
+	// Walks the nodes the ray passes through (the nearer child first) handing each leaf to testLeaf, which returns the new
+	// maxDistance so that nodes beyond the closest hit so far are skipped
+	template<typename LeafTest>
+	void TraverseRay(const CollisionBVHNode* nodes, const PreparedRay& ray, const Vector3D& padding, float maxDistance, LeafTest testLeaf)
+	{
+		float enter;
+
+		if (!RayHitsNode(ray, nodes[0], padding, maxDistance, enter))
+			return;
+
+		// Each far child is kept with where the ray enters it, so that it can be dropped if a hit turns up nearer than that
+		unsigned int stack[kMaxDepth];
+		float        stackEnter[kMaxDepth];
+		unsigned int stackSize = 0;
+		unsigned int nodeIndex = 0;
+
+		while (true)
+		{
+			const CollisionBVHNode& node = nodes[nodeIndex];
+
+			if (node.triangleCount > 0)
+			{
+				maxDistance = testLeaf(node);
+			}
+			else
+			{
+				unsigned int nearChild      = nodeIndex + 1;
+				unsigned int farChild       = node.offset;
+				float        nearChildEnter = 0.0f;
+				float        farChildEnter  = 0.0f;
+				bool         hitNearChild   = RayHitsNode(ray, nodes[nearChild], padding, maxDistance, nearChildEnter);
+				bool         hitFarChild    = RayHitsNode(ray, nodes[farChild],  padding, maxDistance, farChildEnter);
+
+				if (hitNearChild && hitFarChild)
+				{
+					if (farChildEnter < nearChildEnter)
+					{
+						std::swap(nearChild,      farChild);
+						std::swap(nearChildEnter, farChildEnter);
+					}
+
+					stack[stackSize]      = farChild;
+					stackEnter[stackSize] = farChildEnter;
+					stackSize++;
+
+					nodeIndex = nearChild;
+					continue;
+				}
+
+				if (hitNearChild || hitFarChild)
+				{
+					nodeIndex = hitNearChild ? nearChild : farChild;
+					continue;
+				}
+			}
+
+			while (stackSize > 0 && stackEnter[stackSize - 1] > maxDistance)
+				stackSize--;
+
+			if (stackSize == 0)
+				return;
+
+			nodeIndex = stack[--stackSize];
+		}
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Double sided Moller-Trumbore - the distance along the ray if it crosses the triangle within maxDistance. Every test is worked out
+	// before any is checked, as which triangles a ray hits is too random for early outs to predict well. A ray in the plane of the
+	// triangle divides by zero, and the infinities and NaNs that gives fail the checks.
+	inline bool RayHitsTriangle(const PreparedRay& ray, const Vector3D (&corners)[3], float maxDistance, float& distanceOut)
+	{
+		Vector3D a        = corners[0];
+		Vector3D edge1    = corners[1] - a;
+		Vector3D edge2    = corners[2] - a;
+
+		Vector3D p        = ray.direction.Cross(edge2);
+		float    inverse  = 1.0f / edge1.Dot(p);
+
+		Vector3D s        = ray.origin - a;
+		Vector3D q        = s.Cross(edge1);
+
+		float    u        = s.Dot(p)             * inverse;
+		float    v        = ray.direction.Dot(q) * inverse;
+		float    distance = edge2.Dot(q)         * inverse;
+
+		if (!((u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (distance >= 0.0f) & (distance < maxDistance)))
+			return false;
+
+		distanceOut = distance;
+		return true;
+	}
+
+	// The triangle's unit normal, facing against direction
+	Vector3D GetFacingNormal(const Vector3D (&corners)[3], const Vector3D& direction)
+	{
+		Vector3D normal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+		float    length = normal.Length();
+
+		normal = length > 0.0f ? normal / length : Vector3D(0.0f, 1.0f, 0.0f);
+
+		return normal.Dot(direction) > 0.0f ? -normal : normal;
+	}
+
+#if defined(SIMD_LANES_ENABLED)
+
+	// -------------------------------------------------------------------- //
+
+	// A RayPacket set up for slab tests, one ray per lane
+	struct PreparedPacket final
+	{
+		Lane originX,    originY,    originZ;
+		Lane directionX, directionY, directionZ; // Unit length
+		Lane inverseX,   inverseY,   inverseZ;   // As PreparedRay::inverse
+	};
+
+	inline Lane NudgeOffZero(Lane value)
+	{
+		Lane magnitude = LaneMax(LaneAbs(value), LaneSet(kMinDirection));
+
+		return LaneSelect(LaneLess(value, LaneSet(0.0f)), LaneSub(LaneSet(0.0f), magnitude), magnitude);
+	}
+
+	// PrepareRay() for every ray at once. Returns a bit per ray that can hit anything - those with a direction and a distance to go.
+	unsigned int PreparePacket(const RayPacket& rays, Lane distance, PreparedPacket& packetOut)
+	{
+		Lane x      = LaneLoad(rays.directionX);
+		Lane y      = LaneLoad(rays.directionY);
+		Lane z      = LaneLoad(rays.directionZ);
+		Lane length = LaneSqrt(LaneAdd(LaneAdd(LaneMul(x, x), LaneMul(y, y)), LaneMul(z, z)));
+		Lane zero   = LaneSet(0.0f);
+
+		// Zero length directions would divide by zero, so those rays are pointed anywhere and left out
+		Lane valid  = LaneLess(zero, length);
+		Lane scale  = LaneSelect(valid, LaneDiv(LaneSet(1.0f), length), zero);
+
+		packetOut.originX    = LaneLoad(rays.originX);
+		packetOut.originY    = LaneLoad(rays.originY);
+		packetOut.originZ    = LaneLoad(rays.originZ);
+		packetOut.directionX = LaneMul(x, scale);
+		packetOut.directionY = LaneMul(y, scale);
+		packetOut.directionZ = LaneSelect(valid, LaneMul(z, scale), LaneSet(1.0f));
+		packetOut.inverseX   = LaneDiv(LaneSet(1.0f), NudgeOffZero(packetOut.directionX));
+		packetOut.inverseY   = LaneDiv(LaneSet(1.0f), NudgeOffZero(packetOut.directionY));
+		packetOut.inverseZ   = LaneDiv(LaneSet(1.0f), NudgeOffZero(packetOut.directionZ));
+
+		return LaneMoveMask(LaneAnd(valid, LaneLess(zero, distance)));
+	}
+
+	// RayHitsNode() for every ray at once - a bit per ray in rays that enters the node before its distance
+	inline unsigned int PacketHitsNode(const PreparedPacket& packet, const CollisionBVHNode& node, Lane distance, unsigned int rays)
+	{
+		Lane x0 = LaneMul(LaneSub(LaneSet(node.boundsMin.x), packet.originX), packet.inverseX), x1 = LaneMul(LaneSub(LaneSet(node.boundsMax.x), packet.originX), packet.inverseX);
+		Lane y0 = LaneMul(LaneSub(LaneSet(node.boundsMin.y), packet.originY), packet.inverseY), y1 = LaneMul(LaneSub(LaneSet(node.boundsMax.y), packet.originY), packet.inverseY);
+		Lane z0 = LaneMul(LaneSub(LaneSet(node.boundsMin.z), packet.originZ), packet.inverseZ), z1 = LaneMul(LaneSub(LaneSet(node.boundsMax.z), packet.originZ), packet.inverseZ);
+
+		Lane enter = LaneMax(LaneMax(LaneMin(x0, x1), LaneMin(y0, y1)), LaneMax(LaneMin(z0, z1), LaneSet(0.0f)));
+		Lane exit  = LaneMin(LaneMin(LaneMax(x0, x1), LaneMax(y0, y1)), LaneMin(LaneMax(z0, z1), distance));
+
+		return ~LaneMoveMask(LaneLess(exit, enter)) & rays;
+	}
+
+	// RayHitsTriangle() for every ray at once, returning distance with the nearer hits swapped in. The min keeps its second argument
+	// when the first is NaN, so the NaNs a ray in the plane of the triangle gives leave the distance alone.
+	inline Lane PacketHitsTriangle(const PreparedPacket& packet, const Vector3D (&corners)[3], Lane distance)
+	{
+		const Vector3D& a = corners[0];
+		const Vector3D& b = corners[1];
+		const Vector3D& c = corners[2];
+
+		Lane edge1X   = LaneSet(b.x - a.x), edge1Y = LaneSet(b.y - a.y), edge1Z = LaneSet(b.z - a.z);
+		Lane edge2X   = LaneSet(c.x - a.x), edge2Y = LaneSet(c.y - a.y), edge2Z = LaneSet(c.z - a.z);
+
+		Lane pX       = LaneSub(LaneMul(packet.directionY, edge2Z), LaneMul(packet.directionZ, edge2Y));
+		Lane pY       = LaneSub(LaneMul(packet.directionZ, edge2X), LaneMul(packet.directionX, edge2Z));
+		Lane pZ       = LaneSub(LaneMul(packet.directionX, edge2Y), LaneMul(packet.directionY, edge2X));
+		Lane inverse  = LaneDiv(LaneSet(1.0f), LaneAdd(LaneAdd(LaneMul(edge1X, pX), LaneMul(edge1Y, pY)), LaneMul(edge1Z, pZ)));
+
+		Lane sX       = LaneSub(packet.originX, LaneSet(a.x));
+		Lane sY       = LaneSub(packet.originY, LaneSet(a.y));
+		Lane sZ       = LaneSub(packet.originZ, LaneSet(a.z));
+
+		Lane qX       = LaneSub(LaneMul(sY, edge1Z), LaneMul(sZ, edge1Y));
+		Lane qY       = LaneSub(LaneMul(sZ, edge1X), LaneMul(sX, edge1Z));
+		Lane qZ       = LaneSub(LaneMul(sX, edge1Y), LaneMul(sY, edge1X));
+
+		Lane u        = LaneMul(LaneAdd(LaneAdd(LaneMul(sX, pX), LaneMul(sY, pY)), LaneMul(sZ, pZ)), inverse);
+		Lane v        = LaneMul(LaneAdd(LaneAdd(LaneMul(packet.directionX, qX), LaneMul(packet.directionY, qY)), LaneMul(packet.directionZ, qZ)), inverse);
+		Lane hit      = LaneMul(LaneAdd(LaneAdd(LaneMul(edge2X, qX), LaneMul(edge2Y, qY)), LaneMul(edge2Z, qZ)), inverse);
+
+		Lane zero     = LaneSet(0.0f);
+		Lane miss     = LaneOr(LaneOr(LaneLess(u, zero), LaneLess(v, zero)), LaneOr(LaneLess(LaneSet(1.0f), LaneAdd(u, v)), LaneLess(hit, zero)));
+
+		return LaneSelect(miss, distance, LaneMin(hit, distance));
+	}
+
+#endif
+
+	// -------------------------------------------------------------------- //
+
+	// Ericson, Real-Time Collision Detection 5.1.5 - works out which feature of the triangle is nearest from the barycentric regions
+	Vector3D GetClosestPointOnTriangle(const Vector3D& point, const Vector3D& a, const Vector3D& b, const Vector3D& c)
+	{
+		Vector3D ab = b - a;
+		Vector3D ac = c - a;
+		Vector3D ap = point - a;
+
+		float d1 = ab.Dot(ap);
+		float d2 = ac.Dot(ap);
+
+		if (d1 <= 0.0f && d2 <= 0.0f)
+			return a;
+
+		Vector3D bp = point - b;
+		float    d3 = ab.Dot(bp);
+		float    d4 = ac.Dot(bp);
+
+		if (d3 >= 0.0f && d4 <= d3)
+			return b;
+
+		float vc = d1 * d4 - d3 * d2;
+
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+			return a + ab * (d1 / (d1 - d3));
+
+		Vector3D cp = point - c;
+		float    d5 = ab.Dot(cp);
+		float    d6 = ac.Dot(cp);
+
+		if (d6 >= 0.0f && d5 <= d6)
+			return c;
+
+		float vb = d5 * d2 - d1 * d6;
+
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+			return a + ac * (d2 / (d2 - d6));
+
+		float va = d3 * d6 - d5 * d4;
+
+		if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+		float denominator = 1.0f / (va + vb + vc);
+
+		return a + ab * (vb * denominator) + ac * (vc * denominator);
+	}
+
+	// Where a ray (with a unit direction) first comes within radius of the segment from start to start + along, and the fraction of the
+	// way along the segment that is. Rays that start within radius, or run parallel to the segment, never do - its ends are for the
+	// caller to deal with.
+	bool RayHitsCylinder(const Vector3D& origin, const Vector3D& direction, const Vector3D& start, const Vector3D& along, float radius, float maxDistance, float& distanceOut, float& fractionOut)
+	{
+		Vector3D offset         = origin - start;
+
+		float    alongSquared   = along.Dot(along);
+		float    directionAlong = direction.Dot(along);
+		float    offsetAlong    = offset.Dot(along);
+
+		float    a              = alongSquared - directionAlong * directionAlong;
+		float    b              = alongSquared * offset.Dot(direction) - offsetAlong * directionAlong;
+		float    c              = alongSquared * (offset.Dot(offset) - radius * radius) - offsetAlong * offsetAlong;
+
+		// Moving along the segment - one of its ends will be touched first
+		if (!(a > 0.0f))
+			return false;
+
+		float discriminant = b * b - a * c;
+
+		if (discriminant < 0.0f)
+			return false;
+
+		float distance = (-b - sqrtf(discriminant)) / a;
+
+		if (distance < 0.0f || distance >= maxDistance)
+			return false;
+
+		float fraction = (offsetAlong + distance * directionAlong) / alongSquared;
+
+		if (fraction < 0.0f || fraction > 1.0f)
+			return false;
+
+		distanceOut = distance;
+		fractionOut = fraction;
+		return true;
+	}
+
+	// Where a sphere moving along the ray first touches the triangle, checking the face, then the edges, then the corners.
+	// The face is always touched first if it is touched at all, as the rest of the triangle lies in its plane.
+	bool SphereHitsTriangle(const PreparedRay& ray, float radius, const Vector3D (&corners)[3], float maxDistance, float& distanceOut, Vector3D& contactOut)
+	{
+		// A leaf's box is loose around any one triangle, so cull against the triangle's own box before the exact tests
+		CollisionBVHNode box;
+		box.boundsMin = DirectX::XMFLOAT3(std::min(std::min(corners[0].x, corners[1].x), corners[2].x), std::min(std::min(corners[0].y, corners[1].y), corners[2].y), std::min(std::min(corners[0].z, corners[1].z), corners[2].z));
+		box.boundsMax = DirectX::XMFLOAT3(std::max(std::max(corners[0].x, corners[1].x), corners[2].x), std::max(std::max(corners[0].y, corners[1].y), corners[2].y), std::max(std::max(corners[0].z, corners[1].z), corners[2].z));
+
+		float enter;
+
+		if (!RayHitsNode(ray, box, Vector3D(radius, radius, radius), maxDistance, enter))
+			return false;
+
+		Vector3D faceNormal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+		float    faceLength = faceNormal.Length();
+
+		if (!(faceLength > 0.0f))
+			return false;
+
+		Vector3D normal   = faceNormal / faceLength;
+		float    height   = (ray.origin - corners[0]).Dot(normal);
+
+		// Work from whichever side the sphere starts on
+		if (height < 0.0f)
+		{
+			normal = -normal;
+			height = -height;
+		}
+
+		float approach = -ray.direction.Dot(normal);
+
+		if (height > radius)
+		{
+			// Most triangles in a leaf are never reached by the plane test alone
+			if (!(approach > 0.0f) || height - radius >= approach * maxDistance)
+				return false;
+
+			float    distance = (height - radius) / approach;
+			Vector3D contact  = ray.origin + ray.direction * distance - normal * radius;
+
+			// Inside if the contact is on the inner side of all three edges
+			bool inside = true;
+
+			for (unsigned int edge = 0; edge < 3 && inside; edge++)
+			{
+				const Vector3D& start = corners[edge];
+				const Vector3D& end   = corners[edge == 2 ? 0 : edge + 1];
+
+				inside = (end - start).Cross(contact - start).Dot(faceNormal) >= 0.0f;
+			}
+
+			if (inside)
+			{
+				distanceOut = distance;
+				contactOut  = contact;
+				return true;
+			}
+		}
+		else
+		{
+			// Close enough to the plane that it may be touching already
+			Vector3D closest = GetClosestPointOnTriangle(ray.origin, corners[0], corners[1], corners[2]);
+
+			if ((closest - ray.origin).LengthSquared() <= radius * radius)
+			{
+				distanceOut = 0.0f;
+				contactOut  = closest;
+				return true;
+			}
+		}
+
+		bool found = false;
+
+		// The edges, as cylinders of the sphere's radius
+		for (unsigned int edge = 0; edge < 3; edge++)
+		{
+			const Vector3D& start = corners[edge];
+			Vector3D        along = corners[edge == 2 ? 0 : edge + 1] - start;
+			float           distance;
+			float           fraction;
+
+			if (!RayHitsCylinder(ray.origin, ray.direction, start, along, radius, maxDistance, distance, fraction))
+				continue;
+
+			maxDistance = distance;
+			contactOut  = start + along * fraction;
+			found       = true;
+		}
+
+		// The corners, as spheres of the sphere's radius
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			Vector3D offset       = ray.origin - corners[corner];
+			float    b            = offset.Dot(ray.direction);
+			float    discriminant = b * b - (offset.Dot(offset) - radius * radius);
+
+			if (discriminant < 0.0f)
+				continue;
+
+			float distance = -b - sqrtf(discriminant);
+
+			if (distance < 0.0f || distance >= maxDistance)
+				continue;
+
+			maxDistance = distance;
+			contactOut  = corners[corner];
+			found       = true;
+		}
+
+		distanceOut = maxDistance;
+		return found;
+	}
+
+	// Ericson, Real-Time Collision Detection 5.1.9 - the closest points between the segments from start1 to start1 + along1 and from
+	// start2 to start2 + along2, as fractions of the way along each
+	void GetClosestFractionsOnSegments(const Vector3D& start1, const Vector3D& along1, const Vector3D& start2, const Vector3D& along2, float& fraction1Out, float& fraction2Out)
+	{
+		Vector3D offset        = start1 - start2;
+		float    length1       = along1.Dot(along1);
+		float    length2       = along2.Dot(along2);
+		float    offsetAlong2  = along2.Dot(offset);
+
+		fraction1Out = 0.0f;
+		fraction2Out = 0.0f;
+
+		if (!(length1 > 0.0f))
+		{
+			if (length2 > 0.0f)
+				fraction2Out = std::min(std::max(offsetAlong2 / length2, 0.0f), 1.0f);
+
+			return;
+		}
+
+		float offsetAlong1 = along1.Dot(offset);
+
+		if (!(length2 > 0.0f))
+		{
+			fraction1Out = std::min(std::max(-offsetAlong1 / length1, 0.0f), 1.0f);
+			return;
+		}
+
+		float alongDot    = along1.Dot(along2);
+		float denominator = length1 * length2 - alongDot * alongDot;
+
+		// Parallel segments have no single closest pair, so any fraction does for the first
+		if (denominator > 0.0f)
+			fraction1Out = std::min(std::max((alongDot * offsetAlong2 - offsetAlong1 * length2) / denominator, 0.0f), 1.0f);
+
+		fraction2Out = (alongDot * fraction1Out + offsetAlong2) / length2;
+
+		if (fraction2Out < 0.0f)
+		{
+			fraction2Out = 0.0f;
+			fraction1Out = std::min(std::max(-offsetAlong1 / length1, 0.0f), 1.0f);
+		}
+		else if (fraction2Out > 1.0f)
+		{
+			fraction2Out = 1.0f;
+			fraction1Out = std::min(std::max((alongDot - offsetAlong1) / length1, 0.0f), 1.0f);
+		}
+	}
+
+	// The squared distance between the segment from start to start + along and the triangle, and the point on the triangle nearest it
+	float GetSegmentToTriangleDistanceSquared(const Vector3D& start, const Vector3D& along, const Vector3D (&corners)[3], Vector3D& closestOut)
+	{
+		Vector3D faceNormal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+		float    height0    = (start - corners[0]).Dot(faceNormal);
+		float    height1    = (start + along - corners[0]).Dot(faceNormal);
+
+		// A segment through the face touches it where it crosses the plane
+		if ((height0 <= 0.0f) != (height1 <= 0.0f))
+		{
+			Vector3D crossing = start + along * (height0 / (height0 - height1));
+			bool     inside   = true;
+
+			for (unsigned int edge = 0; edge < 3 && inside; edge++)
+			{
+				const Vector3D& edgeStart = corners[edge];
+				const Vector3D& edgeEnd   = corners[edge == 2 ? 0 : edge + 1];
+
+				inside = (edgeEnd - edgeStart).Cross(crossing - edgeStart).Dot(faceNormal) >= 0.0f;
+			}
+
+			if (inside)
+			{
+				closestOut = crossing;
+				return 0.0f;
+			}
+		}
+
+		// Otherwise the nearest points are between an end of the segment and the triangle, or the segment and an edge
+		closestOut = GetClosestPointOnTriangle(start, corners[0], corners[1], corners[2]);
+
+		float    distanceSquared = (closestOut - start).LengthSquared();
+		Vector3D candidate       = GetClosestPointOnTriangle(start + along, corners[0], corners[1], corners[2]);
+
+		if ((candidate - start - along).LengthSquared() < distanceSquared)
+		{
+			closestOut      = candidate;
+			distanceSquared = (candidate - start - along).LengthSquared();
+		}
+
+		for (unsigned int edge = 0; edge < 3; edge++)
+		{
+			Vector3D edgeAlong = corners[edge == 2 ? 0 : edge + 1] - corners[edge];
+			float    segmentFraction;
+			float    edgeFraction;
+
+			GetClosestFractionsOnSegments(start, along, corners[edge], edgeAlong, segmentFraction, edgeFraction);
+
+			candidate = corners[edge] + edgeAlong * edgeFraction;
+
+			float candidateSquared = (candidate - start - along * segmentFraction).LengthSquared();
+
+			if (candidateSquared < distanceSquared)
+			{
+				closestOut      = candidate;
+				distanceSquared = candidateSquared;
+			}
+		}
+
+		return distanceSquared;
+	}
+
+	// Where a capsule - the segment from ray.origin - halfAxis to ray.origin + halfAxis, grown by radius - moving along the ray first
+	// touches the triangle. The spheres at its ends are swept against the whole triangle and the cylinder between them against the
+	// triangle's edges and corners. The cylinder can only reach the face first where one of the ends reaches it too.
+	// padding is the capsule's half size along each axis.
+	bool CapsuleHitsTriangle(const PreparedRay& ray, const Vector3D& halfAxis, float radius, const Vector3D& padding, const Vector3D (&corners)[3], float maxDistance, float& distanceOut, Vector3D& contactOut)
+	{
+		CollisionBVHNode box;
+		box.boundsMin = DirectX::XMFLOAT3(std::min(std::min(corners[0].x, corners[1].x), corners[2].x), std::min(std::min(corners[0].y, corners[1].y), corners[2].y), std::min(std::min(corners[0].z, corners[1].z), corners[2].z));
+		box.boundsMax = DirectX::XMFLOAT3(std::max(std::max(corners[0].x, corners[1].x), corners[2].x), std::max(std::max(corners[0].y, corners[1].y), corners[2].y), std::max(std::max(corners[0].z, corners[1].z), corners[2].z));
+
+		float enter;
+
+		if (!RayHitsNode(ray, box, padding, maxDistance, enter))
+			return false;
+
+		Vector3D faceNormal = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+		float    faceLength = faceNormal.Length();
+
+		if (!(faceLength > 0.0f))
+			return false;
+
+		Vector3D start   = ray.origin - halfAxis;
+		Vector3D axis    = halfAxis * 2.0f;
+		Vector3D normal  = faceNormal / faceLength;
+		float    height0 = (start - corners[0]).Dot(normal);
+		float    height1 = (start + axis - corners[0]).Dot(normal);
+
+		// Whole capsule to one side of the plane - its nearest point to the plane is one of the ends, which has to reach it in time
+		if (height0 > radius && height1 > radius)
+		{
+			float approach = -ray.direction.Dot(normal);
+
+			if (!(approach > 0.0f) || std::min(height0, height1) - radius >= approach * maxDistance)
+				return false;
+		}
+		else if (height0 < -radius && height1 < -radius)
+		{
+			float approach = ray.direction.Dot(normal);
+
+			if (!(approach > 0.0f) || -std::max(height0, height1) - radius >= approach * maxDistance)
+				return false;
+		}
+		else if (fabsf(ray.origin.x - 0.5f * (box.boundsMin.x + box.boundsMax.x)) <= padding.x + 0.5f * (box.boundsMax.x - box.boundsMin.x) &&
+		         fabsf(ray.origin.y - 0.5f * (box.boundsMin.y + box.boundsMax.y)) <= padding.y + 0.5f * (box.boundsMax.y - box.boundsMin.y) &&
+		         fabsf(ray.origin.z - 0.5f * (box.boundsMin.z + box.boundsMax.z)) <= padding.z + 0.5f * (box.boundsMax.z - box.boundsMin.z))
+		{
+			// Otherwise it may be touching already, if its box overlaps the triangle's at the start
+			Vector3D closest;
+
+			if (GetSegmentToTriangleDistanceSquared(start, axis, corners, closest) <= radius * radius)
+			{
+				distanceOut = 0.0f;
+				contactOut  = closest;
+				return true;
+			}
+		}
+
+		bool     found = false;
+		float    distance;
+		Vector3D contact;
+
+		// The ends
+		PreparedRay endRay = ray;
+
+		for (unsigned int end = 0; end < 2; end++)
+		{
+			endRay.origin = end == 0 ? start : start + axis;
+
+			if (SphereHitsTriangle(endRay, radius, corners, maxDistance, distance, contact))
+			{
+				maxDistance = distance;
+				contactOut  = contact;
+				found       = true;
+			}
+		}
+
+		for (unsigned int edge = 0; edge < 3; edge++)
+		{
+			const Vector3D& edgeStart = corners[edge];
+			Vector3D        edgeAlong = corners[edge == 2 ? 0 : edge + 1] - edgeStart;
+
+			// The cylinder against the edge - they first touch when the lines through them are radius apart, which only changes at a
+			// steady rate along their common normal. Where that happens off the end of either, an end or a corner touches instead.
+			Vector3D        common    = axis.Cross(edgeAlong);
+			float           length    = common.Length();
+
+			if (length > 0.0f)
+			{
+				common = common / length;
+
+				float gap      = (edgeStart - start).Dot(common);
+				float approach = gap > 0.0f ? ray.direction.Dot(common) : -ray.direction.Dot(common);
+
+				if (fabsf(gap) > radius && approach > 0.0f)
+				{
+					distance = (fabsf(gap) - radius) / approach;
+
+					if (distance < maxDistance)
+					{
+						float axisFraction;
+						float edgeFraction;
+
+						GetClosestFractionsOnSegments(start + ray.direction * distance, axis, edgeStart, edgeAlong, axisFraction, edgeFraction);
+
+						if (axisFraction > 0.0f && axisFraction < 1.0f && edgeFraction > 0.0f && edgeFraction < 1.0f)
+						{
+							maxDistance = distance;
+							contactOut  = edgeStart + edgeAlong * edgeFraction;
+							found       = true;
+						}
+					}
+				}
+			}
+
+			// The cylinder against the corner, by moving the corner the other way
+			float fraction;
+
+			if (RayHitsCylinder(edgeStart, -ray.direction, start, axis, radius, maxDistance, distance, fraction))
+			{
+				maxDistance = distance;
+				contactOut  = edgeStart;
+				found       = true;
+			}
+		}
+
+		distanceOut = maxDistance;
+		return found;
+	}
+
+	// -------------------------------------------------------------------- //
+
+	inline float GetDistanceSquaredToNode(const Vector3D& point, const CollisionBVHNode& node)
+	{
+		float x = std::max(std::max(node.boundsMin.x - point.x, point.x - node.boundsMax.x), 0.0f);
+		float y = std::max(std::max(node.boundsMin.y - point.y, point.y - node.boundsMax.y), 0.0f);
+		float z = std::max(std::max(node.boundsMin.z - point.z, point.z - node.boundsMax.z), 0.0f);
+
+		return x * x + y * y + z * z;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+CollisionBVH::CollisionBVH()
+	: mNodes(nullptr)
+	, mTriangles(nullptr)
+	, mNodeCount(0)
+	, mTriangleCount(0)
+	, mDepth(0)
+	, mQuantisationOrigin(0.0f, 0.0f, 0.0f)
+	, mQuantisationScale(0.0f, 0.0f, 0.0f)
+	, mNodeStorage()
+	, mTriangleStorage()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+CollisionBVH::~CollisionBVH()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionBVH::Build(const std::vector<DirectX::XMFLOAT3>& positions, const std::vector<unsigned int>& indices)
+{
+	Clear();
+
+	if (indices.size() % 3 != 0)
+		return false;
+
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (indices[i] >= positions.size())
+			return false;
+	}
+
+	// Corners that are not finite can never be hit either. The rest are quantised across their bounds.
+	std::vector<size_t> kept;
+	Bounds              meshBounds;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		Vector3D corners[3] = { ToVector(positions[indices[i]]), ToVector(positions[indices[i + 1]]), ToVector(positions[indices[i + 2]]) };
+		bool     finite     = true;
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+			finite = finite && isfinite(corners[corner].x) && isfinite(corners[corner].y) && isfinite(corners[corner].z);
+
+		if (!finite || !((corners[1] - corners[0]).Cross(corners[2] - corners[0]).LengthSquared() > 0.0f))
+			continue;
+
+		kept.push_back(i);
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+			meshBounds.Grow(corners[corner]);
+	}
+
+	if (kept.empty())
+		return true;
+
+	Vector3D        stepSize(GetStepSize(meshBounds.boundsMin.x, meshBounds.boundsMax.x), GetStepSize(meshBounds.boundsMin.y, meshBounds.boundsMax.y), GetStepSize(meshBounds.boundsMin.z, meshBounds.boundsMax.z));
+	TriangleDecoder decoder = { meshBounds.boundsMin, stepSize };
+
+	// A position always quantises the same way, so corners shared between triangles stay shared and no cracks open up between them.
+	// Slivers can still collapse to nothing, and are left out after all.
+	std::vector<CollisionTriangle> triangles;
+	triangles.reserve(kept.size());
+
+	for (size_t i : kept)
+	{
+		CollisionTriangle triangle;
+		Vector3D          corners[3];
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			const DirectX::XMFLOAT3& position = positions[indices[i + corner]];
+
+			triangle.positions[corner][0] = Quantise(position.x, decoder.origin.x, decoder.scale.x);
+			triangle.positions[corner][1] = Quantise(position.y, decoder.origin.y, decoder.scale.y);
+			triangle.positions[corner][2] = Quantise(position.z, decoder.origin.z, decoder.scale.z);
+		}
+
+		triangle.padding     = 0;
+		triangle.sourceIndex = (unsigned int)(i / 3);
+
+		decoder.GetCorners(triangle, corners);
+
+		if ((corners[1] - corners[0]).Cross(corners[2] - corners[0]).LengthSquared() > 0.0f)
+			triangles.push_back(triangle);
+	}
+
+	if (triangles.empty())
+		return true;
+
+	BuildState state;
+	state.depth = 0;
+	state.triangleBounds.resize(triangles.size());
+	state.centroids.resize(triangles.size());
+	state.order.resize(triangles.size());
+
+	for (unsigned int i = 0; i < (unsigned int)triangles.size(); i++)
+	{
+		Vector3D corners[3];
+		decoder.GetCorners(triangles[i], corners);
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+			state.triangleBounds[i].Grow(corners[corner]);
+
+		state.centroids[i] = (state.triangleBounds[i].boundsMin + state.triangleBounds[i].boundsMax) * 0.5f;
+		state.order[i]     = i;
+	}
+
+	// Roughly two nodes per leaf, and a leaf per couple of triangles
+	state.nodes.reserve(triangles.size());
+
+	BuildNode(state, 0, (unsigned int)triangles.size(), 0);
+
+	mNodeStorage.swap(state.nodes);
+	mNodeStorage.shrink_to_fit();
+
+	mTriangleStorage.resize(triangles.size());
+
+	for (unsigned int i = 0; i < (unsigned int)triangles.size(); i++)
+		mTriangleStorage[i] = triangles[state.order[i]];
+
+	mNodes              = mNodeStorage.data();
+	mTriangles          = mTriangleStorage.data();
+	mNodeCount          = (unsigned int)mNodeStorage.size();
+	mTriangleCount      = (unsigned int)mTriangleStorage.size();
+	mDepth              = state.depth;
+	mQuantisationOrigin = decoder.origin.ConvertToDirectXFloat3();
+	mQuantisationScale  = decoder.scale.ConvertToDirectXFloat3();
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionBVH::Attach(const CollisionBVHNode*  nodes,
+                          unsigned int             nodeCount,
+                          const CollisionTriangle* triangles,
+                          unsigned int             triangleCount,
+                          const DirectX::XMFLOAT3& quantisationOrigin,
+                          const DirectX::XMFLOAT3& quantisationScale)
+{
+	Clear();
+
+	if (nodeCount == 0)
+		return triangleCount == 0;
+
+	if (!nodes || (!triangles && triangleCount > 0))
+		return false;
+
+	// Queries divide by the scale
+	if (!(quantisationScale.x > 0.0f) || !(quantisationScale.y > 0.0f) || !(quantisationScale.z > 0.0f))
+		return false;
+
+	// The queries trust every index they follow, so check them all. Children always come after their parent, which also means a
+	// node's depth is known by the time it is reached going forwards.
+	std::vector<unsigned int> depths(nodeCount, 0);
+	unsigned int              depth = 1;
+
+	depths[0] = 1;
+
+	for (unsigned int i = 0; i < nodeCount; i++)
+	{
+		const CollisionBVHNode& node = nodes[i];
+
+		if (depths[i] > kMaxDepth)
+			return false;
+
+		depth = std::max(depth, depths[i]);
+
+		if (node.triangleCount > 0)
+		{
+			if (node.offset > triangleCount || node.triangleCount > triangleCount - node.offset)
+				return false;
+
+			continue;
+		}
+
+		if (i + 1 >= nodeCount || node.offset <= i + 1 || node.offset >= nodeCount || node.splitAxis > 2)
+			return false;
+
+		depths[i + 1]       = std::max(depths[i + 1],       depths[i] + 1);
+		depths[node.offset] = std::max(depths[node.offset], depths[i] + 1);
+	}
+
+	mNodes              = nodes;
+	mTriangles          = triangles;
+	mNodeCount          = nodeCount;
+	mTriangleCount      = triangleCount;
+	mDepth              = depth;
+	mQuantisationOrigin = quantisationOrigin;
+	mQuantisationScale  = quantisationScale;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void CollisionBVH::Clear()
+{
+	mNodeStorage.clear();
+	mTriangleStorage.clear();
+
+	mNodes              = nullptr;
+	mTriangles          = nullptr;
+	mNodeCount          = 0;
+	mTriangleCount      = 0;
+	mDepth              = 0;
+	mQuantisationOrigin = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	mQuantisationScale  = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionBVH::RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, CollisionHit& hitOut) const
+{
+	PreparedRay ray;
+
+	if (mNodeCount == 0 || !PrepareRay(origin, direction, ray))
+		return false;
+
+	TriangleDecoder          decoder      = { ToVector(mQuantisationOrigin), ToVector(mQuantisationScale) };
+	PreparedRay              quantisedRay = ToQuantisedSpace(ray, decoder);
+	const CollisionTriangle* triangles    = mTriangles;
+	const CollisionTriangle* hit          = nullptr;
+	float                    distance     = maxDistance;
+	Vector3D                 corners[3];
+
+	TraverseRay(mNodes, ray, Vector3D(0.0f, 0.0f, 0.0f), maxDistance, [&](const CollisionBVHNode& leaf)
+	{
+		for (unsigned int i = leaf.offset; i < leaf.offset + leaf.triangleCount; i++)
+		{
+			decoder.GetQuantisedCorners(triangles[i], corners);
+
+			if (RayHitsTriangle(quantisedRay, corners, distance, distance))
+				hit = &triangles[i];
+		}
+
+		return distance;
+	});
+
+	if (!hit)
+		return false;
+
+	decoder.GetCorners(*hit, corners);
+
+	hitOut.distance      = distance;
+	hitOut.position      = (ray.origin + ray.direction * distance).ConvertToDirectXFloat3();
+	hitOut.normal        = GetFacingNormal(corners, ray.direction).ConvertToDirectXFloat3();
+	hitOut.triangleIndex = hit->sourceIndex;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int CollisionBVH::RayCastPacket(const RayPacket& rays, unsigned int pieceId, RayPacketHits& hitsOut) const
+{
+	if (mNodeCount == 0)
+		return 0;
+
+	unsigned int hitRays = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	PreparedPacket packet;
+	Lane           distance = LaneLoad(hitsOut.distance);
+	unsigned int   active   = PreparePacket(rays, distance, packet);
+
+	TriangleDecoder          decoder   = { ToVector(mQuantisationOrigin), ToVector(mQuantisationScale) };
+	const CollisionBVHNode*  nodes     = mNodes;
+	const CollisionTriangle* triangles = mTriangles;
+	Vector3D                 corners[3];
+
+	// As ToQuantisedSpace()
+	PreparedPacket quantisedPacket = packet;
+	quantisedPacket.originX    = LaneDiv(LaneSub(packet.originX, LaneSet(decoder.origin.x)), LaneSet(decoder.scale.x));
+	quantisedPacket.originY    = LaneDiv(LaneSub(packet.originY, LaneSet(decoder.origin.y)), LaneSet(decoder.scale.y));
+	quantisedPacket.originZ    = LaneDiv(LaneSub(packet.originZ, LaneSet(decoder.origin.z)), LaneSet(decoder.scale.z));
+	quantisedPacket.directionX = LaneDiv(packet.directionX, LaneSet(decoder.scale.x));
+	quantisedPacket.directionY = LaneDiv(packet.directionY, LaneSet(decoder.scale.y));
+	quantisedPacket.directionZ = LaneDiv(packet.directionZ, LaneSet(decoder.scale.z));
+
+	if (!PacketHitsNode(packet, nodes[0], distance, active))
+		return 0;
+
+	// The packet visits children in the order most of its rays would - second first along an axis they mostly travel down
+	bool negative[3] = { false, false, false };
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		const float* direction = axis == 0 ? rays.directionX : (axis == 1 ? rays.directionY : rays.directionZ);
+		float        sum       = 0.0f;
+
+		for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+			sum += (active & (1u << ray)) ? direction[ray] : 0.0f;
+
+		negative[axis] = sum < 0.0f;
+	}
+
+	unsigned int hitTriangles[kRayPacketSize];
+	unsigned int stack[kMaxDepth];
+	unsigned int stackSize = 0;
+	unsigned int nodeIndex = 0;
+
+	while (true)
+	{
+		const CollisionBVHNode& node = nodes[nodeIndex];
+
+		if (node.triangleCount > 0)
+		{
+			for (unsigned int i = node.offset; i < node.offset + node.triangleCount; i++)
+			{
+				decoder.GetQuantisedCorners(triangles[i], corners);
+
+				Lane         nearer = PacketHitsTriangle(quantisedPacket, corners, distance);
+				unsigned int closer = LaneMoveMask(LaneLess(nearer, distance)) & active;
+
+				if (closer == 0)
+					continue;
+
+				distance = nearer;
+				hitRays |= closer;
+
+				for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+				{
+					if (closer & (1u << ray))
+						hitTriangles[ray] = i;
+				}
+			}
+		}
+		else
+		{
+			unsigned int firstChild  = nodeIndex + 1;
+			unsigned int secondChild = node.offset;
+
+			if (negative[node.splitAxis])
+				std::swap(firstChild, secondChild);
+
+			bool hitFirstChild  = PacketHitsNode(packet, nodes[firstChild],  distance, active) != 0;
+			bool hitSecondChild = PacketHitsNode(packet, nodes[secondChild], distance, active) != 0;
+
+			if (hitFirstChild && hitSecondChild)
+				stack[stackSize++] = secondChild;
+
+			if (hitFirstChild || hitSecondChild)
+			{
+				nodeIndex = hitFirstChild ? firstChild : secondChild;
+				continue;
+			}
+		}
+
+		// Hits found since a node was pushed may have put it out of reach of every ray
+		while (stackSize > 0 && !PacketHitsNode(packet, nodes[stack[stackSize - 1]], distance, active))
+			stackSize--;
+
+		if (stackSize == 0)
+			break;
+
+		nodeIndex = stack[--stackSize];
+	}
+
+	float distances[kRayPacketSize];
+	LaneStore(distances, distance);
+
+	for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+	{
+		if ((hitRays & (1u << ray)) == 0)
+			continue;
+
+		const CollisionTriangle& triangle = triangles[hitTriangles[ray]];
+		decoder.GetCorners(triangle, corners);
+
+		Vector3D normal = GetFacingNormal(corners, Vector3D(rays.directionX[ray], rays.directionY[ray], rays.directionZ[ray]));
+
+		hitsOut.distance[ray]      = distances[ray];
+		hitsOut.normalX[ray]       = normal.x;
+		hitsOut.normalY[ray]       = normal.y;
+		hitsOut.normalZ[ray]       = normal.z;
+		hitsOut.triangleIndex[ray] = triangle.sourceIndex;
+		hitsOut.pieceId[ray]       = pieceId;
+	}
+#else
+	// No SIMD to trace the rays together with, so trace them one by one
+	for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+	{
+		CollisionHit hit;
+
+		if (!RayCast(DirectX::XMFLOAT3(rays.originX[ray], rays.originY[ray], rays.originZ[ray]), DirectX::XMFLOAT3(rays.directionX[ray], rays.directionY[ray], rays.directionZ[ray]), hitsOut.distance[ray], hit))
+			continue;
+
+		hitsOut.distance[ray]      = hit.distance;
+		hitsOut.normalX[ray]       = hit.normal.x;
+		hitsOut.normalY[ray]       = hit.normal.y;
+		hitsOut.normalZ[ray]       = hit.normal.z;
+		hitsOut.triangleIndex[ray] = hit.triangleIndex;
+		hitsOut.pieceId[ray]       = pieceId;
+
+		hitRays |= 1u << ray;
+	}
+#endif
+
+	return hitRays;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionBVH::SphereCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float radius, float maxDistance, CollisionHit& hitOut) const
+{
+	PreparedRay ray;
+
+	if (mNodeCount == 0 || !PrepareRay(origin, direction, ray))
+		return false;
+
+	TriangleDecoder          decoder   = { ToVector(mQuantisationOrigin), ToVector(mQuantisationScale) };
+	const CollisionTriangle* triangles = mTriangles;
+	const CollisionTriangle* hit       = nullptr;
+	float                    distance  = maxDistance;
+	Vector3D                 contact;
+	Vector3D                 corners[3];
+
+	// Every node is grown by the radius, so the sphere's centre can be traced through the tree as a ray
+	TraverseRay(mNodes, ray, Vector3D(radius, radius, radius), maxDistance, [&](const CollisionBVHNode& leaf)
+	{
+		for (unsigned int i = leaf.offset; i < leaf.offset + leaf.triangleCount; i++)
+		{
+			decoder.GetCorners(triangles[i], corners);
+
+			if (SphereHitsTriangle(ray, radius, corners, distance, distance, contact))
+				hit = &triangles[i];
+		}
+
+		return distance;
+	});
+
+	if (!hit)
+		return false;
+
+	Vector3D centre = ray.origin + ray.direction * distance;
+	Vector3D normal = centre - contact;
+	float    length = normal.Length();
+
+	decoder.GetCorners(*hit, corners);
+
+	hitOut.distance      = distance;
+	hitOut.position      = contact.ConvertToDirectXFloat3();
+	hitOut.normal        = (length > 0.0f ? normal / length : GetFacingNormal(corners, ray.direction)).ConvertToDirectXFloat3();
+	hitOut.triangleIndex = hit->sourceIndex;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionBVH::CapsuleCast(const DirectX::XMFLOAT3& segmentStart, const DirectX::XMFLOAT3& segmentEnd, const DirectX::XMFLOAT3& direction, float radius, float maxDistance, CollisionHit& hitOut) const
+{
+	Vector3D    start    = ToVector(segmentStart);
+	Vector3D    halfAxis = (ToVector(segmentEnd) - start) * 0.5f;
+	PreparedRay ray;
+
+	if (mNodeCount == 0 || !PrepareRay((start + halfAxis).ConvertToDirectXFloat3(), direction, ray))
+		return false;
+
+	TriangleDecoder          decoder   = { ToVector(mQuantisationOrigin), ToVector(mQuantisationScale) };
+	const CollisionTriangle* triangles = mTriangles;
+	const CollisionTriangle* hit       = nullptr;
+	float                    distance  = maxDistance;
+	Vector3D                 contact;
+	Vector3D                 corners[3];
+
+	// The centre of the capsule is traced through the tree, with every node grown by the capsule's size
+	Vector3D padding(fabsf(halfAxis.x) + radius, fabsf(halfAxis.y) + radius, fabsf(halfAxis.z) + radius);
+
+	TraverseRay(mNodes, ray, padding, maxDistance, [&](const CollisionBVHNode& leaf)
+	{
+		for (unsigned int i = leaf.offset; i < leaf.offset + leaf.triangleCount; i++)
+		{
+			decoder.GetCorners(triangles[i], corners);
+
+			if (CapsuleHitsTriangle(ray, halfAxis, radius, padding, corners, distance, distance, contact))
+				hit = &triangles[i];
+		}
+
+		return distance;
+	});
+
+	if (!hit)
+		return false;
+
+	// The normal points from the contact back to the nearest point on the capsule's segment
+	Vector3D movedStart   = start + ray.direction * distance;
+	Vector3D axis         = halfAxis * 2.0f;
+	float    axisSquared  = axis.LengthSquared();
+	float    fraction     = axisSquared > 0.0f ? std::min(std::max((contact - movedStart).Dot(axis) / axisSquared, 0.0f), 1.0f) : 0.0f;
+	Vector3D normal       = movedStart + axis * fraction - contact;
+	float    length       = normal.Length();
+
+	decoder.GetCorners(*hit, corners);
+
+	hitOut.distance      = distance;
+	hitOut.position      = contact.ConvertToDirectXFloat3();
+	hitOut.normal        = (length > 0.0f ? normal / length : GetFacingNormal(corners, ray.direction)).ConvertToDirectXFloat3();
+	hitOut.triangleIndex = hit->sourceIndex;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionBVH::ClosestPoint(const DirectX::XMFLOAT3& point, float maxDistance, CollisionHit& hitOut) const
+{
+	if (mNodeCount == 0 || !(maxDistance >= 0.0f))
+		return false;
+
+	TriangleDecoder          decoder        = { ToVector(mQuantisationOrigin), ToVector(mQuantisationScale) };
+	Vector3D                 query          = ToVector(point);
+	float                    closestSquared = maxDistance * maxDistance;
+	const CollisionTriangle* hit            = nullptr;
+	Vector3D                 closestPoint;
+	Vector3D                 corners[3];
+
+	if (GetDistanceSquaredToNode(query, mNodes[0]) > closestSquared)
+		return false;
+
+	unsigned int stack[kMaxDepth];
+	unsigned int stackSize = 0;
+	unsigned int nodeIndex = 0;
+
+	while (true)
+	{
+		const CollisionBVHNode& node = mNodes[nodeIndex];
+
+		if (node.triangleCount > 0)
+		{
+			for (unsigned int i = node.offset; i < node.offset + node.triangleCount; i++)
+			{
+				const CollisionTriangle& triangle = mTriangles[i];
+				decoder.GetCorners(triangle, corners);
+
+				Vector3D candidate = GetClosestPointOnTriangle(query, corners[0], corners[1], corners[2]);
+				float    squared   = (candidate - query).LengthSquared();
+
+				if (squared <= closestSquared)
+				{
+					closestSquared = squared;
+					closestPoint   = candidate;
+					hit            = &triangle;
+				}
+			}
+		}
+		else
+		{
+			unsigned int nearChild        = nodeIndex + 1;
+			unsigned int farChild         = node.offset;
+			float        nearChildSquared = GetDistanceSquaredToNode(query, mNodes[nearChild]);
+			float        farChildSquared  = GetDistanceSquaredToNode(query, mNodes[farChild]);
+
+			if (farChildSquared < nearChildSquared)
+			{
+				std::swap(nearChild,        farChild);
+				std::swap(nearChildSquared, farChildSquared);
+			}
+
+			if (nearChildSquared <= closestSquared)
+			{
+				if (farChildSquared <= closestSquared)
+					stack[stackSize++] = farChild;
+
+				nodeIndex = nearChild;
+				continue;
+			}
+		}
+
+		// Skip anything the closest point so far has already beaten
+		while (stackSize > 0 && GetDistanceSquaredToNode(query, mNodes[stack[stackSize - 1]]) > closestSquared)
+			stackSize--;
+
+		if (stackSize == 0)
+			break;
+
+		nodeIndex = stack[--stackSize];
+	}
+
+	if (!hit)
+		return false;
+
+	Vector3D offset   = query - closestPoint;
+	float    distance = sqrtf(closestSquared);
+
+	decoder.GetCorners(*hit, corners);
+
+	hitOut.distance      = distance;
+	hitOut.position      = closestPoint.ConvertToDirectXFloat3();
+	hitOut.normal        = GetFacingNormal(corners, -offset).ConvertToDirectXFloat3();
+	hitOut.triangleIndex = hit->sourceIndex;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
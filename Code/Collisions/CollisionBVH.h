@@ -0,0 +1,160 @@
+#ifndef _COLLISION_BVH_H_
+#define _COLLISION_BVH_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include <directxmath.h>
+
+#include "../Maths/SIMDLanes.h"
+
+// -------------------------------------------------------------------- //
+
+// A packet fills one SIMD register - 8 rays with AVX, 4 with SSE
+#if defined(SIMD_LANES_ENABLED)
+const unsigned int kRayPacketSize = kLaneWidth;
+#else
+const unsigned int kRayPacketSize = 4;
+#endif
+
+// -------------------------------------------------------------------- //
+
+// 32 bytes, so that two share a cache line. Nodes are stored depth first - an interior node's first child is the next node along.
+struct CollisionBVHNode final
+{
+	DirectX::XMFLOAT3 boundsMin;
+	unsigned int      offset;        // Leaf: first triangle. Interior: the second child.
+	DirectX::XMFLOAT3 boundsMax;
+	unsigned short    triangleCount; // 0 for an interior node
+	unsigned short    splitAxis;     // Interior: the axis the children were split along, so that the nearer one can be visited first
+};
+
+static_assert(sizeof(CollisionBVHNode) == 32, "CollisionBVHNode must stay 32 bytes");
+
+// Stored in the order the leaves reference them. The corners are quantised to 16 bits across the mesh's bounds - see
+// CollisionBVH::GetQuantisationScale() - which is within 1/131070 of the mesh's size along each axis, in a little over half the space.
+struct CollisionTriangle final
+{
+	unsigned short positions[3][3];
+	unsigned short padding;
+	unsigned int   sourceIndex;      // Which triangle of the source mesh this was
+};
+
+static_assert(sizeof(CollisionTriangle) == 24, "CollisionTriangle must stay 24 bytes");
+
+// What a query found. The normal is the triangle's, flipped to face back at the query, as track surfaces are hit from either side.
+struct CollisionHit final
+{
+	float             distance;      // Along the ray or sweep, or from the point for ClosestPoint()
+	DirectX::XMFLOAT3 position;      // The point touched on the surface
+	DirectX::XMFLOAT3 normal;
+	unsigned int      triangleIndex; // CollisionTriangle::sourceIndex
+};
+
+// Rays traced together by CollisionBVH::RayCastPacket(), stored a component at a time so that each loads straight into a register.
+// The directions do not need to be unit length.
+struct RayPacket final
+{
+	float originX[kRayPacketSize];
+	float originY[kRayPacketSize];
+	float originZ[kRayPacketSize];
+
+	float directionX[kRayPacketSize];
+	float directionY[kRayPacketSize];
+	float directionZ[kRayPacketSize];
+
+	void  SetRay(unsigned int ray, const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction)
+	{
+		originX[ray]    = origin.x;    originY[ray]    = origin.y;    originZ[ray]    = origin.z;
+		directionX[ray] = direction.x; directionY[ray] = direction.y; directionZ[ray] = direction.z;
+	}
+};
+
+// What RayCastPacket() found for each ray. Set each distance to how far its ray may go before the first query - 0 leaves the ray out.
+// A query only overwrites the rays it finds something nearer for, so the same hits can be carried through every piece near a vehicle
+// to end up with the nearest across all of them.
+struct RayPacketHits final
+{
+	float        distance[kRayPacketSize];
+	float        normalX[kRayPacketSize];      // Facing back at the ray
+	float        normalY[kRayPacketSize];
+	float        normalZ[kRayPacketSize];
+	unsigned int triangleIndex[kRayPacketSize];
+	unsigned int pieceId[kRayPacketSize];      // Whatever the query that hit was given
+};
+
+// -------------------------------------------------------------------- //
+
+// Bounding volume hierarchy over a triangle mesh, built with binned surface area heuristic splits.
+// Queries do not change it, so any number of threads can query one at once. The nodes and triangles are flat arrays that refer to each
+// other by index, so they can be queried straight out of a mapped file - see CollisionCache.
+class CollisionBVH final
+{
+public:
+	CollisionBVH();
+	~CollisionBVH();
+
+	CollisionBVH(const CollisionBVH&)            = delete;
+	CollisionBVH& operator=(const CollisionBVH&) = delete;
+
+	// Replaces whatever was built before. Zero area triangles can never be hit, so they are left out.
+	// Returns false, leaving the hierarchy empty, if the indices are not whole triangles or one is out of range.
+	bool         Build(const std::vector<DirectX::XMFLOAT3>& positions, const std::vector<unsigned int>& indices);
+
+	// Queries arrays from somewhere else, e.g. a mapped CollisionCache, instead of building them. They must outlive the hierarchy.
+	// Returns false, leaving the hierarchy empty, unless every node refers to ones in range and it is no deeper than the queries allow.
+	bool         Attach(const CollisionBVHNode*  nodes,
+	                    unsigned int             nodeCount,
+	                    const CollisionTriangle* triangles,
+	                    unsigned int             triangleCount,
+	                    const DirectX::XMFLOAT3& quantisationOrigin,
+	                    const DirectX::XMFLOAT3& quantisationScale);
+
+	void         Clear();
+
+	// The nearest hit along the ray within maxDistance. The direction does not need to be unit length - distances are in world units.
+	bool         RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, CollisionHit& hitOut) const;
+
+	// RayCast() for a whole packet, tracing every ray through each node together. Nearly parallel rays from nearly the same place, like
+	// a vehicle's wheel rays, mostly visit the same nodes, so this costs little more than one ray. Rays that hit something nearer than
+	// their current distance get it written to hitsOut, along with pieceId. Returns a bit per ray that was written.
+	unsigned int RayCastPacket(const RayPacket& rays, unsigned int pieceId, RayPacketHits& hitsOut) const;
+
+	// Sweeps a sphere from origin along direction and returns where it first touches. A sphere that starts out touching hits at 0.
+	bool         SphereCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float radius, float maxDistance, CollisionHit& hitOut) const;
+
+	// SphereCast() for a capsule - the points within radius of the segment from segmentStart to segmentEnd - which moves without turning
+	bool         CapsuleCast(const DirectX::XMFLOAT3& segmentStart, const DirectX::XMFLOAT3& segmentEnd, const DirectX::XMFLOAT3& direction, float radius, float maxDistance, CollisionHit& hitOut) const;
+
+	// The nearest point on the mesh within maxDistance of point
+	bool         ClosestPoint(const DirectX::XMFLOAT3& point, float maxDistance, CollisionHit& hitOut) const;
+
+	const CollisionBVHNode*  GetNodes()         const { return mNodes; }
+	const CollisionTriangle* GetTriangles()     const { return mTriangles; }
+	unsigned int             GetNodeCount()     const { return mNodeCount; }
+	unsigned int             GetTriangleCount() const { return mTriangleCount; }
+	unsigned int             GetDepth()         const { return mDepth; }
+
+	// A triangle's corner is origin + position * scale, per axis
+	const DirectX::XMFLOAT3& GetQuantisationOrigin() const { return mQuantisationOrigin; }
+	const DirectX::XMFLOAT3& GetQuantisationScale()  const { return mQuantisationScale; }
+
+	size_t                   GetMemoryUsage()   const { return (size_t)mNodeCount * sizeof(CollisionBVHNode) + (size_t)mTriangleCount * sizeof(CollisionTriangle); }
+
+private:
+	const CollisionBVHNode*        mNodes;           // mNodeStorage's, or attached
+	const CollisionTriangle*       mTriangles;
+	unsigned int                   mNodeCount;
+	unsigned int                   mTriangleCount;
+	unsigned int                   mDepth;
+
+	DirectX::XMFLOAT3              mQuantisationOrigin;
+	DirectX::XMFLOAT3              mQuantisationScale;
+
+	std::vector<CollisionBVHNode>  mNodeStorage;     // Only used when built here
+	std::vector<CollisionTriangle> mTriangleStorage;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
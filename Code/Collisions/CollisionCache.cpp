@@ -0,0 +1,181 @@
+#include "CollisionCache.h"
+
+#include <string.h>
+#include <vector>
+
+#include "../Memory/FileUtils.h"
+#include "../Models/MeshCache.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const char               kCollisionCacheMagic[4] = { 'T', 'C', 'O', 'L' };
+	const unsigned long long kArrayAlignment         = 16;
+}
+
+// -------------------------------------------------------------------- //
+
+CollisionCache::CollisionCache()
+	: mFile()
+	, mStorage()
+	, mHeader(nullptr)
+	, mNodes(nullptr)
+	, mTriangles(nullptr)
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+CollisionCache::~CollisionCache()
+{
+	Close();
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionCache::Open(const std::string& filePath)
+{
+	Close();
+
+	if (!mFile.Open(filePath) || !Validate(mFile.GetData(), mFile.GetSize()))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionCache::OpenFromArchive(const AssetArchive& archive, const AssetArchiveEntry& entry)
+{
+	Close();
+
+	const char* data;
+	size_t      size;
+
+	if (!archive.Read(entry, mStorage, data, size) || !Validate(data, size))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionCache::Validate(const char* data, size_t size)
+{
+	// The arrays are read in place, so the block itself has to be aligned for them
+	if (size < sizeof(CollisionCacheHeader) || ((size_t)data % kArrayAlignment) != 0)
+		return false;
+
+	const CollisionCacheHeader* header = (const CollisionCacheHeader*)data;
+
+	unsigned long long nodeBytes     = (unsigned long long)header->nodeCount     * sizeof(CollisionBVHNode);
+	unsigned long long triangleBytes = (unsigned long long)header->triangleCount * sizeof(CollisionTriangle);
+
+	// Check everything before trusting any of it - the arrays must be where they claim to be and fit within the block
+	if (memcmp(header->magic, kCollisionCacheMagic, sizeof(kCollisionCacheMagic)) != 0
+	 || header->version        != kCollisionCacheVersion
+	 || header->headerSize     != sizeof(CollisionCacheHeader)
+	 || header->nodeStride     != sizeof(CollisionBVHNode)
+	 || header->triangleStride != sizeof(CollisionTriangle)
+	 || !FileUtils::GetIsRangeInBlock(header->nodeOffset,     nodeBytes,     kArrayAlignment, sizeof(CollisionCacheHeader), size)
+	 || !FileUtils::GetIsRangeInBlock(header->triangleOffset, triangleBytes, kArrayAlignment, sizeof(CollisionCacheHeader), size)
+	 || header->triangleCount > header->sourceTriangleCount)
+	{
+		return false;
+	}
+
+	mHeader    = header;
+	mNodes     = (const CollisionBVHNode*) (data + header->nodeOffset);
+	mTriangles = (const CollisionTriangle*)(data + header->triangleOffset);
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void CollisionCache::Close()
+{
+	mFile.Close();
+	mStorage.clear();
+	mStorage.shrink_to_fit();
+
+	mHeader    = nullptr;
+	mNodes     = nullptr;
+	mTriangles = nullptr;
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionCache::GetIsUpToDate(const MappedFile& source) const
+{
+	if (!mHeader)
+		return false;
+
+	return (mHeader->sourceSize == source.GetSize() && mHeader->sourceModifiedTime == source.GetModifiedTime())
+	    || (mHeader->sourceSize == source.GetSize() && mHeader->sourceHash == MeshCache::HashBytes(source.GetData(), source.GetSize()));
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionCache::Attach(CollisionBVH& bvh) const
+{
+	if (!mHeader)
+		return false;
+
+	return bvh.Attach(mNodes, mHeader->nodeCount, mTriangles, mHeader->triangleCount, mHeader->quantisationOrigin, mHeader->quantisationScale);
+}
+
+// -------------------------------------------------------------------- //
+
+bool CollisionCache::Write(const std::string& filePath, const CollisionBVH& bvh, unsigned int sourceTriangleCount, const MappedFile& source)
+{
+	unsigned int nodeCount     = bvh.GetNodeCount();
+	unsigned int triangleCount = bvh.GetTriangleCount();
+
+	if (triangleCount > sourceTriangleCount)
+		return false;
+
+	CollisionCacheHeader header;
+	memset(&header, 0, sizeof(CollisionCacheHeader));
+
+	memcpy(header.magic, kCollisionCacheMagic, sizeof(kCollisionCacheMagic));
+	header.version             = kCollisionCacheVersion;
+	header.headerSize          = sizeof(CollisionCacheHeader);
+	header.nodeStride          = sizeof(CollisionBVHNode);
+	header.triangleStride      = sizeof(CollisionTriangle);
+	header.nodeCount           = nodeCount;
+	header.triangleCount       = triangleCount;
+	header.sourceTriangleCount = sourceTriangleCount;
+	header.nodeOffset          = FileUtils::AlignUp(sizeof(CollisionCacheHeader), kArrayAlignment);
+	header.triangleOffset      = FileUtils::AlignUp(header.nodeOffset + (unsigned long long)nodeCount * sizeof(CollisionBVHNode), kArrayAlignment);
+	header.quantisationOrigin  = bvh.GetQuantisationOrigin();
+	header.quantisationScale   = bvh.GetQuantisationScale();
+	header.sourceSize          = source.GetSize();
+	header.sourceModifiedTime  = source.GetModifiedTime();
+	header.sourceHash          = MeshCache::HashBytes(source.GetData(), source.GetSize());
+
+	if (nodeCount > 0)
+	{
+		header.boundsMin = bvh.GetNodes()[0].boundsMin;
+		header.boundsMax = bvh.GetNodes()[0].boundsMax;
+	}
+
+	// Laid out in memory first - the gap between the arrays is left zeroed
+	std::vector<char> bytes((size_t)(header.triangleOffset + (unsigned long long)triangleCount * sizeof(CollisionTriangle)));
+
+	memcpy(bytes.data(), &header, sizeof(CollisionCacheHeader));
+	memcpy(bytes.data() + header.nodeOffset,     bvh.GetNodes(),     (size_t)nodeCount     * sizeof(CollisionBVHNode));
+	memcpy(bytes.data() + header.triangleOffset, bvh.GetTriangles(), (size_t)triangleCount * sizeof(CollisionTriangle));
+
+	return FileUtils::WriteFileReplacing(filePath, bytes.data(), bytes.size());
+}
+
+// -------------------------------------------------------------------- //
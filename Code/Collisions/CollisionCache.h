@@ -0,0 +1,103 @@
+#ifndef _COLLISION_CACHE_H_
+#define _COLLISION_CACHE_H_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include <directxmath.h>
+
+#include "CollisionBVH.h"
+
+#include "../Memory/AssetArchive.h"
+#include "../Memory/MappedFile.h"
+
+// -------------------------------------------------------------------- //
+
+// Bump whenever the layout of the file, CollisionBVHNode or CollisionTriangle changes, so that old caches are cooked again rather than misread
+const unsigned int kCollisionCacheVersion   = 1;
+const char* const  kCollisionCacheExtension = ".colcache";
+
+// -------------------------------------------------------------------- //
+
+// Sits at the start of the file. The node and triangle arrays follow at 16 byte aligned offsets, referring to each other only by
+// index, so the file can be queried wherever it is mapped.
+struct CollisionCacheHeader final
+{
+	char               magic[4];            // "TCOL"
+	unsigned int       version;
+	unsigned int       headerSize;
+	unsigned int       nodeStride;          // sizeof(CollisionBVHNode) when written
+
+	unsigned int       triangleStride;      // sizeof(CollisionTriangle) when written
+	unsigned int       nodeCount;
+	unsigned int       triangleCount;       // Those that can be hit - zero area ones are left out
+	unsigned int       sourceTriangleCount; // Every triangle of the source, which CollisionTriangle::sourceIndex counts through
+	unsigned long long nodeOffset;
+	unsigned long long triangleOffset;
+
+	DirectX::XMFLOAT3  quantisationOrigin;  // See CollisionBVH::GetQuantisationScale()
+	DirectX::XMFLOAT3  quantisationScale;
+	DirectX::XMFLOAT3  boundsMin;           // The root node's bounds, or all zero with nothing to hit
+	DirectX::XMFLOAT3  boundsMax;
+
+	// What the cache was cooked from - used to tell if it is out of date
+	unsigned long long sourceSize;
+	long long          sourceModifiedTime;  // Seconds since the Unix epoch
+	unsigned long long sourceHash;          // MeshCache::HashBytes() of the whole source file
+
+	unsigned long long padding;             // Spelt out so that the size is the same on every compiler
+};
+
+static_assert(sizeof(CollisionCacheHeader) == 128, "CollisionCacheHeader must have the same layout on every platform");
+
+// -------------------------------------------------------------------- //
+
+// A cooked collision cache file mapped into memory, or one stored in an asset archive. A CollisionBVH attached to its arrays queries
+// them in place, so loading costs no more than mapping the file and checking it - unless the archive compressed it, in which case
+// they are queried out of the decompressed copy.
+class CollisionCache final
+{
+public:
+	CollisionCache();
+	~CollisionCache();
+
+	CollisionCache(const CollisionCache&)            = delete;
+	CollisionCache& operator=(const CollisionCache&) = delete;
+
+	// Fails if the file is missing, from a different version, or its arrays do not fit inside it. The hierarchy in the arrays is
+	// checked by CollisionBVH::Attach().
+	bool                        Open(const std::string& filePath);
+	bool                        OpenFromArchive(const AssetArchive& archive, const AssetArchiveEntry& entry); // The archive must stay open
+	void                        Close();
+
+	bool                        GetIsOpen()       const { return mHeader != nullptr; }
+
+	// Whether the cache was cooked from source as it is now. The timestamp check avoids reading the whole source in the common case;
+	// if only the timestamp moved (a fresh checkout, or a save with no changes) the contents are compared by hash.
+	bool                        GetIsUpToDate(const MappedFile& source) const;
+
+	const CollisionCacheHeader& GetHeader()       const { return *mHeader; }
+	const CollisionBVHNode*     GetNodes()        const { return mNodes; }
+	const CollisionTriangle*    GetTriangles()    const { return mTriangles; }
+
+	// Attaches bvh to the cache's arrays, for as long as the cache stays open
+	bool                        Attach(CollisionBVH& bvh) const;
+
+	static bool                 Write(const std::string& filePath, const CollisionBVH& bvh, unsigned int sourceTriangleCount, const MappedFile& source);
+
+private:
+	// Sets the array pointers only if the whole block checks out
+	bool                        Validate(const char* data, size_t size);
+
+	MappedFile                  mFile;
+	std::vector<char>           mStorage;     // Only used for a cache the archive compressed
+
+	const CollisionCacheHeader* mHeader;
+	const CollisionBVHNode*     mNodes;
+	const CollisionTriangle*    mTriangles;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,266 @@
+#include "TrackBroadphase.h"
+
+#include <algorithm>
+#include <math.h>
+
+#include "../Maths/CommonMaths.h"
+#include "../Track/TrackPiece.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// The piece's rotation as a row-vector matrix, whose rows are local x, y and z in world space. Local +z turns to the facing direction
+	// keeping local +y up, except that pieces facing up or down tip over backwards or forwards.
+	DirectX::XMMATRIX GetPieceRotation(const DirectX::XMFLOAT3& facingDirection)
+	{
+		Vector3D forward(facingDirection.x, facingDirection.y, facingDirection.z);
+		float    length = forward.Length();
+
+		// A piece that has never been given a direction faces +z
+		if (!(length > 0.0f))
+			return DirectX::XMMatrixIdentity();
+
+		forward = forward / length;
+
+		bool     vertical = fabsf(forward.y) > fabsf(forward.x) && fabsf(forward.y) > fabsf(forward.z);
+		Vector3D up       = vertical ? Vector3D(0.0f, 0.0f, forward.y > 0.0f ? -1.0f : 1.0f) : Vector3D(0.0f, 1.0f, 0.0f);
+		Vector3D right    = up.Cross(forward);
+
+		right = right / right.Length();
+		up    = forward.Cross(right);
+
+		DirectX::XMFLOAT4X4 rotation(right.x,   right.y,   right.z,   0.0f,
+		                             up.x,      up.y,      up.z,      0.0f,
+		                             forward.x, forward.y, forward.z, 0.0f,
+		                             0.0f,      0.0f,      0.0f,      1.0f);
+
+		return DirectX::XMLoadFloat4x4(&rotation);
+	}
+
+	inline float GetAxis(const DirectX::XMFLOAT3& vector, unsigned int axis)
+	{
+		return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+	}
+
+	// The cells covering [boundsMin, boundsMax] along one axis - a piece's cell runs from half a cell before its origin to half after.
+	// A box that only touches a cell's edge covers it, from either side, as touching boxes overlap in ForEachBodyPair().
+	bool GetAxisCellRange(float boundsMin, float boundsMax, float cellSize, unsigned int& firstOut, unsigned int& lastOut)
+	{
+		float first = ceilf(boundsMin / cellSize - 0.5f);
+		float last  = floorf(boundsMax / cellSize + 0.5f);
+
+		// Written so that NaNs miss too
+		if (!(first <= last) || !(last >= 0.0f) || !(first <= (float)TrackGrid::kMaxGridCoordinate))
+			return false;
+
+		firstOut = (unsigned int)std::max(first, 0.0f);
+		lastOut  = (unsigned int)std::min(last, (float)TrackGrid::kMaxGridCoordinate);
+
+		return true;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+TrackBroadphase::TrackBroadphase(const TrackGrid& grid, float cellSize)
+	: mGrid(grid)
+	, mCellSize(cellSize)
+	, mBodies()
+	, mFreeBodies()
+	, mSweep()
+	, mSweepAxis(0)
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+TrackBroadphase::~TrackBroadphase()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int TrackBroadphase::AddBody(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+{
+	unsigned int body;
+
+	if (!mFreeBodies.empty())
+	{
+		body = mFreeBodies.back();
+		mFreeBodies.pop_back();
+	}
+	else
+	{
+		body = (unsigned int)mBodies.size();
+		mBodies.push_back(Body());
+	}
+
+	mBodies[body].boundsMin = boundsMin;
+	mBodies[body].boundsMax = boundsMax;
+	mBodies[body].inUse     = true;
+
+	// Goes on the end - the next Update() sorts it into place
+	SweepEntry entry;
+	entry.sweepMin  = GetAxis(boundsMin, mSweepAxis);
+	entry.sweepMax  = GetAxis(boundsMax, mSweepAxis);
+	entry.boundsMin = boundsMin;
+	entry.boundsMax = boundsMax;
+	entry.body      = body;
+
+	mSweep.push_back(entry);
+
+	return body;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackBroadphase::MoveBody(unsigned int body, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+{
+	if (body >= mBodies.size() || !mBodies[body].inUse)
+		return;
+
+	mBodies[body].boundsMin = boundsMin;
+	mBodies[body].boundsMax = boundsMax;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackBroadphase::RemoveBody(unsigned int body)
+{
+	if (body >= mBodies.size() || !mBodies[body].inUse)
+		return;
+
+	mBodies[body].inUse = false;
+	mFreeBodies.push_back(body);
+
+	// Erasing keeps the rest in order
+	for (unsigned int i = 0; i < (unsigned int)mSweep.size(); i++)
+	{
+		if (mSweep[i].body == body)
+		{
+			mSweep.erase(mSweep.begin() + i);
+			break;
+		}
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackBroadphase::Update()
+{
+	SweepEntry*  entries = mSweep.data();
+	unsigned int count   = (unsigned int)mSweep.size();
+
+	// Sweep along the axis the box centres are most spread out along, where the fewest boxes overlap
+	double sum[3]        = { 0.0, 0.0, 0.0 };
+	double sumSquared[3] = { 0.0, 0.0, 0.0 };
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const Body& body = mBodies[entries[i].body];
+
+		entries[i].boundsMin = body.boundsMin;
+		entries[i].boundsMax = body.boundsMax;
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			double centre = 0.5 * ((double)GetAxis(body.boundsMin, axis) + (double)GetAxis(body.boundsMax, axis));
+
+			sum[axis]        += centre;
+			sumSquared[axis] += centre * centre;
+		}
+	}
+
+	unsigned int sweepAxis = mSweepAxis;
+	double       spread[3];
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+		spread[axis] = sumSquared[axis] - sum[axis] * sum[axis] / std::max(count, 1u);
+
+	// Only switch for a clear winner, so that the order is not thrown away every update while two axes are about even
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		if (spread[axis] > spread[sweepAxis] * 1.5)
+			sweepAxis = axis;
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		entries[i].sweepMin = GetAxis(entries[i].boundsMin, sweepAxis);
+		entries[i].sweepMax = GetAxis(entries[i].boundsMax, sweepAxis);
+	}
+
+	if (sweepAxis != mSweepAxis)
+	{
+		mSweepAxis = sweepAxis;
+
+		std::sort(mSweep.begin(), mSweep.end(), [](const SweepEntry& a, const SweepEntry& b) { return a.sweepMin < b.sweepMin; });
+		return;
+	}
+
+	// Insertion sort - each body only has to move past the few it overtook since the last update
+	for (unsigned int i = 1; i < count; i++)
+	{
+		if (!(entries[i].sweepMin < entries[i - 1].sweepMin))
+			continue;
+
+		SweepEntry   entry = entries[i];
+		unsigned int j     = i;
+
+		while (j > 0 && entry.sweepMin < entries[j - 1].sweepMin)
+		{
+			entries[j] = entries[j - 1];
+			j--;
+		}
+
+		entries[j] = entry;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+DirectX::XMFLOAT4X4 TrackBroadphase::GetPieceToWorld(const TrackPiece& piece) const
+{
+	const DirectX::XMUINT3& cell           = piece.GetGridPosition();
+	DirectX::XMFLOAT4X4     assetTransform = piece.GetAssetTransformMatrix();
+
+	DirectX::XMMATRIX matrix = DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&assetTransform), GetPieceRotation(piece.GetFacingDirection()));
+	matrix                   = DirectX::XMMatrixMultiply(matrix, DirectX::XMMatrixTranslation((float)cell.x * mCellSize, (float)cell.y * mCellSize, (float)cell.z * mCellSize));
+
+	DirectX::XMFLOAT4X4 result;
+	DirectX::XMStoreFloat4x4(&result, matrix);
+
+	return result;
+}
+
+// -------------------------------------------------------------------- //
+
+DirectX::XMFLOAT4X4 TrackBroadphase::GetWorldToPiece(const TrackPiece& piece) const
+{
+	const DirectX::XMUINT3& cell           = piece.GetGridPosition();
+	DirectX::XMFLOAT4X4     assetTransform = piece.GetAssetTransformMatrix();
+
+	// The asset transform is at most a mirror, which is its own inverse, and the rotation's inverse is its transpose
+	DirectX::XMMATRIX matrix = DirectX::XMMatrixTranslation(-(float)cell.x * mCellSize, -(float)cell.y * mCellSize, -(float)cell.z * mCellSize);
+	matrix                   = DirectX::XMMatrixMultiply(matrix, DirectX::XMMatrixTranspose(GetPieceRotation(piece.GetFacingDirection())));
+	matrix                   = DirectX::XMMatrixMultiply(matrix, DirectX::XMLoadFloat4x4(&assetTransform));
+
+	DirectX::XMFLOAT4X4 result;
+	DirectX::XMStoreFloat4x4(&result, matrix);
+
+	return result;
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackBroadphase::GetCellRange(const Body& body, DirectX::XMUINT3& firstOut, DirectX::XMUINT3& lastOut) const
+{
+	return GetAxisCellRange(body.boundsMin.x, body.boundsMax.x, mCellSize, firstOut.x, lastOut.x)
+	    && GetAxisCellRange(body.boundsMin.y, body.boundsMax.y, mCellSize, firstOut.y, lastOut.y)
+	    && GetAxisCellRange(body.boundsMin.z, body.boundsMax.z, mCellSize, firstOut.z, lastOut.z);
+}
+
+// -------------------------------------------------------------------- //
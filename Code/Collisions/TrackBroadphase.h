@@ -0,0 +1,153 @@
+#ifndef _TRACK_BROADPHASE_H_
+#define _TRACK_BROADPHASE_H_
+
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "../Track/TrackGrid.h"
+
+class TrackPiece;
+
+// -------------------------------------------------------------------- //
+
+// A piece whose cell a body's box reaches into. Most of these are thrown out by the first cheap test, so the piece's transforms are
+// only worked out if TrackBroadphase is asked for them.
+struct TrackPieceCandidate final
+{
+	unsigned int      body;
+	TrackPiece*       piece;
+	DirectX::XMUINT3  cell;
+};
+
+// -------------------------------------------------------------------- //
+
+// Finds what might be touching what, for moving bodies on a placed track.
+// The pieces are found through the track's TrackGrid - each body looks up the few cells its box covers, so the cost does not grow with
+// the length of the track. Bodies against each other use sweep and prune, along whichever axis the bodies are most spread out along
+// as the track winds about. The bodies are kept sorted by where their boxes start along it, and re-sorted by insertion sort, which is
+// close to linear as bodies only move a little between updates.
+//
+// A piece's origin sits at its grid position times the cell size, with its local +z turned to its facing direction. Its collision
+// mesh must stay within half a cell of that.
+// The broadphase does not own the grid, which must outlive it and may change between queries.
+class TrackBroadphase final
+{
+public:
+	TrackBroadphase(const TrackGrid& grid, float cellSize);
+	~TrackBroadphase();
+
+	// Bodies are world space boxes. Ids of removed bodies are handed out again.
+	unsigned int        AddBody(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax);
+	void                MoveBody(unsigned int body, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax);
+	void                RemoveBody(unsigned int body);
+
+	// Brings the sweep and prune order up to date with the moved bodies - call before ForEachBodyPair()
+	void                Update();
+
+	// Calls function(candidate) for every piece in a cell that a body's box covers, grouped by body
+	template<typename Function>
+	void                ForEachPieceCandidate(Function function) const;
+
+	// Calls function(bodyA, bodyB) for every pair of bodies whose boxes overlap, in no particular order
+	template<typename Function>
+	void                ForEachBodyPair(Function function) const;
+
+	// Where the piece is placed. GetWorldToPiece() moves queries into the space of the piece's TrackCollision, mirroring included.
+	DirectX::XMFLOAT4X4 GetPieceToWorld(const TrackPiece& piece) const;
+	DirectX::XMFLOAT4X4 GetWorldToPiece(const TrackPiece& piece) const;
+
+	unsigned int        GetBodyCount() const { return (unsigned int)mSweep.size(); }
+	float               GetCellSize()  const { return mCellSize; }
+
+private:
+	struct Body final
+	{
+		DirectX::XMFLOAT3 boundsMin;
+		DirectX::XMFLOAT3 boundsMax;
+		bool              inUse;
+	};
+
+	// A copy of the body's box, so that the sweep reads memory in order
+	struct SweepEntry final
+	{
+		float             sweepMin;  // The box along the sweep axis
+		float             sweepMax;
+		DirectX::XMFLOAT3 boundsMin;
+		DirectX::XMFLOAT3 boundsMax;
+		unsigned int      body;
+	};
+
+	// The range of cells the box covers, or false if it misses the grid
+	bool                GetCellRange(const Body& body, DirectX::XMUINT3& firstOut, DirectX::XMUINT3& lastOut) const;
+
+	const TrackGrid&          mGrid;
+	float                     mCellSize;
+
+	std::vector<Body>         mBodies;
+	std::vector<unsigned int> mFreeBodies;
+	std::vector<SweepEntry>   mSweep;  // Sorted by sweepMin as of the last Update()
+	unsigned int              mSweepAxis;
+};
+
+// -------------------------------------------------------------------- //
+
+template<typename Function>
+void TrackBroadphase::ForEachPieceCandidate(Function function) const
+{
+	TrackPieceCandidate candidate;
+
+	for (unsigned int body = 0; body < (unsigned int)mBodies.size(); body++)
+	{
+		DirectX::XMUINT3 first;
+		DirectX::XMUINT3 last;
+
+		if (!mBodies[body].inUse || !GetCellRange(mBodies[body], first, last))
+			continue;
+
+		candidate.body = body;
+
+		for (candidate.cell.x = first.x; candidate.cell.x <= last.x; candidate.cell.x++)
+		{
+			for (candidate.cell.y = first.y; candidate.cell.y <= last.y; candidate.cell.y++)
+			{
+				for (candidate.cell.z = first.z; candidate.cell.z <= last.z; candidate.cell.z++)
+				{
+					candidate.piece = mGrid.Find(candidate.cell);
+
+					if (candidate.piece)
+						function(candidate);
+				}
+			}
+		}
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename Function>
+void TrackBroadphase::ForEachBodyPair(Function function) const
+{
+	const SweepEntry* entries = mSweep.data();
+	unsigned int      count   = (unsigned int)mSweep.size();
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const SweepEntry& a = entries[i];
+
+		// Sorted by where they start, so the sweep can stop at the first box that starts past this one's end
+		for (unsigned int j = i + 1; j < count && entries[j].sweepMin <= a.sweepMax; j++)
+		{
+			const SweepEntry& b = entries[j];
+
+			if (a.boundsMin.x <= b.boundsMax.x && b.boundsMin.x <= a.boundsMax.x &&
+			    a.boundsMin.y <= b.boundsMax.y && b.boundsMin.y <= a.boundsMax.y &&
+			    a.boundsMin.z <= b.boundsMax.z && b.boundsMin.z <= a.boundsMax.z)
+				function(a.body, b.body);
+		}
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+#endif
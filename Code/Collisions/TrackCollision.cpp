@@ -1,10 +1,94 @@
 #include "TrackCollision.h"
 
+#include <math.h>
+#include <vector>
+
+#include "../Memory/AssetArchive.h"
+#include "../Memory/MappedFile.h"
+#include "../Models/MeshCache.h"
+#include "../Models/ObjParser.h"
+
 // --------------------------------------------------------------------- //
 
 TrackCollision::TrackCollision(std::string filePathToCollisionData)
+	: mCache()
+	, mBVH()
+	, mContentHash(0)
+	, mIsLoaded(false)
 {
+	// No collision data at all - left as a missing file would be, without looking for "" and ".colcache" in the working directory
+	if (filePathToCollisionData == "")
+	{
+		Load(nullptr, 0);
+		return;
+	}
+
+	std::string cachePath = filePathToCollisionData + kCollisionCacheExtension;
+	MappedFile  file;
+
+	// A missing file hashes the same as an empty one - both leave the piece with nothing to collide with
+	bool sourceFound = file.Open(filePathToCollisionData);
+
+	// A cache with no source beside it is all there is, so it is used as it is
+	if (mCache.Open(cachePath))
+	{
+		if ((!sourceFound || mCache.GetIsUpToDate(file)) && mCache.Attach(mBVH))
+		{
+			mContentHash = mCache.GetHeader().sourceHash;
+			mIsLoaded    = true;
+			return;
+		}
+
+		mCache.Close();
+	}
+
+	unsigned int sourceTriangleCount = Load(file.GetData(), file.GetSize());
+
+	mIsLoaded = sourceFound;
 
+	// Cooked now so that the next load is instant. This load keeps the hierarchy it built, and if the cache cannot be written
+	// (e.g. a read-only install) every load builds its own.
+	if (sourceFound)
+		CollisionCache::Write(cachePath, mBVH, sourceTriangleCount, file);
+}
+
+// --------------------------------------------------------------------- //
+
+TrackCollision::TrackCollision(const AssetArchive& archive, const std::string& name)
+	: mCache()
+	, mBVH()
+	, mContentHash(0)
+	, mIsLoaded(false)
+{
+	// Queried in place, if the archive stored the cache uncompressed
+	if (const AssetArchiveEntry* cacheEntry = archive.Find(name + kCollisionCacheExtension))
+	{
+		if (mCache.OpenFromArchive(archive, *cacheEntry) && mCache.Attach(mBVH))
+		{
+			mContentHash = mCache.GetHeader().sourceHash;
+			mIsLoaded    = true;
+			return;
+		}
+
+		mCache.Close();
+	}
+
+	// There is nowhere to write a cache back to, so the build is redone on every load - pack with the caches to avoid it
+	const AssetArchiveEntry* entry = archive.Find(name);
+
+	std::vector<char> storage;
+	const char*       data = nullptr;
+	size_t            size = 0;
+
+	mIsLoaded = entry && archive.Read(*entry, storage, data, size);
+
+	if (!mIsLoaded)
+	{
+		data = nullptr;
+		size = 0;
+	}
+
+	Load(data, size);
 }
 
 // --------------------------------------------------------------------- //
@@ -15,3 +99,77 @@ TrackCollision::~TrackCollision()
 }
 
 // --------------------------------------------------------------------- //
+
+bool TrackCollision::Cook(const std::string& filePathToCollisionData)
+{
+	MappedFile file;
+
+	if (!file.Open(filePathToCollisionData))
+		return false;
+
+	CollisionBVH bvh;
+	unsigned int sourceTriangleCount = BuildFromObj(file.GetData(), file.GetSize(), bvh);
+
+	return CollisionCache::Write(filePathToCollisionData + kCollisionCacheExtension, bvh, sourceTriangleCount, file);
+}
+
+// --------------------------------------------------------------------- //
+
+bool TrackCollision::SphereTimeOfImpact(const DirectX::XMFLOAT3& centre, float radius, const DirectX::XMFLOAT3& motion, float& timeOut, CollisionHit& hitOut) const
+{
+	float length = sqrtf(motion.x * motion.x + motion.y * motion.y + motion.z * motion.z);
+
+	// Without any motion the sweep is only a check for touching at the start, which any direction does
+	if (!mBVH.SphereCast(centre, length > 0.0f ? motion : DirectX::XMFLOAT3(0.0f, -1.0f, 0.0f), radius, length, hitOut))
+		return false;
+
+	timeOut = length > 0.0f ? hitOut.distance / length : 0.0f;
+	return true;
+}
+
+// --------------------------------------------------------------------- //
+
+bool TrackCollision::CapsuleTimeOfImpact(const DirectX::XMFLOAT3& segmentStart, const DirectX::XMFLOAT3& segmentEnd, float radius, const DirectX::XMFLOAT3& motion, float& timeOut, CollisionHit& hitOut) const
+{
+	float length = sqrtf(motion.x * motion.x + motion.y * motion.y + motion.z * motion.z);
+
+	if (!mBVH.CapsuleCast(segmentStart, segmentEnd, length > 0.0f ? motion : DirectX::XMFLOAT3(0.0f, -1.0f, 0.0f), radius, length, hitOut))
+		return false;
+
+	timeOut = length > 0.0f ? hitOut.distance / length : 0.0f;
+	return true;
+}
+
+// --------------------------------------------------------------------- //
+
+unsigned int TrackCollision::Load(const char* data, size_t size)
+{
+	mContentHash = MeshCache::HashBytes(data, size);
+
+	return BuildFromObj(data, size, mBVH);
+}
+
+// --------------------------------------------------------------------- //
+
+unsigned int TrackCollision::BuildFromObj(const char* data, size_t size, CollisionBVH& bvhOut)
+{
+	bvhOut.Clear();
+
+	std::vector<VertexData>   vertices;
+	std::vector<unsigned int> indices;
+
+	if (size == 0 || !ObjParser::Parse(data, size, vertices, indices))
+		return 0;
+
+	std::vector<DirectX::XMFLOAT3> positions(vertices.size());
+
+	for (size_t i = 0; i < vertices.size(); i++)
+		positions[i] = vertices[i].vertexPosition;
+
+	if (!bvhOut.Build(positions, indices))
+		return 0;
+
+	return (unsigned int)(indices.size() / 3);
+}
+
+// --------------------------------------------------------------------- //
@@ -1,16 +1,83 @@
 #ifndef _TRACK_COLLISION_H_
 #define _TRACK_COLLISION_H_
 
+#include <stddef.h>
 #include <string>
 
+#include "CollisionBVH.h"
+#include "CollisionCache.h"
+
+class AssetArchive;
+
+// The collision surface of one track piece type, in the piece's own space - callers move their queries into it with the inverse of
+// the piece's placement (and TrackPiece::GetAssetTransformMatrix() for mirrored types). Read from an OBJ mesh; only the positions are used.
+// A missing or unreadable file leaves an empty surface that nothing collides with - GetIsLoaded() tells the two apart.
+//
+// The built hierarchy is cooked into a CollisionCache beside the source - see Tools/CollisionCooker - and later loads query that in
+// place instead of parsing and building again.
 class TrackCollision final
 {
 public:
 	TrackCollision(std::string filePathToCollisionData);
+
+	// Reads the named entry out of an open archive - a missing entry is treated like a missing file. A cache packed alongside it under
+	// name + kCollisionCacheExtension is used instead where there is one.
+	TrackCollision(const AssetArchive& archive, const std::string& name);
 	~TrackCollision();
 
+	TrackCollision(const TrackCollision&)            = delete;
+	TrackCollision& operator=(const TrackCollision&) = delete;
+
+	// Builds the hierarchy for the source file and writes it to the cache beside it, whether or not that was up to date.
+	// Fails if the source is missing or the cache cannot be written.
+	static bool        Cook(const std::string& filePathToCollisionData);
+
+	bool               RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, CollisionHit& hitOut) const
+	                   { return mBVH.RayCast(origin, direction, maxDistance, hitOut); }
+
+	// Traces a packet of rays together, e.g. a vehicle's wheel rays - see CollisionBVH::RayCastPacket(). pieceId is whatever the caller
+	// uses to tell pieces apart, recorded against each hit so that one set of hits can be carried through several pieces.
+	unsigned int       RayCastPacket(const RayPacket& rays, unsigned int pieceId, RayPacketHits& hitsOut) const
+	                   { return mBVH.RayCastPacket(rays, pieceId, hitsOut); }
+
+	bool               SphereCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float radius, float maxDistance, CollisionHit& hitOut) const
+	                   { return mBVH.SphereCast(origin, direction, radius, maxDistance, hitOut); }
+
+	bool               CapsuleCast(const DirectX::XMFLOAT3& segmentStart, const DirectX::XMFLOAT3& segmentEnd, const DirectX::XMFLOAT3& direction, float radius, float maxDistance, CollisionHit& hitOut) const
+	                   { return mBVH.CapsuleCast(segmentStart, segmentEnd, direction, radius, maxDistance, hitOut); }
+
+	// Time of impact over one physics step - how far through motion (0 to 1) the shape first touches the surface, so that a fast body
+	// can be stopped there rather than stepping straight through a thin piece. The shape moves in a straight line without turning.
+	// A shape touching the surface at the start of the step hits at 0, whether or not it moves.
+	bool               SphereTimeOfImpact(const DirectX::XMFLOAT3& centre, float radius, const DirectX::XMFLOAT3& motion, float& timeOut, CollisionHit& hitOut) const;
+	bool               CapsuleTimeOfImpact(const DirectX::XMFLOAT3& segmentStart, const DirectX::XMFLOAT3& segmentEnd, float radius, const DirectX::XMFLOAT3& motion, float& timeOut, CollisionHit& hitOut) const;
+
+	bool               ClosestPoint(const DirectX::XMFLOAT3& point, float maxDistance, CollisionHit& hitOut) const
+	                   { return mBVH.ClosestPoint(point, maxDistance, hitOut); }
+
+	const CollisionBVH& GetBVH() const { return mBVH; }
+
+	// Collision data with the same hash is identical, so one can stand in for the other - see TrackPieceFactory
+	unsigned long long GetContentHash() const { return mContentHash; }
+
+	size_t             GetMemoryUsage() const { return sizeof(TrackCollision) + mBVH.GetMemoryUsage(); }
+
+	// Whether the surface was queried straight out of a cache rather than built on loading
+	bool               GetIsFromCache() const { return mCache.GetIsOpen(); }
+
+	// Whether there was collision data to read, from a cache or the source. False for an empty path or name.
+	bool               GetIsLoaded()    const { return mIsLoaded; }
+
 private:
+	// Returns how many triangles the source had, zero area ones included
+	unsigned int       Load(const char* data, size_t size);
+
+	static unsigned int BuildFromObj(const char* data, size_t size, CollisionBVH& bvhOut);
 
+	CollisionCache     mCache;       // Must outlive mBVH, which may be attached to its arrays
+	CollisionBVH       mBVH;
+	unsigned long long mContentHash;
+	bool               mIsLoaded;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -42,10 +42,13 @@ GameScreen_MainMenu::~GameScreen_MainMenu()
 
 void GameScreen_MainMenu::Render()
 {
-	if (testCube)
+	// Skip anything the camera cannot see
+	const Frustum& frustum = mCamera->GetFrustum();
+
+	if (testCube && frustum.IsBoxVisible(testCube->GetPosition(), testCube->GetHalfExtents()))
 		testCube->Render(mCamera);
 
-	if (testCube2)
+	if (testCube2 && frustum.IsBoxVisible(testCube2->GetPosition(), testCube2->GetHalfExtents()))
 		testCube2->Render(mCamera);
 }
 
@@ -2,6 +2,9 @@
 #define _COMMON_MATHS_H_
 
 #include <DirectXMath.h>
+#include <math.h>
+
+#include "FastMaths.h"
 
 #define TWOPI  6.283185307f
 #define PI     3.141592654f
@@ -10,47 +13,53 @@
 
 // ---------------------------------------------------------------------------------------------------------------------------- //
 
+// The vector types are header-only and inline so that chains of operators can be folded together by the compiler.
+// Everything that does not need a square root is constexpr.
+
 struct Vector2D final
 {
 public:
-	Vector2D();
-	Vector2D(float x, float y);
-	Vector2D(const Vector2D& copy);
+	constexpr Vector2D() : x(0.0f), y(0.0f) {}
+	constexpr Vector2D(float x, float y) : x(x), y(y) {}
+	constexpr Vector2D(const Vector2D& copy) = default;
 
 
 	//------------------------ Overloaded operator functions ------------------------//
-	Vector2D  operator+(const Vector2D& other);  // Plus
-	Vector2D& operator+=(const Vector2D& other); // Plus equals
+	constexpr Vector2D  operator+(const Vector2D& other) const    { return Vector2D(x + other.x, y + other.y); } // Plus
+	constexpr Vector2D& operator+=(const Vector2D& other)         { x += other.x; y += other.y; return *this; }  // Plus equals
 
-	Vector2D  operator-(const Vector2D& other);  // Minus
-	Vector2D& operator-=(const Vector2D& other); // Minus equals
+	constexpr Vector2D  operator-(const Vector2D& other) const    { return Vector2D(x - other.x, y - other.y); } // Minus
+	constexpr Vector2D& operator-=(const Vector2D& other)         { x -= other.x; y -= other.y; return *this; }  // Minus equals
 
-	Vector2D  operator*(const float& factor);    // Multiply (float)
-	Vector2D& operator*=(const float& factor);   // Multiply equals (float)
+	constexpr Vector2D  operator-() const                         { return Vector2D(-x, -y); }                   // Negate
 
-	Vector2D  operator*(const int& factor);      // Multiply (int) (casts the factor to a float)
-	Vector2D& operator*=(const int& factor);     // Multiply equals (int) (casts the factor to a float)
+	constexpr Vector2D  operator*(float factor) const             { return Vector2D(x * factor, y * factor); }   // Multiply (float)
+	constexpr Vector2D& operator*=(float factor)                  { x *= factor; y *= factor; return *this; }    // Multiply equals (float)
 
-	Vector2D  operator/(const float& factor);    // Divide (float)
-	Vector2D& operator/=(const float& factor);   // Divide equals (float)
+	constexpr Vector2D  operator*(int factor) const               { return *this * (float)factor; }              // Multiply (int) (casts the factor to a float)
+	constexpr Vector2D& operator*=(int factor)                    { return *this *= (float)factor; }             // Multiply equals (int) (casts the factor to a float)
 
-	Vector2D  operator/(const int& factor);      // Divide (int) (casts the factor to a float)
-	Vector2D& operator/=(const int& factor);     // Divide equals (int) (casts the factor to a float)
+	constexpr Vector2D  operator/(float factor) const             { return Vector2D(x / factor, y / factor); }   // Divide (float)
+	constexpr Vector2D& operator/=(float factor)                  { x /= factor; y /= factor; return *this; }    // Divide equals (float)
 
-	void     operator=(const Vector2D& other);  // Setter
+	constexpr Vector2D  operator/(int factor) const               { return *this / (float)factor; }              // Divide (int) (casts the factor to a float)
+	constexpr Vector2D& operator/=(int factor)                    { return *this /= (float)factor; }             // Divide equals (int) (casts the factor to a float)
 
-	bool     operator==(const Vector2D other);
+	constexpr Vector2D& operator=(const Vector2D& other) = default;                                              // Setter
+
+	constexpr bool      operator==(const Vector2D& other) const   { return x == other.x && y == other.y; }
+	constexpr bool      operator!=(const Vector2D& other) const   { return !(*this == other); }
 
 	//------------------------ Functionality functions ------------------------//
-	float    Dot(const Vector2D& other);
+	constexpr float    Dot(const Vector2D& other) const           { return (x * other.x) + (y * other.y); }
 
-	Vector2D Normalised(); // Retuns back the normalised vector - doesn't change the data stored internally
-	Vector2D& Normalise();  // Changes the internal data and then returns itself back
+	Vector2D  Normalised() const                                  { return *this  * (1.0f / Length()); }         // Retuns back the normalised vector - doesn't change the data stored internally
+	Vector2D& Normalise()                                         { return *this *= 1.0f / Length(); }           // Changes the internal data and then returns itself back
 
-	float    Length();        // Calculates the length of the vector
-	float    LengthSquared(); // Calculates the length squared of the vector
+	float     Length() const                                      { return sqrtf(LengthSquared()); }             // Calculates the length of the vector
+	constexpr float LengthSquared() const                         { return (x * x) + (y * y); }                  // Calculates the length squared of the vector
 
-	DirectX::XMFLOAT2 ConvertToDirectXFloat2();
+	constexpr DirectX::XMFLOAT2 ConvertToDirectXFloat2() const    { return DirectX::XMFLOAT2(x, y); }
 
 	static Vector2D worldUp;
 	static Vector2D zero;
@@ -63,48 +72,61 @@ public:
 struct Vector3D final
 {
 public:
-	Vector3D();
-	Vector3D(float x, float y, float z);
-	Vector3D(const Vector3D& copy);
+	constexpr Vector3D() : x(0.0f), y(0.0f), z(0.0f) {}
+	constexpr Vector3D(float x, float y, float z) : x(x), y(y), z(z) {}
+	constexpr Vector3D(const Vector3D& copy) = default;
 
 
 	//------------------------ Overloaded operator functions ------------------------//
-	Vector3D operator+(const Vector3D& other);  // Plus
-	Vector3D& operator+=(const Vector3D& other); // Plus equals
+	constexpr Vector3D  operator+(const Vector3D& other) const    { return Vector3D(x + other.x, y + other.y, z + other.z); } // Plus
+	constexpr Vector3D& operator+=(const Vector3D& other)         { x += other.x; y += other.y; z += other.z; return *this; } // Plus equals
 
-	Vector3D operator-(const Vector3D& other);  // Minus
-	Vector3D& operator-=(const Vector3D& other); // Minus equals
+	constexpr Vector3D  operator-(const Vector3D& other) const    { return Vector3D(x - other.x, y - other.y, z - other.z); } // Minus
+	constexpr Vector3D& operator-=(const Vector3D& other)         { x -= other.x; y -= other.y; z -= other.z; return *this; } // Minus equals
 
-	Vector3D operator*(const float& factor);    // Multiply (float)
-	Vector3D& operator*=(const float& factor);   // Multiply equals (float)
+	constexpr Vector3D  operator-() const                         { return Vector3D(-x, -y, -z); }                            // Negate
 
-	Vector3D operator*(const int& factor);      // Multiply (int)
-	Vector3D& operator*=(const int& factor);     // Multiply equals (int)
+	constexpr Vector3D  operator*(float factor) const             { return Vector3D(x * factor, y * factor, z * factor); }    // Multiply (float)
+	constexpr Vector3D& operator*=(float factor)                  { x *= factor; y *= factor; z *= factor; return *this; }    // Multiply equals (float)
 
-	Vector3D operator*(const DirectX::XMFLOAT3X3& matrix); // Matrix multiplication
-	Vector3D operator*=(const DirectX::XMFLOAT3X3& matrix); // Matrix multiplication
+	constexpr Vector3D  operator*(int factor) const               { return *this * (float)factor; }                           // Multiply (int) (casts the factor to a float)
+	constexpr Vector3D& operator*=(int factor)                    { return *this *= (float)factor; }                          // Multiply equals (int) (casts the factor to a float)
 
-	Vector3D operator/(const float& factor);    // Divide (float)
-	Vector3D& operator/=(const float& factor);   // Divide equals (float)
+	constexpr Vector3D  operator*(const DirectX::XMFLOAT3X3& matrix) const                                                    // Matrix multiplication
+	{
+		return Vector3D((x * matrix._11) + (y * matrix._21) + (z * matrix._31),
+		                (x * matrix._12) + (y * matrix._22) + (z * matrix._32),
+		                (x * matrix._13) + (y * matrix._23) + (z * matrix._33));
+	}
+	constexpr Vector3D& operator*=(const DirectX::XMFLOAT3X3& matrix){ return *this = *this * matrix; }                       // Matrix multiplication
+
+	constexpr Vector3D  operator/(float factor) const             { return Vector3D(x / factor, y / factor, z / factor); }    // Divide (float)
+	constexpr Vector3D& operator/=(float factor)                  { x /= factor; y /= factor; z /= factor; return *this; }    // Divide equals (float)
 
-	Vector3D operator/(const int& factor);      // Divide (int)
-	Vector3D& operator/=(const int& factor);     // Divide equals (int)
+	constexpr Vector3D  operator/(int factor) const               { return *this / (float)factor; }                           // Divide (int) (casts the factor to a float)
+	constexpr Vector3D& operator/=(int factor)                    { return *this /= (float)factor; }                          // Divide equals (int) (casts the factor to a float)
 
-	void     operator=(const Vector3D& other);  // Setter
+	constexpr Vector3D& operator=(const Vector3D& other) = default;                                                           // Setter
 
-	bool     operator==(const Vector3D other);
+	constexpr bool      operator==(const Vector3D& other) const   { return x == other.x && y == other.y && z == other.z; }
+	constexpr bool      operator!=(const Vector3D& other) const   { return !(*this == other); }
 
 	//------------------------ Functionality functions ------------------------//
-	float    Dot(const Vector3D& other);
-	Vector3D Cross(const Vector3D& other);
+	constexpr float    Dot(const Vector3D& other) const           { return (x * other.x) + (y * other.y) + (z * other.z); }
+	constexpr Vector3D Cross(const Vector3D& other) const
+	{
+		return Vector3D((y * other.z) - (z * other.y),
+		                (z * other.x) - (x * other.z),
+		                (x * other.y) - (y * other.x));
+	}
 
-	Vector3D Normalised(); // Retuns back the normalised vector - doesn't change the data stored internally
-	Vector3D& Normalise();  // Changes the internal data and then returns itself back
+	Vector3D  Normalised() const                                  { return *this  * (1.0f / Length()); }                      // Retuns back the normalised vector - doesn't change the data stored internally
+	Vector3D& Normalise()                                         { return *this *= 1.0f / Length(); }                        // Changes the internal data and then returns itself back
 
-	float    Length();        // Calculates the length of the vector
-	float    LengthSquared(); // Calculates the length squared of the vector
+	float     Length() const                                      { return sqrtf(LengthSquared()); }                          // Calculates the length of the vector
+	constexpr float LengthSquared() const                         { return (x * x) + (y * y) + (z * z); }                     // Calculates the length squared of the vector
 
-	DirectX::XMFLOAT3 ConvertToDirectXFloat3();
+	constexpr DirectX::XMFLOAT3 ConvertToDirectXFloat3() const    { return DirectX::XMFLOAT3(x, y, z); }
 
 	static Vector3D worldUp;
 	static Vector3D zero;
@@ -117,44 +139,47 @@ public:
 struct Vector4D final
 {
 public:
-	Vector4D();
-	Vector4D(float x, float y, float z, float w);
-	Vector4D(const Vector4D& copy);
+	constexpr Vector4D() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+	constexpr Vector4D(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+	constexpr Vector4D(const Vector4D& copy) = default;
 
 
 	//------------------------ Overloaded operator functions ------------------------//
-	Vector4D operator+(const Vector4D& other);  // Plus
-	Vector4D& operator+=(const Vector4D& other); // Plus equals
+	constexpr Vector4D  operator+(const Vector4D& other) const    { return Vector4D(x + other.x, y + other.y, z + other.z, w + other.w); }  // Plus
+	constexpr Vector4D& operator+=(const Vector4D& other)         { x += other.x; y += other.y; z += other.z; w += other.w; return *this; } // Plus equals
+
+	constexpr Vector4D  operator-(const Vector4D& other) const    { return Vector4D(x - other.x, y - other.y, z - other.z, w - other.w); }  // Minus
+	constexpr Vector4D& operator-=(const Vector4D& other)         { x -= other.x; y -= other.y; z -= other.z; w -= other.w; return *this; } // Minus equals
 
-	Vector4D operator-(const Vector4D& other);  // Minus
-	Vector4D& operator-=(const Vector4D& other); // Minus equals
+	constexpr Vector4D  operator-() const                         { return Vector4D(-x, -y, -z, -w); }                                      // Negate
 
-	Vector4D operator*(const float& factor);    // Multiply (float)
-	Vector4D& operator*=(const float& factor);   // Multiply equals (float)
+	constexpr Vector4D  operator*(float factor) const             { return Vector4D(x * factor, y * factor, z * factor, w * factor); }      // Multiply (float)
+	constexpr Vector4D& operator*=(float factor)                  { x *= factor; y *= factor; z *= factor; w *= factor; return *this; }     // Multiply equals (float)
 
-	Vector4D operator*(const int& factor);      // Multiply (int)
-	Vector4D& operator*=(const int& factor);     // Multiply equals (int)
+	constexpr Vector4D  operator*(int factor) const               { return *this * (float)factor; }                                         // Multiply (int) (casts the factor to a float)
+	constexpr Vector4D& operator*=(int factor)                    { return *this *= (float)factor; }                                        // Multiply equals (int) (casts the factor to a float)
 
-	Vector4D operator/(const float& factor);    // Divide (float)
-	Vector4D& operator/=(const float& factor);   // Divide equals (float)
+	constexpr Vector4D  operator/(float factor) const             { return Vector4D(x / factor, y / factor, z / factor, w / factor); }      // Divide (float)
+	constexpr Vector4D& operator/=(float factor)                  { x /= factor; y /= factor; z /= factor; w /= factor; return *this; }     // Divide equals (float)
 
-	Vector4D operator/(const int& factor);      // Divide (int)
-	Vector4D& operator/=(const int& factor);     // Divide equals (int)
+	constexpr Vector4D  operator/(int factor) const               { return *this / (float)factor; }                                         // Divide (int) (casts the factor to a float)
+	constexpr Vector4D& operator/=(int factor)                    { return *this /= (float)factor; }                                        // Divide equals (int) (casts the factor to a float)
 
-	void     operator=(const Vector4D& other);  // Setter
+	constexpr Vector4D& operator=(const Vector4D& other) = default;                                                                         // Setter
 
-	bool     operator==(const Vector4D other);
+	constexpr bool      operator==(const Vector4D& other) const   { return x == other.x && y == other.y && z == other.z && w == other.w; }
+	constexpr bool      operator!=(const Vector4D& other) const   { return !(*this == other); }
 
 	//------------------------ Functionality functions ------------------------//
-	float    Dot(const Vector4D& other);
+	constexpr float    Dot(const Vector4D& other) const           { return (x * other.x) + (y * other.y) + (z * other.z) + (w * other.w); }
 
-	Vector4D Normalised();  // Retuns back the normalised vector - doesn't change the data stored internally
-	Vector4D& Normalise();  // Changes the internal data and then returns itself back
+	Vector4D  Normalised() const                                  { return *this  * (1.0f / Length()); }                                    // Retuns back the normalised vector - doesn't change the data stored internally
+	Vector4D& Normalise()                                         { return *this *= 1.0f / Length(); }                                      // Changes the internal data and then returns itself back
 
-	float    Length();        // Calculates the length of the vector
-	float    LengthSquared(); // Calculates the length squared of the vector
+	float     Length() const                                      { return sqrtf(LengthSquared()); }                                        // Calculates the length of the vector
+	constexpr float LengthSquared() const                         { return (x * x) + (y * y) + (z * z) + (w * w); }                         // Calculates the length squared of the vector
 
-	DirectX::XMFLOAT4 ConvertToDirectXFloat4();
+	constexpr DirectX::XMFLOAT4 ConvertToDirectXFloat4() const    { return DirectX::XMFLOAT4(x, y, z, w); }
 
 	static Vector4D worldUp;
 	static Vector4D zero;
@@ -164,6 +189,248 @@ public:
 
 // ---------------------------------------------------------------------------------------------------------------------------- //
 
+// Unit quaternion used for storing orientations and applying rotations without building a matrix each time.
+// Composition follows the same order as matrices in a column convention: (a * b) rotates by b first, then by a.
+struct Quaternion final
+{
+public:
+	constexpr Quaternion(); // Identity rotation
+	constexpr Quaternion(float x, float y, float z, float w);
+	constexpr Quaternion(const Quaternion& copy) = default;
+
+	template<typename Precision = ExactPrecision>
+	static Quaternion FromAxisAngle(Vector3D axis, float angle); // The axis must already be normalised
+
+	//------------------------ Overloaded operator functions ------------------------//
+	constexpr Quaternion  operator*(const Quaternion& other) const; // Composition
+	constexpr Quaternion& operator*=(const Quaternion& other);      // Composition equals
+
+	constexpr Quaternion& operator=(const Quaternion& other) = default; // Setter
+
+	constexpr bool        operator==(const Quaternion& other) const;
+
+	//------------------------ Functionality functions ------------------------//
+	constexpr float       Dot(const Quaternion& other) const;
+	constexpr Quaternion  Conjugate() const; // The inverse rotation for a unit quaternion
+
+	Vector3D    RotateVector(const Vector3D& vector) const;
+
+	Quaternion  Normalised() const; // Retuns back the normalised quaternion - doesn't change the data stored internally
+	Quaternion& Normalise();        // Changes the internal data and then returns itself back
+
+	float       Length() const;                  // Calculates the length of the quaternion
+	constexpr float LengthSquared() const;       // Calculates the length squared of the quaternion
+
+	static Quaternion Slerp(Quaternion from, Quaternion to, float t); // Constant angular velocity, takes the shortest path
+	static Quaternion Nlerp(Quaternion from, Quaternion to, float t); // Cheaper approximation of slerp, takes the shortest path
+
+	// Matrices are laid out for row vectors so that (vector * matrix) matches RotateVector(vector)
+	DirectX::XMFLOAT3X3 ConvertToRotationMatrix3X3() const;
+	DirectX::XMFLOAT4X4 ConvertToRotationMatrix4X4() const;
+
+	static Quaternion identity;
+
+	float x, y, z, w;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+constexpr Quaternion::Quaternion()
+	: x(0.0f)
+	, y(0.0f)
+	, z(0.0f)
+	, w(1.0f)
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr Quaternion::Quaternion(float x, float y, float z, float w)
+	: x(x)
+	, y(y)
+	, z(z)
+	, w(w)
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+
+template<typename Precision>
+inline Quaternion Quaternion::FromAxisAngle(Vector3D axis, float angle)
+{
+	// Only one sin/cos pair is needed for the whole rotation
+	float sinHalf, cosHalf;
+	PrecisionMaths<Precision>::SinCos(angle * 0.5f, sinHalf, cosHalf);
+
+	return Quaternion(axis.x * sinHalf, axis.y * sinHalf, axis.z * sinHalf, cosHalf);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr Quaternion Quaternion::operator*(const Quaternion& other) const
+{
+	return Quaternion((w * other.x) + (x * other.w) + (y * other.z) - (z * other.y),
+		              (w * other.y) - (x * other.z) + (y * other.w) + (z * other.x),
+		              (w * other.z) + (x * other.y) - (y * other.x) + (z * other.w),
+		              (w * other.w) - (x * other.x) - (y * other.y) - (z * other.z));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr Quaternion& Quaternion::operator*=(const Quaternion& other)
+{
+	*this = *this * other;
+
+	return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr bool     Quaternion::operator==(const Quaternion& other) const
+{
+	return x == other.x && y == other.y && z == other.z && w == other.w;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr float    Quaternion::Dot(const Quaternion& other) const
+{
+	return (x * other.x) + (y * other.y) + (z * other.z) + (w * other.w);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr Quaternion Quaternion::Conjugate() const
+{
+	return Quaternion(-x, -y, -z, w);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline Vector3D    Quaternion::RotateVector(const Vector3D& vector) const
+{
+	// v' = v + w * t + (q.xyz x t), where t = 2 * (q.xyz x v)
+	Vector3D axisPart = Vector3D(x, y, z);
+	Vector3D t        = axisPart.Cross(vector) * 2.0f;
+
+	return vector + (t * w) + axisPart.Cross(t);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline Quaternion  Quaternion::Normalised() const
+{
+	float magnitude = Length();
+
+	return Quaternion(x / magnitude, y / magnitude, z / magnitude, w / magnitude);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline Quaternion& Quaternion::Normalise()
+{
+	float magnitude = Length();
+
+	x /= magnitude;
+	y /= magnitude;
+	z /= magnitude;
+	w /= magnitude;
+
+	return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline float       Quaternion::Length() const
+{
+	return (float)sqrt(LengthSquared());
+}
+
+// ------------------------------------------------------------------------------------------------
+
+constexpr float    Quaternion::LengthSquared() const
+{
+	return ((x * x) + (y * y) + (z * z) + (w * w));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline Quaternion Quaternion::Slerp(Quaternion from, Quaternion to, float t)
+{
+	float cosTheta = from.Dot(to);
+
+	// Take the shortest path around the sphere
+	if (cosTheta < 0.0f)
+	{
+		to       = Quaternion(-to.x, -to.y, -to.z, -to.w);
+		cosTheta = -cosTheta;
+	}
+
+	// When the two are very close together sin(theta) tends to zero, so fall back to a linear blend
+	if (cosTheta > 0.9995f)
+		return Nlerp(from, to, t);
+
+	float theta       = acosf(cosTheta);
+	float sinTheta    = sinf(theta);
+	float fromFactor  = sinf((1.0f - t) * theta) / sinTheta;
+	float toFactor    = sinf(t * theta)          / sinTheta;
+
+	return Quaternion((from.x * fromFactor) + (to.x * toFactor),
+		              (from.y * fromFactor) + (to.y * toFactor),
+		              (from.z * fromFactor) + (to.z * toFactor),
+		              (from.w * fromFactor) + (to.w * toFactor));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline Quaternion Quaternion::Nlerp(Quaternion from, Quaternion to, float t)
+{
+	// Take the shortest path around the sphere
+	float toSign = (from.Dot(to) < 0.0f) ? -1.0f : 1.0f;
+	float fromFactor = 1.0f - t;
+	float toFactor   = t * toSign;
+
+	Quaternion result((from.x * fromFactor) + (to.x * toFactor),
+		              (from.y * fromFactor) + (to.y * toFactor),
+		              (from.z * fromFactor) + (to.z * toFactor),
+		              (from.w * fromFactor) + (to.w * toFactor));
+
+	return result.Normalise();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline DirectX::XMFLOAT3X3 Quaternion::ConvertToRotationMatrix3X3() const
+{
+	float xx = x * x, yy = y * y, zz = z * z;
+	float xy = x * y, xz = x * z, yz = y * z;
+	float wx = w * x, wy = w * y, wz = w * z;
+
+	DirectX::XMFLOAT3X3 returnMatrix = { 1.0f - 2.0f * (yy + zz),   2.0f * (xy + wz),          2.0f * (xz - wy),
+	                                     2.0f * (xy - wz),          1.0f - 2.0f * (xx + zz),   2.0f * (yz + wx),
+	                                     2.0f * (xz + wy),          2.0f * (yz - wx),          1.0f - 2.0f * (xx + yy) };
+
+	return returnMatrix;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+inline DirectX::XMFLOAT4X4 Quaternion::ConvertToRotationMatrix4X4() const
+{
+	DirectX::XMFLOAT3X3 rotation = ConvertToRotationMatrix3X3();
+
+	DirectX::XMFLOAT4X4 returnMatrix = { rotation._11, rotation._12, rotation._13, 0.0f,
+	                                     rotation._21, rotation._22, rotation._23, 0.0f,
+	                                     rotation._31, rotation._32, rotation._33, 0.0f,
+	                                     0.0f,         0.0f,         0.0f,         1.0f };
+
+	return returnMatrix;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
 struct MatrixMaths
 {
 public:
@@ -184,11 +451,13 @@ public:
 
 	// ---------------------------------------------------------------------------------------------------------
 
+	template<typename Precision = ExactPrecision>
 	static DirectX::XMFLOAT3X3 AxisRotationMatrix(Vector3D axis, float angle)
 	{
 		// Pre-calculate values that can be expensive
-		float cosAngle    = cosf(angle);
-		float sinAngle    = sinf(angle);
+		float cosAngle, sinAngle;
+		PrecisionMaths<Precision>::SinCos(angle, sinAngle, cosAngle);
+
 		float oneMinusCos = 1.0f - cosAngle;
 
 		// Calculate the Rodrigues rotation matrix
@@ -202,33 +471,45 @@ public:
 
 	// ---------------------------------------------------------------------------------------------------------
 
+	template<typename Precision = ExactPrecision>
 	static DirectX::XMFLOAT3X3 GetXAxisRotationMatrix(float angle)
 	{
-		DirectX::XMFLOAT3X3 rotationMatrix = { 1.0f,  0.0f,          0.0f,
-		                                       0.0f,  cosf(angle),  -sinf(angle),
-		                                       0.0f,  sinf(angle),   cosf(angle)};
+		float cosAngle, sinAngle;
+		PrecisionMaths<Precision>::SinCos(angle, sinAngle, cosAngle);
+
+		DirectX::XMFLOAT3X3 rotationMatrix = { 1.0f,  0.0f,       0.0f,
+		                                       0.0f,  cosAngle,  -sinAngle,
+		                                       0.0f,  sinAngle,   cosAngle};
 
 		return rotationMatrix;
 	}
 
 	// ---------------------------------------------------------------------------------------------------------
 
+	template<typename Precision = ExactPrecision>
 	static DirectX::XMFLOAT3X3 GetYAxisRotationMatrix(float angle)
 	{
-		DirectX::XMFLOAT3X3 rotationMatrix = { cosf(angle),  0.0f,  sinf(angle),
-											   0.0f,         1.0f,  0.0f,
-											  -sinf(angle),  0.0f,  cosf(angle) };
+		float cosAngle, sinAngle;
+		PrecisionMaths<Precision>::SinCos(angle, sinAngle, cosAngle);
+
+		DirectX::XMFLOAT3X3 rotationMatrix = { cosAngle,  0.0f,  sinAngle,
+											   0.0f,      1.0f,  0.0f,
+											  -sinAngle,  0.0f,  cosAngle };
 
 		return rotationMatrix;
 	}
 
 	// ---------------------------------------------------------------------------------------------------------
 
+	template<typename Precision = ExactPrecision>
 	static DirectX::XMFLOAT3X3 GetZAxisRotationMatrix(float angle)
 	{
-		DirectX::XMFLOAT3X3 rotationMatrix = { cosf(angle),  -sinf(angle),  0.0f,
-											   sinf(angle),   cosf(angle),  0.0f,
-											   0.0f,          0.0f,         1.0f};
+		float cosAngle, sinAngle;
+		PrecisionMaths<Precision>::SinCos(angle, sinAngle, cosAngle);
+
+		DirectX::XMFLOAT3X3 rotationMatrix = { cosAngle,  -sinAngle,  0.0f,
+											   sinAngle,   cosAngle,  0.0f,
+											   0.0f,       0.0f,      1.0f};
 
 		return rotationMatrix;
 	}
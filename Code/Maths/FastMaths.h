@@ -0,0 +1,81 @@
+#ifndef _FAST_MATHS_H_
+#define _FAST_MATHS_H_
+
+#include <math.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+// Precision policies - passed as a template parameter to the maths functions that support them so that hot loops can opt
+// into the cheaper approximations while everything else keeps the exact results.
+//
+// ExactPrecision : sinf/cosf.
+// FastPrecision  : Minimax polynomial sin/cos - max absolute error 5.4e-6 (sin) and 1.5e-5 (cos). Angles outside +-100 radians
+//                  (and NaNs) fall back to sinf/cosf, as the range reduction loses accuracy past there.
+//
+// There is no fast reciprocal square root - an rsqrtss estimate plus the Newton-Raphson step it needs measured slower than sqrtss
+// and a divide, so the vectors always normalise exactly.
+
+struct ExactPrecision final {};
+struct FastPrecision  final {};
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+template<typename Precision>
+struct PrecisionMaths;
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+template<>
+struct PrecisionMaths<ExactPrecision> final
+{
+public:
+	static void SinCos(float angle, float& sinOut, float& cosOut)
+	{
+		sinOut = sinf(angle);
+		cosOut = cosf(angle);
+	}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+template<>
+struct PrecisionMaths<FastPrecision> final
+{
+public:
+	static void SinCos(float angle, float& sinOut, float& cosOut)
+	{
+		// Written so that a NaN takes this path too - it would otherwise reach the int conversion below, which is undefined for it
+		// just as it is for an angle too large to fit
+		if (!(fabsf(angle) <= kMaxPolynomialAngle))
+		{
+			PrecisionMaths<ExactPrecision>::SinCos(angle, sinOut, cosOut);
+			return;
+		}
+
+		// Wrap the angle into [-pi, pi]
+		float quotient = angle * 0.1591549431f; // 1 / 2pi
+		      quotient = (float)((int)(quotient + ((angle >= 0.0f) ? 0.5f : -0.5f)));
+
+		float y = angle - (6.283185307f * quotient);
+
+		// Then fold it into [-pi/2, pi/2], where sin is unchanged and cos flips sign. Written as selects rather than
+		// branches as the angles in a batch are rarely predictable
+		bool  outsideHalfPi = fabsf(y) > 1.570796327f;
+		float folded        = (y > 0.0f ? 3.141592654f : -3.141592654f) - y;
+		float cosSign       = outsideHalfPi ? -1.0f   : 1.0f;
+		      y             = outsideHalfPi ? folded  : y;
+
+		float y2 = y * y;
+
+		// 7th degree polynomial for sin, 6th degree for cos
+		sinOut =            (((-0.00018524670f * y2 + 0.0083139502f) * y2 - 0.16665852f) * y2 + 1.0f) * y;
+		cosOut = cosSign *  (((-0.0012712436f  * y2 + 0.041493919f)  * y2 - 0.49992746f) * y2 + 1.0f);
+	}
+
+private:
+	static constexpr float kMaxPolynomialAngle = 100.0f; // Radians - the error bounds above hold within this
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+#endif
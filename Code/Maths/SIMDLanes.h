@@ -0,0 +1,69 @@
+#ifndef _SIMD_LANES_H_
+#define _SIMD_LANES_H_
+
+// Thin wrappers over the widest float SIMD register the compiler is building for, so the batch kernels can be written once.
+// SIMD_LANES_ENABLED is left undefined when there is no SIMD support and the kernels fall back to their scalar loops.
+
+#if defined(__AVX__)
+	#define SIMD_LANES_AVX
+	#include <immintrin.h>
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+	#define SIMD_LANES_SSE
+	#include <xmmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+#if defined(SIMD_LANES_AVX)
+
+	typedef __m256 Lane;
+	const unsigned int kLaneWidth = 8;
+
+	inline Lane LaneLoad(const float* source)         { return _mm256_loadu_ps(source); }
+	inline void LaneStore(float* dest, Lane value)    { _mm256_storeu_ps(dest, value); }
+	inline Lane LaneSet(float value)                  { return _mm256_set1_ps(value); }
+	inline Lane LaneAdd(Lane a, Lane b)               { return _mm256_add_ps(a, b); }
+	inline Lane LaneSub(Lane a, Lane b)               { return _mm256_sub_ps(a, b); }
+	inline Lane LaneMul(Lane a, Lane b)               { return _mm256_mul_ps(a, b); }
+	inline Lane LaneDiv(Lane a, Lane b)               { return _mm256_div_ps(a, b); }
+	inline Lane LaneMin(Lane a, Lane b)               { return _mm256_min_ps(a, b); }
+	inline Lane LaneMax(Lane a, Lane b)               { return _mm256_max_ps(a, b); }
+	inline Lane LaneSqrt(Lane a)                      { return _mm256_sqrt_ps(a); }
+	inline Lane LaneAbs(Lane a)                       { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	inline Lane LaneLess(Lane a, Lane b)              { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); } // All bits set where a < b
+	inline Lane LaneOr(Lane a, Lane b)                { return _mm256_or_ps(a, b); }
+	inline Lane LaneAnd(Lane a, Lane b)               { return _mm256_and_ps(a, b); }
+	inline Lane LaneSelect(Lane mask, Lane a, Lane b) { return _mm256_blendv_ps(b, a, mask); }    // a where mask is set, otherwise b
+	inline unsigned int LaneMoveMask(Lane mask)       { return (unsigned int)_mm256_movemask_ps(mask); } // One bit per lane
+
+	#define SIMD_LANES_ENABLED
+
+#elif defined(SIMD_LANES_SSE)
+
+	typedef __m128 Lane;
+	const unsigned int kLaneWidth = 4;
+
+	inline Lane LaneLoad(const float* source)         { return _mm_loadu_ps(source); }
+	inline void LaneStore(float* dest, Lane value)    { _mm_storeu_ps(dest, value); }
+	inline Lane LaneSet(float value)                  { return _mm_set1_ps(value); }
+	inline Lane LaneAdd(Lane a, Lane b)               { return _mm_add_ps(a, b); }
+	inline Lane LaneSub(Lane a, Lane b)               { return _mm_sub_ps(a, b); }
+	inline Lane LaneMul(Lane a, Lane b)               { return _mm_mul_ps(a, b); }
+	inline Lane LaneDiv(Lane a, Lane b)               { return _mm_div_ps(a, b); }
+	inline Lane LaneMin(Lane a, Lane b)               { return _mm_min_ps(a, b); }
+	inline Lane LaneMax(Lane a, Lane b)               { return _mm_max_ps(a, b); }
+	inline Lane LaneSqrt(Lane a)                      { return _mm_sqrt_ps(a); }
+	inline Lane LaneAbs(Lane a)                       { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	inline Lane LaneLess(Lane a, Lane b)              { return _mm_cmplt_ps(a, b); }
+	inline Lane LaneOr(Lane a, Lane b)                { return _mm_or_ps(a, b); }
+	inline Lane LaneAnd(Lane a, Lane b)               { return _mm_and_ps(a, b); }
+	inline Lane LaneSelect(Lane mask, Lane a, Lane b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	inline unsigned int LaneMoveMask(Lane mask)       { return (unsigned int)_mm_movemask_ps(mask); }
+
+	#define SIMD_LANES_ENABLED
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+#endif
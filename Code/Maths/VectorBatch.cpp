@@ -0,0 +1,715 @@
+#include "VectorBatch.h"
+
+#include <algorithm>
+#include <math.h>
+
+#include "SIMDLanes.h"
+
+// ===============================================================================================//
+//------------------------------------------ Vector3Batch ----------------------------------------//
+// ===============================================================================================//
+
+Vector3Batch::Vector3Batch()
+	: x()
+	, y()
+	, z()
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Vector3Batch::Vector3Batch(unsigned int count)
+	: x(count, 0.0f)
+	, y(count, 0.0f)
+	, z(count, 0.0f)
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Vector3Batch::Vector3Batch(const Vector3D* vectors, unsigned int count)
+	: x()
+	, y()
+	, z()
+{
+	LoadFrom(vectors, count);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Resize(unsigned int count)
+{
+	x.resize(count, 0.0f);
+	y.resize(count, 0.0f);
+	z.resize(count, 0.0f);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Reserve(unsigned int count)
+{
+	x.reserve(count);
+	y.reserve(count);
+	z.reserve(count);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Clear()
+{
+	x.clear();
+	y.clear();
+	z.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::PushBack(const Vector3D& vector)
+{
+	x.push_back(vector.x);
+	y.push_back(vector.y);
+	z.push_back(vector.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Set(unsigned int index, const Vector3D& vector)
+{
+	x[index] = vector.x;
+	y[index] = vector.y;
+	z[index] = vector.z;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Vector3D Vector3Batch::Get(unsigned int index) const
+{
+	return Vector3D(x[index], y[index], z[index]);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::LoadFrom(const Vector3D* vectors, unsigned int count)
+{
+	Resize(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		x[i] = vectors[i].x;
+		y[i] = vectors[i].y;
+		z[i] = vectors[i].z;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::StoreTo(Vector3D* vectors) const
+{
+	unsigned int count = Count();
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		vectors[i].x = x[i];
+		vectors[i].y = y[i];
+		vectors[i].z = z[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Add(const Vector3Batch& a, const Vector3Batch& b, Vector3Batch& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		LaneStore(&out.x[i], LaneAdd(LaneLoad(&a.x[i]), LaneLoad(&b.x[i])));
+		LaneStore(&out.y[i], LaneAdd(LaneLoad(&a.y[i]), LaneLoad(&b.y[i])));
+		LaneStore(&out.z[i], LaneAdd(LaneLoad(&a.z[i]), LaneLoad(&b.z[i])));
+	}
+#endif
+
+	// Anything left over that does not fill a whole lane
+	for (; i < count; i++)
+	{
+		out.x[i] = a.x[i] + b.x[i];
+		out.y[i] = a.y[i] + b.y[i];
+		out.z[i] = a.z[i] + b.z[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Subtract(const Vector3Batch& a, const Vector3Batch& b, Vector3Batch& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		LaneStore(&out.x[i], LaneSub(LaneLoad(&a.x[i]), LaneLoad(&b.x[i])));
+		LaneStore(&out.y[i], LaneSub(LaneLoad(&a.y[i]), LaneLoad(&b.y[i])));
+		LaneStore(&out.z[i], LaneSub(LaneLoad(&a.z[i]), LaneLoad(&b.z[i])));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out.x[i] = a.x[i] - b.x[i];
+		out.y[i] = a.y[i] - b.y[i];
+		out.z[i] = a.z[i] - b.z[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Scale(const Vector3Batch& a, float factor, Vector3Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane factorLane = LaneSet(factor);
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		LaneStore(&out.x[i], LaneMul(LaneLoad(&a.x[i]), factorLane));
+		LaneStore(&out.y[i], LaneMul(LaneLoad(&a.y[i]), factorLane));
+		LaneStore(&out.z[i], LaneMul(LaneLoad(&a.z[i]), factorLane));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out.x[i] = a.x[i] * factor;
+		out.y[i] = a.y[i] * factor;
+		out.z[i] = a.z[i] * factor;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Cross(const Vector3Batch& a, const Vector3Batch& b, Vector3Batch& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]);
+		Lane bx = LaneLoad(&b.x[i]), by = LaneLoad(&b.y[i]), bz = LaneLoad(&b.z[i]);
+
+		LaneStore(&out.x[i], LaneSub(LaneMul(ay, bz), LaneMul(az, by)));
+		LaneStore(&out.y[i], LaneSub(LaneMul(az, bx), LaneMul(ax, bz)));
+		LaneStore(&out.z[i], LaneSub(LaneMul(ax, by), LaneMul(ay, bx)));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		// Take copies as out is allowed to alias a or b
+		float ax = a.x[i], ay = a.y[i], az = a.z[i];
+		float bx = b.x[i], by = b.y[i], bz = b.z[i];
+
+		out.x[i] = (ay * bz) - (az * by);
+		out.y[i] = (az * bx) - (ax * bz);
+		out.z[i] = (ax * by) - (ay * bx);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Normalise(const Vector3Batch& a, Vector3Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]);
+
+		Lane magnitude = LaneSqrt(LaneAdd(LaneAdd(LaneMul(ax, ax), LaneMul(ay, ay)), LaneMul(az, az)));
+
+		LaneStore(&out.x[i], LaneDiv(ax, magnitude));
+		LaneStore(&out.y[i], LaneDiv(ay, magnitude));
+		LaneStore(&out.z[i], LaneDiv(az, magnitude));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float magnitude = (float)sqrt((a.x[i] * a.x[i]) + (a.y[i] * a.y[i]) + (a.z[i] * a.z[i]));
+
+		out.x[i] = a.x[i] / magnitude;
+		out.y[i] = a.y[i] / magnitude;
+		out.z[i] = a.z[i] / magnitude;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Dot(const Vector3Batch& a, const Vector3Batch& b, std::vector<float>& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	unsigned int i     = 0;
+
+	out.resize(count);
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane result = LaneMul(LaneLoad(&a.x[i]), LaneLoad(&b.x[i]));
+		     result = LaneAdd(result, LaneMul(LaneLoad(&a.y[i]), LaneLoad(&b.y[i])));
+		     result = LaneAdd(result, LaneMul(LaneLoad(&a.z[i]), LaneLoad(&b.z[i])));
+
+		LaneStore(&out[i], result);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Length(const Vector3Batch& a, std::vector<float>& out)
+{
+	unsigned int count = a.Count();
+	unsigned int i     = 0;
+
+	out.resize(count);
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]);
+
+		LaneStore(&out[i], LaneSqrt(LaneAdd(LaneAdd(LaneMul(ax, ax), LaneMul(ay, ay)), LaneMul(az, az))));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out[i] = (float)sqrt((a.x[i] * a.x[i]) + (a.y[i] * a.y[i]) + (a.z[i] * a.z[i]));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::Transform(const Vector3Batch& a, const DirectX::XMFLOAT3X3& matrix, Vector3Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane m11 = LaneSet(matrix._11), m12 = LaneSet(matrix._12), m13 = LaneSet(matrix._13);
+	Lane m21 = LaneSet(matrix._21), m22 = LaneSet(matrix._22), m23 = LaneSet(matrix._23);
+	Lane m31 = LaneSet(matrix._31), m32 = LaneSet(matrix._32), m33 = LaneSet(matrix._33);
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]);
+
+		LaneStore(&out.x[i], LaneAdd(LaneAdd(LaneMul(ax, m11), LaneMul(ay, m21)), LaneMul(az, m31)));
+		LaneStore(&out.y[i], LaneAdd(LaneAdd(LaneMul(ax, m12), LaneMul(ay, m22)), LaneMul(az, m32)));
+		LaneStore(&out.z[i], LaneAdd(LaneAdd(LaneMul(ax, m13), LaneMul(ay, m23)), LaneMul(az, m33)));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float ax = a.x[i], ay = a.y[i], az = a.z[i];
+
+		out.x[i] = (ax * matrix._11) + (ay * matrix._21) + (az * matrix._31);
+		out.y[i] = (ax * matrix._12) + (ay * matrix._22) + (az * matrix._32);
+		out.z[i] = (ax * matrix._13) + (ay * matrix._23) + (az * matrix._33);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector3Batch::TransformPoint(const Vector3Batch& a, const DirectX::XMFLOAT4X4& matrix, Vector3Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane m11 = LaneSet(matrix._11), m12 = LaneSet(matrix._12), m13 = LaneSet(matrix._13);
+	Lane m21 = LaneSet(matrix._21), m22 = LaneSet(matrix._22), m23 = LaneSet(matrix._23);
+	Lane m31 = LaneSet(matrix._31), m32 = LaneSet(matrix._32), m33 = LaneSet(matrix._33);
+	Lane m41 = LaneSet(matrix._41), m42 = LaneSet(matrix._42), m43 = LaneSet(matrix._43);
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]);
+
+		LaneStore(&out.x[i], LaneAdd(LaneAdd(LaneAdd(LaneMul(ax, m11), LaneMul(ay, m21)), LaneMul(az, m31)), m41));
+		LaneStore(&out.y[i], LaneAdd(LaneAdd(LaneAdd(LaneMul(ax, m12), LaneMul(ay, m22)), LaneMul(az, m32)), m42));
+		LaneStore(&out.z[i], LaneAdd(LaneAdd(LaneAdd(LaneMul(ax, m13), LaneMul(ay, m23)), LaneMul(az, m33)), m43));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float ax = a.x[i], ay = a.y[i], az = a.z[i];
+
+		out.x[i] = (ax * matrix._11) + (ay * matrix._21) + (az * matrix._31) + matrix._41;
+		out.y[i] = (ax * matrix._12) + (ay * matrix._22) + (az * matrix._32) + matrix._42;
+		out.z[i] = (ax * matrix._13) + (ay * matrix._23) + (az * matrix._33) + matrix._43;
+	}
+}
+
+// ===============================================================================================//
+//------------------------------------------ Vector4Batch ----------------------------------------//
+// ===============================================================================================//
+
+Vector4Batch::Vector4Batch()
+	: x()
+	, y()
+	, z()
+	, w()
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Vector4Batch::Vector4Batch(unsigned int count)
+	: x(count, 0.0f)
+	, y(count, 0.0f)
+	, z(count, 0.0f)
+	, w(count, 0.0f)
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Vector4Batch::Vector4Batch(const Vector4D* vectors, unsigned int count)
+	: x()
+	, y()
+	, z()
+	, w()
+{
+	LoadFrom(vectors, count);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Resize(unsigned int count)
+{
+	x.resize(count, 0.0f);
+	y.resize(count, 0.0f);
+	z.resize(count, 0.0f);
+	w.resize(count, 0.0f);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Reserve(unsigned int count)
+{
+	x.reserve(count);
+	y.reserve(count);
+	z.reserve(count);
+	w.reserve(count);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Clear()
+{
+	x.clear();
+	y.clear();
+	z.clear();
+	w.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::PushBack(const Vector4D& vector)
+{
+	x.push_back(vector.x);
+	y.push_back(vector.y);
+	z.push_back(vector.z);
+	w.push_back(vector.w);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Set(unsigned int index, const Vector4D& vector)
+{
+	x[index] = vector.x;
+	y[index] = vector.y;
+	z[index] = vector.z;
+	w[index] = vector.w;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+Vector4D Vector4Batch::Get(unsigned int index) const
+{
+	return Vector4D(x[index], y[index], z[index], w[index]);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::LoadFrom(const Vector4D* vectors, unsigned int count)
+{
+	Resize(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		x[i] = vectors[i].x;
+		y[i] = vectors[i].y;
+		z[i] = vectors[i].z;
+		w[i] = vectors[i].w;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::StoreTo(Vector4D* vectors) const
+{
+	unsigned int count = Count();
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		vectors[i].x = x[i];
+		vectors[i].y = y[i];
+		vectors[i].z = z[i];
+		vectors[i].w = w[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Add(const Vector4Batch& a, const Vector4Batch& b, Vector4Batch& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		LaneStore(&out.x[i], LaneAdd(LaneLoad(&a.x[i]), LaneLoad(&b.x[i])));
+		LaneStore(&out.y[i], LaneAdd(LaneLoad(&a.y[i]), LaneLoad(&b.y[i])));
+		LaneStore(&out.z[i], LaneAdd(LaneLoad(&a.z[i]), LaneLoad(&b.z[i])));
+		LaneStore(&out.w[i], LaneAdd(LaneLoad(&a.w[i]), LaneLoad(&b.w[i])));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out.x[i] = a.x[i] + b.x[i];
+		out.y[i] = a.y[i] + b.y[i];
+		out.z[i] = a.z[i] + b.z[i];
+		out.w[i] = a.w[i] + b.w[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Subtract(const Vector4Batch& a, const Vector4Batch& b, Vector4Batch& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		LaneStore(&out.x[i], LaneSub(LaneLoad(&a.x[i]), LaneLoad(&b.x[i])));
+		LaneStore(&out.y[i], LaneSub(LaneLoad(&a.y[i]), LaneLoad(&b.y[i])));
+		LaneStore(&out.z[i], LaneSub(LaneLoad(&a.z[i]), LaneLoad(&b.z[i])));
+		LaneStore(&out.w[i], LaneSub(LaneLoad(&a.w[i]), LaneLoad(&b.w[i])));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out.x[i] = a.x[i] - b.x[i];
+		out.y[i] = a.y[i] - b.y[i];
+		out.z[i] = a.z[i] - b.z[i];
+		out.w[i] = a.w[i] - b.w[i];
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Scale(const Vector4Batch& a, float factor, Vector4Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane factorLane = LaneSet(factor);
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		LaneStore(&out.x[i], LaneMul(LaneLoad(&a.x[i]), factorLane));
+		LaneStore(&out.y[i], LaneMul(LaneLoad(&a.y[i]), factorLane));
+		LaneStore(&out.z[i], LaneMul(LaneLoad(&a.z[i]), factorLane));
+		LaneStore(&out.w[i], LaneMul(LaneLoad(&a.w[i]), factorLane));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out.x[i] = a.x[i] * factor;
+		out.y[i] = a.y[i] * factor;
+		out.z[i] = a.z[i] * factor;
+		out.w[i] = a.w[i] * factor;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Normalise(const Vector4Batch& a, Vector4Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]), aw = LaneLoad(&a.w[i]);
+
+		Lane magnitude = LaneSqrt(LaneAdd(LaneAdd(LaneMul(ax, ax), LaneMul(ay, ay)), LaneAdd(LaneMul(az, az), LaneMul(aw, aw))));
+
+		LaneStore(&out.x[i], LaneDiv(ax, magnitude));
+		LaneStore(&out.y[i], LaneDiv(ay, magnitude));
+		LaneStore(&out.z[i], LaneDiv(az, magnitude));
+		LaneStore(&out.w[i], LaneDiv(aw, magnitude));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float magnitude = (float)sqrt((a.x[i] * a.x[i]) + (a.y[i] * a.y[i]) + (a.z[i] * a.z[i]) + (a.w[i] * a.w[i]));
+
+		out.x[i] = a.x[i] / magnitude;
+		out.y[i] = a.y[i] / magnitude;
+		out.z[i] = a.z[i] / magnitude;
+		out.w[i] = a.w[i] / magnitude;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Dot(const Vector4Batch& a, const Vector4Batch& b, std::vector<float>& out)
+{
+	unsigned int count = std::min(a.Count(), b.Count());
+	unsigned int i     = 0;
+
+	out.resize(count);
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane result = LaneMul(LaneLoad(&a.x[i]), LaneLoad(&b.x[i]));
+		     result = LaneAdd(result, LaneMul(LaneLoad(&a.y[i]), LaneLoad(&b.y[i])));
+		     result = LaneAdd(result, LaneMul(LaneLoad(&a.z[i]), LaneLoad(&b.z[i])));
+		     result = LaneAdd(result, LaneMul(LaneLoad(&a.w[i]), LaneLoad(&b.w[i])));
+
+		LaneStore(&out[i], result);
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out[i] = (a.x[i] * b.x[i]) + (a.y[i] * b.y[i]) + (a.z[i] * b.z[i]) + (a.w[i] * b.w[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Length(const Vector4Batch& a, std::vector<float>& out)
+{
+	unsigned int count = a.Count();
+	unsigned int i     = 0;
+
+	out.resize(count);
+
+#if defined(SIMD_LANES_ENABLED)
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]), aw = LaneLoad(&a.w[i]);
+
+		LaneStore(&out[i], LaneSqrt(LaneAdd(LaneAdd(LaneMul(ax, ax), LaneMul(ay, ay)), LaneAdd(LaneMul(az, az), LaneMul(aw, aw)))));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		out[i] = (float)sqrt((a.x[i] * a.x[i]) + (a.y[i] * a.y[i]) + (a.z[i] * a.z[i]) + (a.w[i] * a.w[i]));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Vector4Batch::Transform(const Vector4Batch& a, const DirectX::XMFLOAT4X4& matrix, Vector4Batch& out)
+{
+	unsigned int count = a.Count();
+	out.Resize(count);
+
+	unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+	Lane m11 = LaneSet(matrix._11), m12 = LaneSet(matrix._12), m13 = LaneSet(matrix._13), m14 = LaneSet(matrix._14);
+	Lane m21 = LaneSet(matrix._21), m22 = LaneSet(matrix._22), m23 = LaneSet(matrix._23), m24 = LaneSet(matrix._24);
+	Lane m31 = LaneSet(matrix._31), m32 = LaneSet(matrix._32), m33 = LaneSet(matrix._33), m34 = LaneSet(matrix._34);
+	Lane m41 = LaneSet(matrix._41), m42 = LaneSet(matrix._42), m43 = LaneSet(matrix._43), m44 = LaneSet(matrix._44);
+
+	for (; i + kLaneWidth <= count; i += kLaneWidth)
+	{
+		Lane ax = LaneLoad(&a.x[i]), ay = LaneLoad(&a.y[i]), az = LaneLoad(&a.z[i]), aw = LaneLoad(&a.w[i]);
+
+		LaneStore(&out.x[i], LaneAdd(LaneAdd(LaneMul(ax, m11), LaneMul(ay, m21)), LaneAdd(LaneMul(az, m31), LaneMul(aw, m41))));
+		LaneStore(&out.y[i], LaneAdd(LaneAdd(LaneMul(ax, m12), LaneMul(ay, m22)), LaneAdd(LaneMul(az, m32), LaneMul(aw, m42))));
+		LaneStore(&out.z[i], LaneAdd(LaneAdd(LaneMul(ax, m13), LaneMul(ay, m23)), LaneAdd(LaneMul(az, m33), LaneMul(aw, m43))));
+		LaneStore(&out.w[i], LaneAdd(LaneAdd(LaneMul(ax, m14), LaneMul(ay, m24)), LaneAdd(LaneMul(az, m34), LaneMul(aw, m44))));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float ax = a.x[i], ay = a.y[i], az = a.z[i], aw = a.w[i];
+
+		out.x[i] = (ax * matrix._11) + (ay * matrix._21) + (az * matrix._31) + (aw * matrix._41);
+		out.y[i] = (ax * matrix._12) + (ay * matrix._22) + (az * matrix._32) + (aw * matrix._42);
+		out.z[i] = (ax * matrix._13) + (ay * matrix._23) + (az * matrix._33) + (aw * matrix._43);
+		out.w[i] = (ax * matrix._14) + (ay * matrix._24) + (az * matrix._34) + (aw * matrix._44);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
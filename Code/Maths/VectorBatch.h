@@ -0,0 +1,91 @@
+#ifndef _VECTOR_BATCH_H_
+#define _VECTOR_BATCH_H_
+
+#include <vector>
+
+#include "CommonMaths.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+// Structure-of-arrays containers for running the same vector operation over a large number of vectors at once.
+// The kernels use AVX when the compiler is targeting it, SSE on any x86/x64 build, and a scalar loop everywhere else.
+// All kernels resize their output to match the input, and the output is allowed to be one of the inputs. Kernels taking two batches
+// only run over as many vectors as the shorter of the two holds.
+
+struct Vector3Batch final
+{
+public:
+	Vector3Batch();
+	explicit Vector3Batch(unsigned int count);
+	Vector3Batch(const Vector3D* vectors, unsigned int count);
+
+	//------------------------ Interop with Vector3D ------------------------//
+	void         Resize(unsigned int count);
+	void         Reserve(unsigned int count);
+	void         Clear();
+
+	void         PushBack(const Vector3D& vector);
+	void         Set(unsigned int index, const Vector3D& vector);
+	Vector3D     Get(unsigned int index) const;
+
+	void         LoadFrom(const Vector3D* vectors, unsigned int count); // Converts from array-of-structures into this batch
+	void         StoreTo(Vector3D* vectors) const;                      // Writes Count() vectors back out as array-of-structures
+
+	unsigned int Count() const { return (unsigned int)x.size(); }
+
+	//------------------------ Batch kernels ------------------------//
+	static void Add(      const Vector3Batch& a, const Vector3Batch& b, Vector3Batch& out);
+	static void Subtract( const Vector3Batch& a, const Vector3Batch& b, Vector3Batch& out);
+	static void Scale(    const Vector3Batch& a, float factor,          Vector3Batch& out);
+	static void Cross(    const Vector3Batch& a, const Vector3Batch& b, Vector3Batch& out);
+	static void Normalise(const Vector3Batch& a,                        Vector3Batch& out);
+
+	static void Dot(      const Vector3Batch& a, const Vector3Batch& b, std::vector<float>& out);
+	static void Length(   const Vector3Batch& a,                        std::vector<float>& out);
+
+	static void Transform(     const Vector3Batch& a, const DirectX::XMFLOAT3X3& matrix, Vector3Batch& out); // Same convention as Vector3D * XMFLOAT3X3
+	static void TransformPoint(const Vector3Batch& a, const DirectX::XMFLOAT4X4& matrix, Vector3Batch& out); // Treats each vector as (x, y, z, 1) and drops w
+
+	std::vector<float> x, y, z;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+struct Vector4Batch final
+{
+public:
+	Vector4Batch();
+	explicit Vector4Batch(unsigned int count);
+	Vector4Batch(const Vector4D* vectors, unsigned int count);
+
+	//------------------------ Interop with Vector4D ------------------------//
+	void         Resize(unsigned int count);
+	void         Reserve(unsigned int count);
+	void         Clear();
+
+	void         PushBack(const Vector4D& vector);
+	void         Set(unsigned int index, const Vector4D& vector);
+	Vector4D     Get(unsigned int index) const;
+
+	void         LoadFrom(const Vector4D* vectors, unsigned int count);
+	void         StoreTo(Vector4D* vectors) const;
+
+	unsigned int Count() const { return (unsigned int)x.size(); }
+
+	//------------------------ Batch kernels ------------------------//
+	static void Add(      const Vector4Batch& a, const Vector4Batch& b, Vector4Batch& out);
+	static void Subtract( const Vector4Batch& a, const Vector4Batch& b, Vector4Batch& out);
+	static void Scale(    const Vector4Batch& a, float factor,          Vector4Batch& out);
+	static void Normalise(const Vector4Batch& a,                        Vector4Batch& out);
+
+	static void Dot(      const Vector4Batch& a, const Vector4Batch& b, std::vector<float>& out);
+	static void Length(   const Vector4Batch& a,                        std::vector<float>& out);
+
+	static void Transform(const Vector4Batch& a, const DirectX::XMFLOAT4X4& matrix, Vector4Batch& out); // Row-vector * matrix, as DirectX does
+
+	std::vector<float> x, y, z, w;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------- //
+
+#endif
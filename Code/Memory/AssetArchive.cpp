@@ -0,0 +1,326 @@
+#include "AssetArchive.h"
+
+#include <algorithm>
+#include <string.h>
+
+#include "FileUtils.h"
+#include "LZ4.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const char               kAssetArchiveMagic[4] = { 'T', 'K', 'P', 'K' };
+
+	// No LZ4 block expands by more than this, so a bigger claimed size is corrupt - and would otherwise allocate whatever it asked for
+	const unsigned long long kLZ4MaxRatio          = 255;
+
+	// Orders entries the way Find() searches them
+	int CompareEntry(unsigned long long hashA, const char* nameA, size_t lengthA, unsigned long long hashB, const char* nameB, size_t lengthB)
+	{
+		if (hashA != hashB)
+			return hashA < hashB ? -1 : 1;
+
+		int compared = memcmp(nameA, nameB, std::min(lengthA, lengthB));
+
+		if (compared != 0)
+			return compared;
+
+		return lengthA == lengthB ? 0 : (lengthA < lengthB ? -1 : 1);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+AssetArchive::AssetArchive()
+	: mFile()
+	, mHeader(nullptr)
+	, mEntries(nullptr)
+	, mNames(nullptr)
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+AssetArchive::~AssetArchive()
+{
+	Close();
+}
+
+// -------------------------------------------------------------------- //
+
+bool AssetArchive::Open(const std::string& filePath)
+{
+	Close();
+
+	if (!mFile.Open(filePath) || mFile.GetSize() < sizeof(AssetArchiveHeader))
+	{
+		mFile.Close();
+		return false;
+	}
+
+	const AssetArchiveHeader* header   = (const AssetArchiveHeader*)mFile.GetData();
+	unsigned long long        fileSize = mFile.GetSize();
+	unsigned long long        tocBytes = (unsigned long long)header->entryCount * sizeof(AssetArchiveEntry);
+
+	if (memcmp(header->magic, kAssetArchiveMagic, sizeof(kAssetArchiveMagic)) != 0
+	 || header->version     != kAssetArchiveVersion
+	 || header->headerSize  != sizeof(AssetArchiveHeader)
+	 || header->entryStride != sizeof(AssetArchiveEntry)
+	 || header->fileSize    != fileSize
+	 || !FileUtils::GetIsRangeInBlock(header->entriesOffset, tocBytes,          alignof(AssetArchiveEntry), sizeof(AssetArchiveHeader), fileSize)
+	 || !FileUtils::GetIsRangeInBlock(header->namesOffset,   header->namesSize, 1,                          sizeof(AssetArchiveHeader), fileSize))
+	{
+		mFile.Close();
+		return false;
+	}
+
+	const AssetArchiveEntry* entries = (const AssetArchiveEntry*)(mFile.GetData() + header->entriesOffset);
+	const char*              names   = mFile.GetData() + header->namesOffset;
+
+	for (unsigned int i = 0; i < header->entryCount; i++)
+	{
+		const AssetArchiveEntry& entry = entries[i];
+
+		bool valid = entry.nameOffset <= header->namesSize && entry.nameLength <= header->namesSize - entry.nameOffset
+		          && FileUtils::GetIsRangeInBlock(entry.dataOffset, entry.storedSize, kAssetArchiveAlignment, sizeof(AssetArchiveHeader), fileSize)
+		          && ((entry.compression == AssetCompression::LZ4  && entry.size / kLZ4MaxRatio <= entry.storedSize)
+		           || (entry.compression == AssetCompression::NONE && entry.size == entry.storedSize))
+		          && entry.nameHash == HashName(names + entry.nameOffset, entry.nameLength);
+
+		// Find() relies on the order, so an archive out of order is as broken as one with bad offsets
+		if (valid && i > 0)
+		{
+			const AssetArchiveEntry& previous = entries[i - 1];
+
+			valid = CompareEntry(previous.nameHash, names + previous.nameOffset, previous.nameLength, entry.nameHash, names + entry.nameOffset, entry.nameLength) < 0;
+		}
+
+		if (!valid)
+		{
+			mFile.Close();
+			return false;
+		}
+	}
+
+	mHeader  = header;
+	mEntries = entries;
+	mNames   = names;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void AssetArchive::Close()
+{
+	mFile.Close();
+
+	mHeader  = nullptr;
+	mEntries = nullptr;
+	mNames   = nullptr;
+}
+
+// -------------------------------------------------------------------- //
+
+std::string AssetArchive::GetEntryName(const AssetArchiveEntry& entry) const
+{
+	return std::string(mNames + entry.nameOffset, entry.nameLength);
+}
+
+// -------------------------------------------------------------------- //
+
+const AssetArchiveEntry* AssetArchive::Find(const std::string& name) const
+{
+	if (!mHeader)
+		return nullptr;
+
+	unsigned long long hash  = HashName(name.data(), name.size());
+	unsigned int       first = 0;
+	unsigned int       last  = mHeader->entryCount;
+
+	while (first < last)
+	{
+		unsigned int             middle = first + (last - first) / 2;
+		const AssetArchiveEntry& entry  = mEntries[middle];
+
+		int compared = CompareEntry(entry.nameHash, mNames + entry.nameOffset, entry.nameLength, hash, name.data(), name.size());
+
+		if (compared == 0)
+			return &entry;
+
+		if (compared < 0)
+			first = middle + 1;
+		else
+			last  = middle;
+	}
+
+	return nullptr;
+}
+
+// -------------------------------------------------------------------- //
+
+bool AssetArchive::Read(const AssetArchiveEntry& entry, std::vector<char>& storage, const char*& dataOut, size_t& sizeOut) const
+{
+	if (!mHeader)
+		return false;
+
+	const char* stored = mFile.GetData() + entry.dataOffset;
+
+	if (entry.compression == AssetCompression::NONE)
+	{
+		dataOut = stored;
+		sizeOut = (size_t)entry.size;
+		return true;
+	}
+
+	storage.resize((size_t)entry.size);
+
+	if (!LZ4::Decompress(stored, (size_t)entry.storedSize, storage.data(), storage.size()))
+	{
+		storage.clear();
+		return false;
+	}
+
+	dataOut = storage.data();
+	sizeOut = storage.size();
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool AssetArchive::Write(const std::string& filePath, const std::vector<AssetArchiveSource>& sources, bool compress)
+{
+	unsigned int entryCount = (unsigned int)sources.size();
+
+	std::vector<AssetArchiveEntry> entries(entryCount);
+	std::string                    names;
+
+	for (unsigned int i = 0; i < entryCount; i++)
+	{
+		entries[i]            = AssetArchiveEntry();
+		entries[i].nameHash   = HashName(sources[i].name.data(), sources[i].name.size());
+		entries[i].nameOffset = (unsigned int)names.size();
+		entries[i].nameLength = (unsigned int)sources[i].name.size();
+		entries[i].size       = sources[i].data.size();
+
+		names += sources[i].name;
+	}
+
+	// Sort an index rather than the entries, so that each entry can still find its source
+	std::vector<unsigned int> order(entryCount);
+
+	for (unsigned int i = 0; i < entryCount; i++)
+		order[i] = i;
+
+	auto compareOrder = [&](unsigned int a, unsigned int b)
+	{
+		return CompareEntry(entries[a].nameHash, names.data() + entries[a].nameOffset, entries[a].nameLength,
+		                    entries[b].nameHash, names.data() + entries[b].nameOffset, entries[b].nameLength);
+	};
+
+	std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) { return compareOrder(a, b) < 0; });
+
+	for (unsigned int i = 1; i < entryCount; i++)
+	{
+		if (compareOrder(order[i - 1], order[i]) == 0)
+			return false;
+	}
+
+	AssetArchiveHeader header;
+	memset(&header, 0, sizeof(AssetArchiveHeader));
+
+	memcpy(header.magic, kAssetArchiveMagic, sizeof(kAssetArchiveMagic));
+	header.version       = kAssetArchiveVersion;
+	header.headerSize    = sizeof(AssetArchiveHeader);
+	header.entryStride   = sizeof(AssetArchiveEntry);
+	header.entryCount    = entryCount;
+	header.entriesOffset = FileUtils::AlignUp(sizeof(AssetArchiveHeader), alignof(AssetArchiveEntry));
+	header.namesOffset   = header.entriesOffset + (unsigned long long)entryCount * sizeof(AssetArchiveEntry);
+	header.namesSize     = names.size();
+
+	// Lay out the blobs, compressing where it pays and storing each distinct blob once. They go straight into the file's bytes, after
+	// room for everything before them.
+	std::vector<char>         bytes((size_t)FileUtils::AlignUp(header.namesOffset + header.namesSize, kAssetArchiveAlignment));
+	std::vector<unsigned int> blobSource;
+
+	for (unsigned int i = 0; i < entryCount; i++)
+	{
+		const std::vector<char>& data  = sources[i].data;
+		AssetArchiveEntry&       entry = entries[i];
+
+		bool shared = false;
+
+		for (unsigned int blob = 0; blob < blobSource.size() && !shared; blob++)
+		{
+			const AssetArchiveEntry& other = entries[blobSource[blob]];
+
+			if (sources[blobSource[blob]].data == data)
+			{
+				entry.dataOffset  = other.dataOffset;
+				entry.storedSize  = other.storedSize;
+				entry.compression = other.compression;
+				shared            = true;
+			}
+		}
+
+		if (shared)
+			continue;
+
+		std::vector<char> stored;
+
+		if (compress && !data.empty())
+		{
+			stored.resize(LZ4::GetMaxCompressedSize(data.size()));
+			stored.resize(LZ4::Compress(data.data(), data.size(), stored.data(), stored.size()));
+		}
+
+		if (!stored.empty() && stored.size() <= data.size() - data.size() / 8)
+		{
+			entry.compression = AssetCompression::LZ4;
+		}
+		else
+		{
+			stored            = data;
+			entry.compression = AssetCompression::NONE;
+		}
+
+		entry.dataOffset = bytes.size();
+		entry.storedSize = stored.size();
+
+		bytes.insert(bytes.end(), stored.begin(), stored.end());
+		bytes.resize((size_t)FileUtils::AlignUp(bytes.size(), kAssetArchiveAlignment));
+
+		blobSource.push_back(i);
+	}
+
+	header.fileSize = bytes.size();
+
+	memcpy(bytes.data(), &header, sizeof(AssetArchiveHeader));
+
+	for (unsigned int i = 0; i < entryCount; i++)
+		memcpy(bytes.data() + header.entriesOffset + (size_t)i * sizeof(AssetArchiveEntry), &entries[order[i]], sizeof(AssetArchiveEntry));
+
+	memcpy(bytes.data() + header.namesOffset, names.data(), names.size());
+
+	return FileUtils::WriteFileReplacing(filePath, bytes.data(), bytes.size());
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned long long AssetArchive::HashName(const char* name, size_t length)
+{
+	// FNV-1a - names are short, so a byte at a time is fine
+	unsigned long long hash = 0xcbf29ce484222325ull;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash = (hash ^ (unsigned char)name[i]) * 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,117 @@
+#ifndef _ASSET_ARCHIVE_H_
+#define _ASSET_ARCHIVE_H_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+// -------------------------------------------------------------------- //
+
+const unsigned int       kAssetArchiveVersion   = 1;
+const char* const        kAssetArchiveExtension = ".pak";
+
+// Every blob starts on this boundary, so that data stored uncompressed can be used in place - a mesh cache's streams are 16 byte aligned
+// relative to its start, and a cache line keeps blobs from sharing one.
+const unsigned long long kAssetArchiveAlignment = 64;
+
+enum class AssetCompression : unsigned int
+{
+	NONE = 0,
+	LZ4,
+
+	MAX
+};
+
+// -------------------------------------------------------------------- //
+
+// Sits at the start of the file. The table of contents, the names and the blobs follow.
+struct AssetArchiveHeader final
+{
+	char               magic[4];     // "TKPK"
+	unsigned int       version;
+	unsigned int       headerSize;
+	unsigned int       entryStride;  // sizeof(AssetArchiveEntry) when written
+
+	unsigned int       entryCount;
+	unsigned int       padding;      // Spelt out so that the size is the same on every compiler
+
+	unsigned long long entriesOffset;
+	unsigned long long namesOffset;  // Every entry's name, one after the other with no terminators
+	unsigned long long namesSize;
+	unsigned long long fileSize;     // Catches a truncated copy before any entry is looked at
+};
+
+static_assert(sizeof(AssetArchiveHeader) == 56, "AssetArchiveHeader must have the same layout on every platform");
+
+// Sorted by name hash, then by name, so that Find() is a binary search
+struct AssetArchiveEntry final
+{
+	unsigned long long nameHash;     // AssetArchive::HashName()
+	unsigned long long dataOffset;   // Identical blobs are only stored once, so entries can share an offset
+	unsigned long long storedSize;   // Size in the file - the compressed size if compressed
+	unsigned long long size;         // Size once decompressed
+
+	unsigned int       nameOffset;   // Into the names block
+	unsigned int       nameLength;
+	AssetCompression   compression;
+	unsigned int       padding;
+};
+
+static_assert(sizeof(AssetArchiveEntry) == 48, "AssetArchiveEntry must have the same layout on every platform");
+
+// What AssetArchive::Write() packs - the name is what Find() looks it up by
+struct AssetArchiveSource final
+{
+	std::string       name;
+	std::vector<char> data;
+};
+
+// -------------------------------------------------------------------- //
+
+// A whole set of assets in one memory mapped file - one open and one map, however many assets are read from it.
+// Find() and Read() do not change the archive, so any number of threads can read from one at once.
+class AssetArchive final
+{
+public:
+	AssetArchive();
+	~AssetArchive();
+
+	AssetArchive(const AssetArchive&)            = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	// Checks the header, the table of contents and that every blob lies within the file before accepting any of it
+	bool                     Open(const std::string& filePath);
+	void                     Close();
+
+	bool                     GetIsOpen()     const { return mHeader != nullptr; }
+
+	unsigned int             GetEntryCount() const { return mHeader ? mHeader->entryCount : 0; }
+	const AssetArchiveEntry& GetEntry(unsigned int index) const { return mEntries[index]; }
+	std::string              GetEntryName(const AssetArchiveEntry& entry) const;
+
+	// nullptr if there is no asset by this name
+	const AssetArchiveEntry* Find(const std::string& name) const;
+
+	// Uncompressed blobs are returned straight out of the mapping, valid until Close(). Compressed ones are decompressed into storage,
+	// and the data points into that instead. Either way the data is at least 16 byte aligned.
+	bool                     Read(const AssetArchiveEntry& entry, std::vector<char>& storage, const char*& dataOut, size_t& sizeOut) const;
+
+	// Blobs are compressed only where that saves at least an eighth, so that most data can still be used in place.
+	// Fails if two sources have the same name.
+	static bool              Write(const std::string& filePath, const std::vector<AssetArchiveSource>& sources, bool compress);
+
+	static unsigned long long HashName(const char* name, size_t length);
+
+private:
+	MappedFile                mFile;
+
+	const AssetArchiveHeader* mHeader;
+	const AssetArchiveEntry*  mEntries;
+	const char*               mNames;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,70 @@
+#include "FileUtils.h"
+
+#include <fstream>
+#include <stdio.h>
+
+#if defined(_WIN32)
+	#include <windows.h>
+#endif
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+#if defined(_WIN32)
+	// Converted the way CreateFileA() reads a path, so that the same strings name the same files
+	std::wstring WidenPath(const std::string& path)
+	{
+		int length = MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, nullptr, 0);
+
+		if (length <= 0)
+			return std::wstring();
+
+		std::wstring widePath((size_t)length, L'\0');
+		MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, &widePath[0], length);
+
+		return widePath;
+	}
+#endif
+
+	bool MoveOverFile(const std::string& fromPath, const std::string& toPath)
+	{
+#if defined(_WIN32)
+		// rename() will not replace an existing file on Windows, and removing that first would leave a moment with no file at all
+		std::wstring fromPathWide = WidenPath(fromPath);
+		std::wstring toPathWide   = WidenPath(toPath);
+
+		if (fromPathWide.empty() || toPathWide.empty())
+			return false;
+
+		return MoveFileExW(fromPathWide.c_str(), toPathWide.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		// Replaces whatever was there in one step
+		return rename(fromPath.c_str(), toPath.c_str()) == 0;
+#endif
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool FileUtils::WriteFileReplacing(const std::string& filePath, const char* data, size_t size)
+{
+	std::string   temporaryPath = filePath + ".tmp";
+	std::ofstream file(temporaryPath.c_str(), std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		return false;
+
+	file.write(data, (std::streamsize)size);
+	file.close();
+
+	if (!file.good() || !MoveOverFile(temporaryPath, filePath))
+	{
+		remove(temporaryPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,30 @@
+#ifndef _FILE_UTILS_H_
+#define _FILE_UTILS_H_
+
+#include <stddef.h>
+#include <string>
+
+// -------------------------------------------------------------------- //
+
+// Shared by the readers and writers of the binary caches and archives
+struct FileUtils final
+{
+public:
+	// alignment must be a power of two
+	static unsigned long long AlignUp(unsigned long long value, unsigned long long alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+	// For checking a file's own claims about its layout before trusting any of them - true if the range starts on the alignment,
+	// past the header, and ends within the block. Written so that no huge offset or size can wrap around and pass.
+	static bool               GetIsRangeInBlock(unsigned long long offset, unsigned long long size, unsigned long long alignment, unsigned long long headerSize, unsigned long long blockSize)
+	{
+		return (offset % alignment) == 0 && offset >= headerSize && offset <= blockSize && size <= blockSize - offset;
+	}
+
+	// Writes the bytes to filePath + ".tmp" and then moves that over filePath in one step, so that a crash part way through leaves
+	// either the old file or the new one, never a truncated one. Returns false (and removes the temporary file) if either step fails.
+	static bool               WriteFileReplacing(const std::string& filePath, const char* data, size_t size);
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,238 @@
+#include "LZ4.h"
+
+#include <string.h>
+#include <vector>
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const size_t       kMinMatch       = 4;
+	const size_t       kMaxOffset      = 65535;
+
+	// The format's end of block rules - the last 5 bytes are always literals, and no match may start in the last 12
+	const size_t       kLastLiterals   = 5;
+	const size_t       kMatchFindLimit = 12;
+
+	const unsigned int kHashBits       = 16;
+
+	// After this many misses in a row the search starts skipping ahead, so incompressible data passes through quickly
+	const unsigned int kSkipTrigger    = 6;
+
+	inline unsigned int Read32(const unsigned char* data)
+	{
+		unsigned int value;
+		memcpy(&value, data, sizeof(value));
+
+		return value;
+	}
+
+	inline unsigned int Hash(unsigned int sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - kHashBits);
+	}
+
+	// Writes the 255, 255, ..., remainder run that follows a length nibble of 15
+	inline unsigned char* WriteLength(unsigned char* output, size_t length)
+	{
+		while (length >= 255)
+		{
+			*output++ = 255;
+			length   -= 255;
+		}
+
+		*output++ = (unsigned char)length;
+
+		return output;
+	}
+
+	inline bool ReadLength(const unsigned char*& input, const unsigned char* inputEnd, size_t& length)
+	{
+		unsigned char byte;
+
+		do
+		{
+			if (input >= inputEnd)
+				return false;
+
+			byte    = *input++;
+			length += byte;
+		} while (byte == 255);
+
+		return true;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+size_t LZ4::Compress(const char* input, size_t inputSize, char* output, size_t outputCapacity)
+{
+	const unsigned char* base       = (const unsigned char*)input;
+	const unsigned char* inputEnd   = base + inputSize;
+	const unsigned char* current    = base;
+	const unsigned char* anchor     = base;
+
+	unsigned char*       out        = (unsigned char*)output;
+	unsigned char*       outEnd     = out + outputCapacity;
+
+	// Each sequence needs a token, its literals, up to two length runs and an offset - check for the worst case before writing one
+	auto hasRoomFor = [&out, outEnd](size_t literalCount, size_t matchLength)
+	{
+		return (size_t)(outEnd - out) >= 1 + literalCount + (literalCount / 255 + 1) + 2 + (matchLength / 255 + 1);
+	};
+
+	if (inputSize >= kMatchFindLimit + 1)
+	{
+		std::vector<unsigned int> table(1u << kHashBits, 0);
+
+		const unsigned char* matchLimit = inputEnd - kLastLiterals;
+		const unsigned char* findLimit  = inputEnd - kMatchFindLimit;
+
+		unsigned int missCount = 0;
+
+		while (current < findLimit)
+		{
+			unsigned int         hash      = Hash(Read32(current));
+			const unsigned char* reference = base + table[hash];
+
+			table[hash] = (unsigned int)(current - base);
+
+			if (reference >= current || (size_t)(current - reference) > kMaxOffset || Read32(reference) != Read32(current))
+			{
+				current += 1 + (missCount++ >> kSkipTrigger);
+				continue;
+			}
+
+			missCount = 0;
+
+			// Take in any matching bytes just before, which would otherwise be stored as literals
+			while (current > anchor && reference > base && current[-1] == reference[-1])
+			{
+				current--;
+				reference--;
+			}
+
+			size_t matchLength = kMinMatch;
+
+			while (current + matchLength < matchLimit && current[matchLength] == reference[matchLength])
+				matchLength++;
+
+			size_t literalCount = (size_t)(current - anchor);
+
+			if (!hasRoomFor(literalCount, matchLength))
+				return 0;
+
+			unsigned char* token = out++;
+			size_t         extra = matchLength - kMinMatch;
+
+			*token = (unsigned char)((literalCount >= 15 ? 15 : literalCount) << 4);
+
+			if (literalCount >= 15)
+				out = WriteLength(out, literalCount - 15);
+
+			memcpy(out, anchor, literalCount);
+			out += literalCount;
+
+			size_t offset = (size_t)(current - reference);
+
+			*out++ = (unsigned char)(offset & 0xFF);
+			*out++ = (unsigned char)(offset >> 8);
+
+			*token |= (unsigned char)(extra >= 15 ? 15 : extra);
+
+			if (extra >= 15)
+				out = WriteLength(out, extra - 15);
+
+			current += matchLength;
+			anchor   = current;
+
+			// Index a position inside the match as well, which finds more of the repeats in structured data like vertex arrays
+			if (current < findLimit)
+				table[Hash(Read32(current - 2))] = (unsigned int)(current - 2 - base);
+		}
+	}
+
+	// Whatever is left goes out as the final, literal only, sequence
+	size_t literalCount = (size_t)(inputEnd - anchor);
+
+	if (!hasRoomFor(literalCount, 0))
+		return 0;
+
+	*out++ = (unsigned char)((literalCount >= 15 ? 15 : literalCount) << 4);
+
+	if (literalCount >= 15)
+		out = WriteLength(out, literalCount - 15);
+
+	memcpy(out, anchor, literalCount);
+	out += literalCount;
+
+	return (size_t)(out - (unsigned char*)output);
+}
+
+// -------------------------------------------------------------------- //
+
+bool LZ4::Decompress(const char* input, size_t inputSize, char* output, size_t outputSize)
+{
+	const unsigned char* in       = (const unsigned char*)input;
+	const unsigned char* inputEnd = in + inputSize;
+
+	unsigned char*       out      = (unsigned char*)output;
+	unsigned char*       outEnd   = out + outputSize;
+
+	while (in < inputEnd)
+	{
+		unsigned char token        = *in++;
+		size_t        literalCount = token >> 4;
+
+		if (literalCount == 15 && !ReadLength(in, inputEnd, literalCount))
+			return false;
+
+		if (literalCount > (size_t)(inputEnd - in) || literalCount > (size_t)(outEnd - out))
+			return false;
+
+		memcpy(out, in, literalCount);
+		in  += literalCount;
+		out += literalCount;
+
+		// The last sequence has no match
+		if (in == inputEnd)
+			break;
+
+		if (inputEnd - in < 2)
+			return false;
+
+		size_t offset = (size_t)in[0] | ((size_t)in[1] << 8);
+		in += 2;
+
+		if (offset == 0 || offset > (size_t)(out - (unsigned char*)output))
+			return false;
+
+		size_t matchLength = token & 15;
+
+		if (matchLength == 15 && !ReadLength(in, inputEnd, matchLength))
+			return false;
+
+		matchLength += kMinMatch;
+
+		if (matchLength > (size_t)(outEnd - out))
+			return false;
+
+		const unsigned char* reference = out - offset;
+
+		// Overlapping copies repeat the bytes just written, so they have to go one at a time
+		if (offset >= matchLength)
+		{
+			memcpy(out, reference, matchLength);
+			out += matchLength;
+		}
+		else
+		{
+			for (size_t i = 0; i < matchLength; i++)
+				*out++ = reference[i];
+		}
+	}
+
+	return out == outEnd;
+}
+
+// -------------------------------------------------------------------- //
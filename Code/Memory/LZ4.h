@@ -0,0 +1,26 @@
+#ifndef _LZ4_H_
+#define _LZ4_H_
+
+#include <stddef.h>
+
+// -------------------------------------------------------------------- //
+
+// The LZ4 block format (no frame around it) - byte oriented LZ77 that decompresses at close to memory speed, which is what loading
+// wants. Output is compatible with the reference implementation, so archives can be checked with the standard tools.
+struct LZ4 final
+{
+public:
+	// Compressing into a buffer of this size cannot run out of room
+	static size_t GetMaxCompressedSize(size_t inputSize) { return inputSize + inputSize / 255 + 16; }
+
+	// Greedy single-probe matching. Returns the compressed size, or 0 if it would not fit in outputCapacity.
+	static size_t Compress(const char* input, size_t inputSize, char* output, size_t outputCapacity);
+
+	// Checks every length and offset against the buffers, so corrupt data fails rather than reading or writing out of bounds.
+	// Returns false unless the block decodes to exactly outputSize bytes.
+	static bool   Decompress(const char* input, size_t inputSize, char* output, size_t outputSize);
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,174 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// -------------------------------------------------------------------- //
+
+MappedFile::MappedFile()
+	: mData(nullptr)
+	, mSize(0)
+	, mModifiedTime(0)
+	, mIsOpen(false)
+#if defined(_WIN32)
+	, mFileHandle(INVALID_HANDLE_VALUE)
+	, mMappingHandle(nullptr)
+#else
+	, mFileDescriptor(-1)
+#endif
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+// -------------------------------------------------------------------- //
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	mFileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (mFileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	FILETIME      writeTime;
+
+	if (!GetFileSizeEx(mFileHandle, &fileSize) || !GetFileTime(mFileHandle, nullptr, nullptr, &writeTime))
+	{
+		Close();
+		return false;
+	}
+
+	// FILETIME counts 100ns intervals from 1601
+	ULARGE_INTEGER writeTime64;
+	writeTime64.LowPart  = writeTime.dwLowDateTime;
+	writeTime64.HighPart = writeTime.dwHighDateTime;
+
+	mModifiedTime = (long long)(writeTime64.QuadPart / 10000000ull) - 11644473600ll;
+	mSize         = (size_t)fileSize.QuadPart;
+	mIsOpen       = true;
+
+	// Windows refuses to map an empty file
+	if (mSize == 0)
+		return true;
+
+	mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!mMappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	mData = (const char*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+	if (!mData)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void MappedFile::Close()
+{
+	if (mData)
+		UnmapViewOfFile(mData);
+
+	if (mMappingHandle)
+		CloseHandle(mMappingHandle);
+
+	if (mFileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(mFileHandle);
+
+	mData          = nullptr;
+	mSize          = 0;
+	mModifiedTime  = 0;
+	mIsOpen        = false;
+	mMappingHandle = nullptr;
+	mFileHandle    = INVALID_HANDLE_VALUE;
+}
+
+// -------------------------------------------------------------------- //
+
+#else
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	mFileDescriptor = open(filePath.c_str(), O_RDONLY);
+
+	if (mFileDescriptor < 0)
+		return false;
+
+	struct stat fileInfo;
+
+	if (fstat(mFileDescriptor, &fileInfo) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	mModifiedTime = (long long)fileInfo.st_mtime;
+	mSize         = (size_t)fileInfo.st_size;
+	mIsOpen       = true;
+
+	if (mSize == 0)
+		return true;
+
+	void* mapping = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFileDescriptor, 0);
+
+	if (mapping == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+
+	// The parsers read front to back, so let the kernel read ahead aggressively
+	madvise(mapping, mSize, MADV_SEQUENTIAL);
+
+	mData = (const char*)mapping;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void MappedFile::Close()
+{
+	if (mData)
+		munmap((void*)mData, mSize);
+
+	if (mFileDescriptor >= 0)
+		close(mFileDescriptor);
+
+	mData           = nullptr;
+	mSize           = 0;
+	mModifiedTime   = 0;
+	mIsOpen         = false;
+	mFileDescriptor = -1;
+}
+
+#endif
+
+// -------------------------------------------------------------------- //
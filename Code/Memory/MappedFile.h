@@ -0,0 +1,47 @@
+#ifndef _MAPPED_FILE_H_
+#define _MAPPED_FILE_H_
+
+#include <stddef.h>
+#include <string>
+
+// -------------------------------------------------------------------- //
+
+// Read-only memory mapping of a whole file, so that parsers can walk the bytes directly without copying them through a stream.
+// The data stays valid until Close() or the destructor. An empty file opens successfully with a nullptr data pointer and a size of 0.
+class MappedFile final
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&)            = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool        Open(const std::string& filePath);
+	void        Close();
+
+	bool        GetIsOpen() const { return mIsOpen; }
+
+	const char* GetData()   const { return mData; }
+	size_t      GetSize()   const { return mSize; }
+
+	// Last-write time of the file, in seconds since the Unix epoch. Only valid while open.
+	long long   GetModifiedTime() const { return mModifiedTime; }
+
+private:
+	const char* mData;
+	size_t      mSize;
+	long long   mModifiedTime;
+	bool        mIsOpen;
+
+#if defined(_WIN32)
+	void*       mFileHandle;
+	void*       mMappingHandle;
+#else
+	int         mFileDescriptor;
+#endif
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
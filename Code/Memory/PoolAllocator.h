@@ -0,0 +1,272 @@
+#ifndef _POOL_ALLOCATOR_H_
+#define _POOL_ALLOCATOR_H_
+
+#include <new>
+#include <utility>
+#include <vector>
+
+// -------------------------------------------------------------------- //
+
+// Refers to an object inside a PoolAllocator. The generation is bumped every time the slot is allocated or released,
+// so a handle to an object that has since been released (and maybe replaced) is detected rather than followed.
+struct PoolHandle final
+{
+	unsigned int index;
+	unsigned int generation;
+
+	PoolHandle() : index(0), generation(0) {}
+	PoolHandle(unsigned int slotIndex, unsigned int slotGeneration) : index(slotIndex), generation(slotGeneration) {}
+
+	// Only says the handle was ever filled in - use PoolAllocator::Get() to know if it still points at something
+	bool GetIsSet() const { return generation != 0; }
+
+	bool operator==(const PoolHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const PoolHandle& other) const { return !(*this == other); }
+};
+
+// -------------------------------------------------------------------- //
+
+struct PoolAllocatorStats final
+{
+	unsigned int       liveCount;
+	unsigned int       peakLiveCount;
+	unsigned int       slotCapacity;
+	unsigned int       blockCount;
+	unsigned long long bytesReserved;
+
+	unsigned long long allocationCount; // Running totals since the pool was made
+	unsigned long long releaseCount;
+};
+
+// -------------------------------------------------------------------- //
+
+// Fixed-size object pool. Objects are constructed in place inside blocks of kSlotsPerBlock slots, and the blocks are never moved
+// or freed until the pool is destroyed (or ReleaseMemory() is called), so pointers stay stable for as long as the object lives.
+// Free slots form an intrusive singly linked list, making Allocate() and Release() O(1) with no heap traffic once warmed up.
+template<typename T, unsigned int kSlotsPerBlock = 1024>
+class PoolAllocator final
+{
+public:
+	PoolAllocator();
+	~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator&)            = delete;
+	PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+	template<typename... Args>
+	PoolHandle Allocate(Args&&... constructorArguments);
+
+	// Returns false if the handle was already released
+	bool       Release(PoolHandle handle);
+
+	// nullptr if the handle is stale
+	T*         Get(PoolHandle handle) const;
+
+	// Destroys every live object but keeps the blocks for re-use. Every outstanding handle becomes stale.
+	void       Clear();
+
+	// Clear() and hand the blocks back to the heap. Slot generations start again from zero, so no handles should be kept across this
+	void       ReleaseMemory();
+
+	// Calls function(handle, object) for every live object, in slot order
+	template<typename Function>
+	void       ForEach(Function function);
+
+	const PoolAllocatorStats& GetStats() const { return mStats; }
+
+private:
+	static_assert(kSlotsPerBlock != 0 && (kSlotsPerBlock & (kSlotsPerBlock - 1)) == 0, "kSlotsPerBlock must be a power of two");
+
+	static const unsigned int kNoFreeSlot = ~0u;
+
+	struct Slot final
+	{
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		unsigned int generation; // Odd while the slot holds a live object
+		unsigned int nextFree;
+	};
+
+	Slot*  GetSlot(unsigned int index) const { return &mBlocks[index / kSlotsPerBlock][index & (kSlotsPerBlock - 1)]; }
+	T*     GetSlotObject(Slot* slot)   const { return reinterpret_cast<T*>(slot->storage); }
+
+	void   AddBlock();
+
+	std::vector<Slot*> mBlocks;
+	unsigned int       mFreeListHead;
+
+	PoolAllocatorStats mStats;
+};
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+PoolAllocator<T, kSlotsPerBlock>::PoolAllocator()
+	: mBlocks()
+	, mFreeListHead(kNoFreeSlot)
+	, mStats()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+PoolAllocator<T, kSlotsPerBlock>::~PoolAllocator()
+{
+	ReleaseMemory();
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+template<typename... Args>
+PoolHandle PoolAllocator<T, kSlotsPerBlock>::Allocate(Args&&... constructorArguments)
+{
+	if (mFreeListHead == kNoFreeSlot)
+		AddBlock();
+
+	unsigned int index = mFreeListHead;
+	Slot*        slot  = GetSlot(index);
+
+	new (slot->storage) T(std::forward<Args>(constructorArguments)...);
+
+	mFreeListHead = slot->nextFree;
+	slot->generation++;
+
+	mStats.liveCount++;
+	mStats.allocationCount++;
+
+	if (mStats.liveCount > mStats.peakLiveCount)
+		mStats.peakLiveCount = mStats.liveCount;
+
+	return PoolHandle(index, slot->generation);
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+bool PoolAllocator<T, kSlotsPerBlock>::Release(PoolHandle handle)
+{
+	T* object = Get(handle);
+
+	if (!object)
+		return false;
+
+	object->~T();
+
+	Slot* slot = GetSlot(handle.index);
+	slot->generation++;
+	slot->nextFree = mFreeListHead;
+	mFreeListHead  = handle.index;
+
+	mStats.liveCount--;
+	mStats.releaseCount++;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+T* PoolAllocator<T, kSlotsPerBlock>::Get(PoolHandle handle) const
+{
+	if (handle.index >= mStats.slotCapacity)
+		return nullptr;
+
+	Slot* slot = GetSlot(handle.index);
+
+	if (slot->generation != handle.generation || (slot->generation & 1u) == 0)
+		return nullptr;
+
+	return GetSlotObject(slot);
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+void PoolAllocator<T, kSlotsPerBlock>::Clear()
+{
+	// Rebuild the free list in slot order so that the next allocations come out contiguously again
+	mFreeListHead = kNoFreeSlot;
+
+	for (unsigned int index = mStats.slotCapacity; index-- > 0;)
+	{
+		Slot* slot = GetSlot(index);
+
+		if (slot->generation & 1u)
+		{
+			GetSlotObject(slot)->~T();
+			slot->generation++;
+
+			mStats.releaseCount++;
+		}
+
+		slot->nextFree = mFreeListHead;
+		mFreeListHead  = index;
+	}
+
+	mStats.liveCount = 0;
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+void PoolAllocator<T, kSlotsPerBlock>::ReleaseMemory()
+{
+	Clear();
+
+	for (Slot* block : mBlocks)
+	{
+		delete[] block;
+	}
+
+	mBlocks.clear();
+	mFreeListHead = kNoFreeSlot;
+
+	mStats.slotCapacity  = 0;
+	mStats.blockCount    = 0;
+	mStats.bytesReserved = 0;
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+template<typename Function>
+void PoolAllocator<T, kSlotsPerBlock>::ForEach(Function function)
+{
+	for (unsigned int index = 0; index < mStats.slotCapacity; index++)
+	{
+		Slot* slot = GetSlot(index);
+
+		if (slot->generation & 1u)
+			function(PoolHandle(index, slot->generation), *GetSlotObject(slot));
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+template<typename T, unsigned int kSlotsPerBlock>
+void PoolAllocator<T, kSlotsPerBlock>::AddBlock()
+{
+	Slot*        block     = new Slot[kSlotsPerBlock];
+	unsigned int baseIndex = mStats.slotCapacity;
+
+	// Chain the new slots together in order, ending at whatever was free before
+	for (unsigned int i = 0; i < kSlotsPerBlock; i++)
+	{
+		block[i].generation = 0;
+		block[i].nextFree   = (i + 1 < kSlotsPerBlock) ? baseIndex + i + 1 : mFreeListHead;
+	}
+
+	mBlocks.push_back(block);
+	mFreeListHead = baseIndex;
+
+	mStats.slotCapacity  += kSlotsPerBlock;
+	mStats.blockCount++;
+	mStats.bytesReserved += sizeof(Slot) * kSlotsPerBlock;
+}
+
+// -------------------------------------------------------------------- //
+
+#endif
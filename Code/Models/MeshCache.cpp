@@ -0,0 +1,253 @@
+#include "MeshCache.h"
+
+#include <string.h>
+#include <vector>
+
+#include "../Memory/FileUtils.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const char               kMeshCacheMagic[4] = { 'M', 'S', 'H', 'C' };
+	const unsigned long long kStreamAlignment   = 16;
+}
+
+// -------------------------------------------------------------------- //
+
+MeshCache::MeshCache()
+	: mFile()
+	, mStorage()
+	, mHeader(nullptr)
+	, mVertices(nullptr)
+	, mIndices(nullptr)
+	, mMeshlets(nullptr)
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+MeshCache::~MeshCache()
+{
+	Close();
+}
+
+// -------------------------------------------------------------------- //
+
+bool MeshCache::Open(const std::string& filePath)
+{
+	Close();
+
+	if (!mFile.Open(filePath) || !Validate(mFile.GetData(), mFile.GetSize()))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool MeshCache::OpenFromArchive(const AssetArchive& archive, const AssetArchiveEntry& entry)
+{
+	Close();
+
+	const char* data;
+	size_t      size;
+
+	if (!archive.Read(entry, mStorage, data, size) || !Validate(data, size))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool MeshCache::Validate(const char* data, size_t size)
+{
+	// The streams are read in place, so the block itself has to be aligned for them
+	if (size < sizeof(MeshCacheHeader) || ((size_t)data % kStreamAlignment) != 0)
+		return false;
+
+	const MeshCacheHeader* header = (const MeshCacheHeader*)data;
+
+	unsigned long long vertexBytes  = (unsigned long long)header->vertexCount  * sizeof(VertexData);
+	unsigned long long indexBytes   = (unsigned long long)header->indexCount   * sizeof(unsigned int);
+	unsigned long long meshletBytes = (unsigned long long)header->meshletCount * sizeof(Meshlet);
+
+	// Check everything before trusting any of it - the streams must be where they claim to be and fit within the block
+	if (memcmp(header->magic, kMeshCacheMagic, sizeof(kMeshCacheMagic)) != 0
+	 || header->version       != kMeshCacheVersion
+	 || header->headerSize    != sizeof(MeshCacheHeader)
+	 || header->vertexStride  != sizeof(VertexData)
+	 || header->meshletStride != sizeof(Meshlet)
+	 || !FileUtils::GetIsRangeInBlock(header->vertexOffset,  vertexBytes,  kStreamAlignment, sizeof(MeshCacheHeader), size)
+	 || !FileUtils::GetIsRangeInBlock(header->indexOffset,   indexBytes,   kStreamAlignment, sizeof(MeshCacheHeader), size)
+	 || !FileUtils::GetIsRangeInBlock(header->meshletOffset, meshletBytes, kStreamAlignment, sizeof(MeshCacheHeader), size)
+	 || header->lodCount == 0 || header->lodCount > kMaxMeshLods)
+	{
+		return false;
+	}
+
+	for (unsigned int lod = 0; lod < header->lodCount; lod++)
+	{
+		const MeshLod& meshLod = header->lods[lod];
+
+		if (meshLod.firstIndex   > header->indexCount   || meshLod.indexCount   > header->indexCount   - meshLod.firstIndex
+		 || meshLod.firstMeshlet > header->meshletCount || meshLod.meshletCount > header->meshletCount - meshLod.firstMeshlet)
+		{
+			return false;
+		}
+	}
+
+	const Meshlet* meshlets = (const Meshlet*)(data + header->meshletOffset);
+
+	// Meshlets are handed straight to DrawIndexed, so one pointing outside the index stream would draw garbage
+	for (unsigned int meshlet = 0; meshlet < header->meshletCount; meshlet++)
+	{
+		if (meshlets[meshlet].firstIndex > header->indexCount || meshlets[meshlet].indexCount > header->indexCount - meshlets[meshlet].firstIndex)
+			return false;
+	}
+
+	mHeader   = header;
+	mVertices = (const VertexData*)  (data + header->vertexOffset);
+	mIndices  = (const unsigned int*)(data + header->indexOffset);
+	mMeshlets = meshlets;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void MeshCache::Close()
+{
+	mFile.Close();
+	mStorage.clear();
+	mStorage.shrink_to_fit();
+
+	mHeader   = nullptr;
+	mVertices = nullptr;
+	mIndices  = nullptr;
+	mMeshlets = nullptr;
+}
+
+// -------------------------------------------------------------------- //
+
+bool MeshCache::Write(const std::string& filePath, const VertexData* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount, const Meshlet* meshlets, unsigned int meshletCount, const MeshLod* lods, unsigned int lodCount, const MeshOptimisationStats& optimisationStats, unsigned long long contentHash, const MappedFile& source)
+{
+	if (lodCount == 0 || lodCount > kMaxMeshLods)
+		return false;
+
+	MeshCacheHeader header;
+	memset(&header, 0, sizeof(MeshCacheHeader));
+
+	memcpy(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic));
+	header.version            = kMeshCacheVersion;
+	header.headerSize         = sizeof(MeshCacheHeader);
+	header.vertexStride       = sizeof(VertexData);
+	header.vertexCount        = vertexCount;
+	header.indexCount         = indexCount;
+	header.meshletCount       = meshletCount;
+	header.meshletStride      = sizeof(Meshlet);
+	header.vertexOffset       = FileUtils::AlignUp(sizeof(MeshCacheHeader), kStreamAlignment);
+	header.indexOffset        = FileUtils::AlignUp(header.vertexOffset + (unsigned long long)vertexCount * sizeof(VertexData), kStreamAlignment);
+	header.meshletOffset      = FileUtils::AlignUp(header.indexOffset  + (unsigned long long)indexCount  * sizeof(unsigned int), kStreamAlignment);
+	header.sourceSize         = source.GetSize();
+	header.sourceModifiedTime = source.GetModifiedTime();
+	header.sourceHash         = HashBytes(source.GetData(), source.GetSize());
+	header.contentHash        = contentHash;
+	header.acmrBefore         = optimisationStats.before.acmr;
+	header.acmrAfter          = optimisationStats.after.acmr;
+	header.atvrBefore         = optimisationStats.before.atvr;
+	header.atvrAfter          = optimisationStats.after.atvr;
+	header.lodCount           = lodCount;
+
+	memcpy(header.lods, lods, sizeof(MeshLod) * lodCount);
+
+	CalculateBounds(vertices, vertexCount, header.boundsMin, header.boundsMax);
+
+	// Laid out in memory first - the gaps between the streams are left zeroed
+	std::vector<char> bytes((size_t)(header.meshletOffset + (unsigned long long)meshletCount * sizeof(Meshlet)));
+
+	memcpy(bytes.data(), &header, sizeof(MeshCacheHeader));
+	memcpy(bytes.data() + header.vertexOffset,  vertices, (size_t)vertexCount  * sizeof(VertexData));
+	memcpy(bytes.data() + header.indexOffset,   indices,  (size_t)indexCount   * sizeof(unsigned int));
+	memcpy(bytes.data() + header.meshletOffset, meshlets, (size_t)meshletCount * sizeof(Meshlet));
+
+	return FileUtils::WriteFileReplacing(filePath, bytes.data(), bytes.size());
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned long long MeshCache::HashBytes(const char* data, size_t size)
+{
+	// FNV-1a, taken eight bytes at a time rather than one so that hashing a large source file stays cheap next to parsing it
+	const unsigned long long kPrime = 0x100000001b3ull;
+	unsigned long long       hash   = 0xcbf29ce484222325ull ^ (unsigned long long)size;
+
+	size_t i = 0;
+
+	for (; i + 8 <= size; i += 8)
+	{
+		unsigned long long word;
+		memcpy(&word, data + i, sizeof(word));
+
+		hash = (hash ^ word) * kPrime;
+	}
+
+	for (; i < size; i++)
+	{
+		hash = (hash ^ (unsigned char)data[i]) * kPrime;
+	}
+
+	// Final mix, as the word-wise multiply leaves the low bits weak
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned long long MeshCache::HashMesh(const VertexData* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
+{
+	unsigned long long vertexHash = HashBytes((const char*)vertices, sizeof(VertexData)   * (size_t)vertexCount);
+	unsigned long long indexHash  = HashBytes((const char*)indices,  sizeof(unsigned int) * (size_t)indexCount);
+
+	// Combined unevenly so that swapping the two streams' hashes would not give the same result
+	return vertexHash ^ (indexHash * 0x9e3779b97f4a7c15ull + (vertexHash << 6) + (vertexHash >> 2));
+}
+
+// -------------------------------------------------------------------- //
+
+void MeshCache::CalculateBounds(const VertexData* vertices, unsigned int vertexCount, DirectX::XMFLOAT3& minOut, DirectX::XMFLOAT3& maxOut)
+{
+	if (vertexCount == 0)
+	{
+		minOut = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		maxOut = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		return;
+	}
+
+	minOut = vertices[0].vertexPosition;
+	maxOut = vertices[0].vertexPosition;
+
+	for (unsigned int i = 1; i < vertexCount; i++)
+	{
+		const DirectX::XMFLOAT3& position = vertices[i].vertexPosition;
+
+		minOut.x = position.x < minOut.x ? position.x : minOut.x;
+		minOut.y = position.y < minOut.y ? position.y : minOut.y;
+		minOut.z = position.z < minOut.z ? position.z : minOut.z;
+
+		maxOut.x = position.x > maxOut.x ? position.x : maxOut.x;
+		maxOut.y = position.y > maxOut.y ? position.y : maxOut.y;
+		maxOut.z = position.z > maxOut.z ? position.z : maxOut.z;
+	}
+}
+
+// -------------------------------------------------------------------- //
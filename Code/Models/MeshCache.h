@@ -0,0 +1,126 @@
+#ifndef _MESH_CACHE_H_
+#define _MESH_CACHE_H_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include <directxmath.h>
+
+#include "Meshlet.h"
+#include "Model.h"
+
+#include "../Memory/AssetArchive.h"
+#include "../Memory/MappedFile.h"
+
+
+// -------------------------------------------------------------------- //
+
+// Bump whenever the layout of the file or of VertexData changes, so that old caches are re-imported rather than misread
+const unsigned int kMeshCacheVersion   = 6;
+const char* const  kMeshCacheExtension = ".meshcache";
+
+// -------------------------------------------------------------------- //
+
+// Sits at the start of the file. The vertex, index and meshlet streams follow at 16 byte aligned offsets.
+struct MeshCacheHeader final
+{
+	char               magic[4];           // "MSHC"
+	unsigned int       version;
+	unsigned int       headerSize;
+	unsigned int       vertexStride;       // sizeof(VertexData) when written
+
+	unsigned int       vertexCount;
+	unsigned int       indexCount;         // Every level of detail together
+	unsigned int       meshletCount;       // Every level of detail together
+	unsigned int       meshletStride;      // sizeof(Meshlet) when written
+	unsigned long long vertexOffset;
+	unsigned long long indexOffset;
+	unsigned long long meshletOffset;
+
+	DirectX::XMFLOAT3  boundsMin;
+	DirectX::XMFLOAT3  boundsMax;
+
+	// What the cache was imported from - used to tell if it is out of date
+	unsigned long long sourceSize;
+	long long          sourceModifiedTime; // Seconds since the Unix epoch
+	unsigned long long sourceHash;         // MeshCache::HashBytes() of the whole source file
+
+	unsigned long long contentHash;        // MeshCache::HashMesh() of the vertex and index streams, for spotting identical meshes
+
+	// Vertex cache efficiency of the source's order and of the optimised order stored here - see MeshOptimiser
+	float              acmrBefore;
+	float              acmrAfter;
+	float              atvrBefore;
+	float              atvrAfter;
+
+	// Ranges of the index stream - level 0 is the full detail mesh
+	unsigned int       lodCount;
+	MeshLod            lods[kMaxMeshLods];
+
+	unsigned int       padding;            // Spelt out so that the size is the same on every compiler
+};
+
+static_assert(sizeof(MeshCacheHeader) == 256, "MeshCacheHeader must have the same layout on every platform");
+
+// -------------------------------------------------------------------- //
+
+// A mesh cache file mapped into memory, or a mesh cache stored in an asset archive. The vertex and index arrays are used in place,
+// straight out of the mapping - unless the archive compressed it, in which case they are used out of the decompressed copy.
+class MeshCache final
+{
+public:
+	MeshCache();
+	~MeshCache();
+
+	MeshCache(const MeshCache&)            = delete;
+	MeshCache& operator=(const MeshCache&) = delete;
+
+	// Fails if the file is missing, from a different version, or its streams do not fit inside it
+	bool                   Open(const std::string& filePath);
+	bool                   OpenFromArchive(const AssetArchive& archive, const AssetArchiveEntry& entry); // The archive must stay open
+	void                   Close();
+
+	bool                   GetIsOpen()   const { return mHeader != nullptr; }
+
+	const MeshCacheHeader& GetHeader()   const { return *mHeader; }
+	const VertexData*      GetVertices() const { return mVertices; }
+	const unsigned int*    GetIndices()  const { return mIndices; }
+	const Meshlet*         GetMeshlets() const { return mMeshlets; }
+
+	static bool               Write(const std::string&           filePath,
+		                            const VertexData*            vertices,
+		                            unsigned int                 vertexCount,
+		                            const unsigned int*          indices,
+		                            unsigned int                 indexCount,
+		                            const Meshlet*               meshlets,
+		                            unsigned int                 meshletCount,
+		                            const MeshLod*               lods,
+		                            unsigned int                 lodCount,
+		                            const MeshOptimisationStats& optimisationStats,
+		                            unsigned long long           contentHash,
+		                            const MappedFile&            source);
+
+	static unsigned long long HashBytes(const char* data, size_t size);
+
+	// Identical vertex and index data gives the same hash, whatever file it came from
+	static unsigned long long HashMesh(const VertexData* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
+
+	static void               CalculateBounds(const VertexData* vertices, unsigned int vertexCount, DirectX::XMFLOAT3& minOut, DirectX::XMFLOAT3& maxOut);
+
+private:
+	// Sets the stream pointers only if the whole block checks out
+	bool                   Validate(const char* data, size_t size);
+
+	MappedFile             mFile;
+	std::vector<char>      mStorage;           // Only used for a cache the archive compressed
+
+	const MeshCacheHeader* mHeader;
+	const VertexData*      mVertices;
+	const unsigned int*    mIndices;
+	const Meshlet*         mMeshlets;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
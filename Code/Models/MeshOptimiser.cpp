@@ -0,0 +1,532 @@
+#include "MeshOptimiser.h"
+
+#include <algorithm>
+#include <math.h>
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const unsigned int kNoTriangle         = ~0u;
+
+	// Forsyth's scoring - the cache is an LRU of this many vertices, and vertices with more live triangles than the table holds
+	// all get the last entry's (tiny) valence bonus
+	const unsigned int kForsythCacheSize   = 32;
+	const unsigned int kValenceTableSize   = 32;
+
+	const float        kCacheDecayPower    = 1.5f;
+	const float        kLastTriangleScore  = 0.75f;
+	const float        kValenceBoostScale  = 2.0f;
+	const float        kValenceBoostPower  = 0.5f;
+
+	struct ForsythScoreTable final
+	{
+		float cachePosition[kForsythCacheSize];
+		float valence[kValenceTableSize];
+
+		ForsythScoreTable()
+		{
+			for (unsigned int i = 0; i < kForsythCacheSize; i++)
+			{
+				// The three vertices of the triangle just drawn get a fixed score, so that the next triangle does not
+				// simply favour whichever of them happens to be first in the cache
+				if (i < 3)
+					cachePosition[i] = kLastTriangleScore;
+				else
+					cachePosition[i] = powf(1.0f - (float)(i - 3) / (float)(kForsythCacheSize - 3), kCacheDecayPower);
+			}
+
+			valence[0] = 0.0f;
+
+			for (unsigned int i = 1; i < kValenceTableSize; i++)
+			{
+				valence[i] = kValenceBoostScale * powf((float)i, -kValenceBoostPower);
+			}
+		}
+	};
+
+	const ForsythScoreTable kScoreTable;
+
+	inline float GetVertexScore(int cachePosition, unsigned int liveTriangles)
+	{
+		// Nothing left to draw from this vertex, so nothing can want it
+		if (liveTriangles == 0)
+			return -1.0f;
+
+		float score = cachePosition >= 0 ? kScoreTable.cachePosition[cachePosition] : 0.0f;
+
+		return score + kScoreTable.valence[liveTriangles < kValenceTableSize ? liveTriangles : kValenceTableSize - 1];
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Simulates a FIFO cache without storing it - a vertex is still cached if fewer than cacheSize misses have happened since it
+	// was last loaded. Start the time at cacheSize + 1 so that everything begins as a miss.
+	class FifoCacheSimulator final
+	{
+	public:
+		FifoCacheSimulator(unsigned int vertexCount, unsigned int cacheSize)
+			: mLoadTimes(vertexCount, 0)
+			, mTime(cacheSize + 1)
+			, mCacheSize(cacheSize)
+		{
+
+		}
+
+		// Returns true on a miss
+		bool Access(unsigned int vertex)
+		{
+			if (mTime - mLoadTimes[vertex] <= mCacheSize)
+				return false;
+
+			mLoadTimes[vertex] = mTime++;
+			return true;
+		}
+
+		unsigned int AccessTriangle(const unsigned int* triangle)
+		{
+			return (unsigned int)Access(triangle[0]) + (unsigned int)Access(triangle[1]) + (unsigned int)Access(triangle[2]);
+		}
+
+		void Flush()
+		{
+			mTime += mCacheSize + 1;
+		}
+
+	private:
+		std::vector<unsigned int> mLoadTimes;
+		unsigned int              mTime;
+		unsigned int              mCacheSize;
+	};
+
+	// -------------------------------------------------------------------- //
+
+	unsigned int GetVertexCount(const std::vector<unsigned int>& indices)
+	{
+		unsigned int vertexCount = 0;
+
+		for (unsigned int index : indices)
+		{
+			if (index >= vertexCount)
+				vertexCount = index + 1;
+		}
+
+		return vertexCount;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool MeshOptimiser::Optimise(std::vector<VertexData>& vertices, std::vector<unsigned int>& indices, bool optimiseOverdraw, MeshOptimisationStats& statsOut)
+{
+	if (indices.size() % 3 != 0 || GetVertexCount(indices) > vertices.size())
+		return false;
+
+	statsOut.before = AnalyseVertexCache(indices, (unsigned int)vertices.size());
+
+	OptimiseVertexCache(indices, (unsigned int)vertices.size());
+
+	if (optimiseOverdraw)
+		OptimiseOverdraw(indices, vertices, kDefaultOverdrawThreshold);
+
+	OptimiseVertexFetch(vertices, indices);
+
+	statsOut.after = AnalyseVertexCache(indices, (unsigned int)vertices.size());
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool MeshOptimiser::OptimiseVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount)
+{
+	unsigned int triangleCount = (unsigned int)(indices.size() / 3);
+
+	if (indices.size() % 3 != 0 || GetVertexCount(indices) > vertexCount)
+		return false;
+
+	if (triangleCount == 0)
+		return true;
+
+	// Triangles using each vertex, packed into one array. The first liveTriangles[v] entries of a vertex's range are the ones not yet drawn.
+	std::vector<unsigned int> liveTriangles(vertexCount, 0);
+	std::vector<unsigned int> firstTriangle(vertexCount + 1, 0);
+	std::vector<unsigned int> adjacency(indices.size());
+
+	for (unsigned int index : indices)
+	{
+		liveTriangles[index]++;
+	}
+
+	for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+	{
+		firstTriangle[vertex + 1] = firstTriangle[vertex] + liveTriangles[vertex];
+	}
+
+	std::vector<unsigned int> fillCursor(firstTriangle.begin(), firstTriangle.end() - 1);
+
+	for (unsigned int triangle = 0; triangle < triangleCount; triangle++)
+	{
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			adjacency[fillCursor[indices[triangle * 3 + corner]]++] = triangle;
+		}
+	}
+
+	std::vector<float>         vertexScore(vertexCount);
+	std::vector<float>         triangleScore(triangleCount);
+	std::vector<unsigned char> triangleDrawn(triangleCount, 0);
+
+	for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+	{
+		vertexScore[vertex] = GetVertexScore(-1, liveTriangles[vertex]);
+	}
+
+	unsigned int bestTriangle = 0;
+
+	for (unsigned int triangle = 0; triangle < triangleCount; triangle++)
+	{
+		const unsigned int* corners = &indices[triangle * 3];
+
+		triangleScore[triangle] = vertexScore[corners[0]] + vertexScore[corners[1]] + vertexScore[corners[2]];
+
+		if (triangleScore[triangle] > triangleScore[bestTriangle])
+			bestTriangle = triangle;
+	}
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+
+	// Room for the three new vertices pushing the rest along, before the ones that fall off the end are dropped
+	unsigned int cache[kForsythCacheSize + 3];
+	unsigned int newCache[kForsythCacheSize + 3];
+	unsigned int cacheCount = 0;
+
+	// Where to carry on looking for an undrawn triangle when nothing in the cache has any left
+	unsigned int scanCursor = 0;
+
+	while (bestTriangle != kNoTriangle)
+	{
+		const unsigned int* corners = &indices[bestTriangle * 3];
+
+		triangleDrawn[bestTriangle] = 1;
+
+		output.push_back(corners[0]);
+		output.push_back(corners[1]);
+		output.push_back(corners[2]);
+
+		// Take the triangle out of its vertices' live lists
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			unsigned int  vertex = corners[corner];
+			unsigned int* live   = &adjacency[firstTriangle[vertex]];
+
+			// A degenerate triangle can name the same vertex twice, and has already been removed the second time round
+			for (unsigned int i = 0; i < liveTriangles[vertex]; i++)
+			{
+				if (live[i] == bestTriangle)
+				{
+					live[i] = live[liveTriangles[vertex] - 1];
+					liveTriangles[vertex]--;
+					break;
+				}
+			}
+		}
+
+		// The drawn triangle's vertices move to the front of the cache, and everything else shuffles back
+		unsigned int newCacheCount = 0;
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			unsigned int vertex = corners[corner];
+
+			if (std::find(newCache, newCache + newCacheCount, vertex) == newCache + newCacheCount)
+				newCache[newCacheCount++] = vertex;
+		}
+
+		for (unsigned int i = 0; i < cacheCount; i++)
+		{
+			unsigned int vertex = cache[i];
+
+			if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+				newCache[newCacheCount++] = vertex;
+		}
+
+		// Re-score everything whose cache position changed, including the ones that just fell out, and pass the change on to their triangles
+		for (unsigned int i = 0; i < newCacheCount; i++)
+		{
+			unsigned int vertex   = newCache[i];
+			int          position = i < kForsythCacheSize ? (int)i : -1;
+			float        score    = GetVertexScore(position, liveTriangles[vertex]);
+			float        change   = score - vertexScore[vertex];
+
+			vertexScore[vertex] = score;
+
+			const unsigned int* live = &adjacency[firstTriangle[vertex]];
+
+			for (unsigned int j = 0; j < liveTriangles[vertex]; j++)
+			{
+				triangleScore[live[j]] += change;
+			}
+		}
+
+		cacheCount = newCacheCount < kForsythCacheSize ? newCacheCount : kForsythCacheSize;
+		std::copy(newCache, newCache + cacheCount, cache);
+
+		// The next triangle is almost always one that touches the cache
+		float bestScore = -1.0f;
+		bestTriangle    = kNoTriangle;
+
+		for (unsigned int i = 0; i < cacheCount; i++)
+		{
+			unsigned int        vertex = cache[i];
+			const unsigned int* live   = &adjacency[firstTriangle[vertex]];
+
+			for (unsigned int j = 0; j < liveTriangles[vertex]; j++)
+			{
+				if (triangleScore[live[j]] > bestScore)
+				{
+					bestScore    = triangleScore[live[j]];
+					bestTriangle = live[j];
+				}
+			}
+		}
+
+		// Otherwise the cache has run dry - start again from the next undrawn triangle in the original order
+		if (bestTriangle == kNoTriangle)
+		{
+			while (scanCursor < triangleCount && triangleDrawn[scanCursor])
+				scanCursor++;
+
+			if (scanCursor < triangleCount)
+				bestTriangle = scanCursor;
+		}
+	}
+
+	indices.swap(output);
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+void MeshOptimiser::OptimiseOverdraw(std::vector<unsigned int>& indices, const std::vector<VertexData>& vertices, float threshold)
+{
+	unsigned int triangleCount = (unsigned int)(indices.size() / 3);
+
+	if (indices.size() % 3 != 0 || triangleCount == 0)
+		return;
+
+	// Hard boundaries - triangles that miss on all three vertices share nothing with what came before, so the cache is cold anyway
+	std::vector<unsigned int> hardClusters;
+
+	{
+		FifoCacheSimulator cacheSimulator((unsigned int)vertices.size(), kAnalysisCacheSize);
+
+		for (unsigned int triangle = 0; triangle < triangleCount; triangle++)
+		{
+			if (cacheSimulator.AccessTriangle(&indices[triangle * 3]) == 3)
+				hardClusters.push_back(triangle);
+		}
+
+		// The very first triangle is always a full miss, so hardClusters[0] is 0
+		hardClusters.push_back(triangleCount);
+	}
+
+	// Soft boundaries - split a cluster further wherever the part so far, started from a cold cache, is already within the threshold
+	// of what the whole cluster manages. Moving the parts around then costs at most that much.
+	std::vector<unsigned int> clusters;
+
+	{
+		FifoCacheSimulator cacheSimulator((unsigned int)vertices.size(), kAnalysisCacheSize);
+
+		for (size_t cluster = 0; cluster + 1 < hardClusters.size(); cluster++)
+		{
+			unsigned int start = hardClusters[cluster];
+			unsigned int end   = hardClusters[cluster + 1];
+
+			unsigned int clusterMisses = 0;
+
+			cacheSimulator.Flush();
+
+			for (unsigned int triangle = start; triangle < end; triangle++)
+			{
+				clusterMisses += cacheSimulator.AccessTriangle(&indices[triangle * 3]);
+			}
+
+			float limit = threshold * (float)clusterMisses / (float)(end - start);
+
+			unsigned int runMisses    = 0;
+			unsigned int runTriangles = 0;
+
+			clusters.push_back(start);
+			cacheSimulator.Flush();
+
+			for (unsigned int triangle = start; triangle < end; triangle++)
+			{
+				runMisses += cacheSimulator.AccessTriangle(&indices[triangle * 3]);
+				runTriangles++;
+
+				if (triangle + 1 < end && (float)runMisses <= limit * (float)runTriangles)
+				{
+					clusters.push_back(triangle + 1);
+					cacheSimulator.Flush();
+
+					runMisses    = 0;
+					runTriangles = 0;
+				}
+			}
+		}
+
+		clusters.push_back(triangleCount);
+	}
+
+	unsigned int clusterCount = (unsigned int)clusters.size() - 1;
+
+	// Area weighted centroid and normal of each cluster, and of the whole mesh
+	std::vector<DirectX::XMFLOAT3> clusterCentroids(clusterCount);
+	std::vector<DirectX::XMFLOAT3> clusterNormals(clusterCount);
+	DirectX::XMFLOAT3              meshCentroid(0.0f, 0.0f, 0.0f);
+	float                          meshArea = 0.0f;
+
+	for (unsigned int cluster = 0; cluster < clusterCount; cluster++)
+	{
+		DirectX::XMFLOAT3 centroid(0.0f, 0.0f, 0.0f);
+		DirectX::XMFLOAT3 normal(0.0f, 0.0f, 0.0f);
+		float             area = 0.0f;
+
+		for (unsigned int triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++)
+		{
+			const DirectX::XMFLOAT3& a = vertices[indices[triangle * 3 + 0]].vertexPosition;
+			const DirectX::XMFLOAT3& b = vertices[indices[triangle * 3 + 1]].vertexPosition;
+			const DirectX::XMFLOAT3& c = vertices[indices[triangle * 3 + 2]].vertexPosition;
+
+			float abX = b.x - a.x, abY = b.y - a.y, abZ = b.z - a.z;
+			float acX = c.x - a.x, acY = c.y - a.y, acZ = c.z - a.z;
+
+			// Twice the area, pointing out of the front face for clockwise winding
+			float crossX = abY * acZ - abZ * acY;
+			float crossY = abZ * acX - abX * acZ;
+			float crossZ = abX * acY - abY * acX;
+
+			float triangleArea = sqrtf(crossX * crossX + crossY * crossY + crossZ * crossZ);
+
+			centroid.x += (a.x + b.x + c.x) * triangleArea;
+			centroid.y += (a.y + b.y + c.y) * triangleArea;
+			centroid.z += (a.z + b.z + c.z) * triangleArea;
+
+			normal.x   += crossX;
+			normal.y   += crossY;
+			normal.z   += crossZ;
+
+			area       += triangleArea;
+		}
+
+		meshCentroid.x += centroid.x;
+		meshCentroid.y += centroid.y;
+		meshCentroid.z += centroid.z;
+		meshArea       += area;
+
+		float scale = area > 0.0f ? 1.0f / (area * 3.0f) : 0.0f;
+
+		clusterCentroids[cluster] = DirectX::XMFLOAT3(centroid.x * scale, centroid.y * scale, centroid.z * scale);
+		clusterNormals[cluster]   = normal;
+	}
+
+	float meshScale = meshArea > 0.0f ? 1.0f / (meshArea * 3.0f) : 0.0f;
+
+	meshCentroid.x *= meshScale;
+	meshCentroid.y *= meshScale;
+	meshCentroid.z *= meshScale;
+
+	// How far each cluster faces away from the centre of the mesh
+	std::vector<float>        clusterSortKeys(clusterCount);
+	std::vector<unsigned int> clusterOrder(clusterCount);
+
+	for (unsigned int cluster = 0; cluster < clusterCount; cluster++)
+	{
+		const DirectX::XMFLOAT3& centroid = clusterCentroids[cluster];
+		const DirectX::XMFLOAT3& normal   = clusterNormals[cluster];
+
+		float length = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		float dot    = (centroid.x - meshCentroid.x) * normal.x + (centroid.y - meshCentroid.y) * normal.y + (centroid.z - meshCentroid.z) * normal.z;
+
+		clusterSortKeys[cluster] = length > 0.0f ? dot / length : 0.0f;
+		clusterOrder[cluster]    = cluster;
+	}
+
+	// Stable so that the result does not depend on the sort implementation
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](unsigned int a, unsigned int b) { return clusterSortKeys[a] > clusterSortKeys[b]; });
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+
+	for (unsigned int cluster : clusterOrder)
+	{
+		output.insert(output.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+	}
+
+	indices.swap(output);
+}
+
+// -------------------------------------------------------------------- //
+
+void MeshOptimiser::OptimiseVertexFetch(std::vector<VertexData>& vertices, std::vector<unsigned int>& indices)
+{
+	const unsigned int kUnused = ~0u;
+
+	std::vector<unsigned int> remap(vertices.size(), kUnused);
+	std::vector<VertexData>   reordered;
+
+	reordered.reserve(vertices.size());
+
+	for (unsigned int& index : indices)
+	{
+		if (remap[index] == kUnused)
+		{
+			remap[index] = (unsigned int)reordered.size();
+			reordered.push_back(vertices[index]);
+		}
+
+		index = remap[index];
+	}
+
+	vertices.swap(reordered);
+}
+
+// -------------------------------------------------------------------- //
+
+VertexCacheStats MeshOptimiser::AnalyseVertexCache(const std::vector<unsigned int>& indices, unsigned int vertexCount, unsigned int cacheSize)
+{
+	VertexCacheStats stats;
+	stats.acmr = 0.0f;
+	stats.atvr = 0.0f;
+
+	if (indices.empty())
+		return stats;
+
+	FifoCacheSimulator         cacheSimulator(vertexCount, cacheSize);
+	std::vector<unsigned char> referenced(vertexCount, 0);
+
+	unsigned int misses          = 0;
+	unsigned int referencedCount = 0;
+
+	for (unsigned int index : indices)
+	{
+		if (cacheSimulator.Access(index))
+			misses++;
+
+		if (!referenced[index])
+		{
+			referenced[index] = 1;
+			referencedCount++;
+		}
+	}
+
+	stats.acmr = (float)misses / (float)(indices.size() / 3);
+	stats.atvr = (float)misses / (float)referencedCount;
+
+	return stats;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,41 @@
+#ifndef _MESH_OPTIMISER_H_
+#define _MESH_OPTIMISER_H_
+
+#include <vector>
+
+#include "Model.h"
+
+// -------------------------------------------------------------------- //
+
+// Reorders triangle lists so that they draw efficiently - indices for the post-transform vertex cache, optionally clusters of triangles
+// to reduce overdraw, then vertices into the order they are first used so that vertex fetch walks memory forwards.
+// Every stage only reorders - the mesh that gets drawn is the same one.
+struct MeshOptimiser final
+{
+public:
+	// Runs every stage in order. Returns false, leaving the mesh alone, if it is not a triangle list or an index is out of range.
+	static bool             Optimise(std::vector<VertexData>& vertices, std::vector<unsigned int>& indices, bool optimiseOverdraw, MeshOptimisationStats& statsOut);
+
+	// Tom Forsyth's linear-speed vertex cache optimisation - triangles are picked greedily by how many of their vertices are already
+	// in a simulated LRU cache, with a bonus for vertices that have few triangles left so that none are left stranded.
+	static bool             OptimiseVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount);
+
+	// Sander et al.'s clustering - splits the cache-optimised order into runs that can be moved without costing more than the threshold
+	// in ACMR (1.05 allows 5% worse), then draws the runs that face away from the mesh's centre first, as they tend to occlude the rest.
+	// Expects OptimiseVertexCache() to have been run first.
+	static void             OptimiseOverdraw(std::vector<unsigned int>& indices, const std::vector<VertexData>& vertices, float threshold);
+
+	// Puts vertices in the order they are first referenced and remaps the indices to match. Unreferenced vertices are dropped.
+	static void             OptimiseVertexFetch(std::vector<VertexData>& vertices, std::vector<unsigned int>& indices);
+
+	static VertexCacheStats AnalyseVertexCache(const std::vector<unsigned int>& indices, unsigned int vertexCount, unsigned int cacheSize = kAnalysisCacheSize);
+
+	// Size of the FIFO cache the analysis and the overdraw clustering assume - a conservative figure for current hardware
+	static const unsigned int kAnalysisCacheSize        = 16;
+
+	static constexpr float    kDefaultOverdrawThreshold = 1.05f;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
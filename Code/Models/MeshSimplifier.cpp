@@ -0,0 +1,711 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+#include "MeshOptimiser.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const unsigned int  kNoPoint             = ~0u;
+	const unsigned int  kNoVertex            = ~0u;
+
+	// Border planes count for this much more than surface ones, so that outlines and holes keep their shape
+	const double        kBorderWeight        = 10.0;
+
+	// Each level aims for this fraction of the one before, and is dropped if it cannot get below the minimum
+	const float         kLodReduction        = 0.5f;
+	const float         kMinimumLodReduction = 0.9f;
+
+	const unsigned char kPointIsBorder       = 1 << 0;
+	const unsigned char kPointIsLocked       = 1 << 1; // On a non-manifold edge - left where it is
+
+	// Sum of squared distances to a set of weighted planes, as the 4x4 symmetric matrix A, b, c
+	struct Quadric final
+	{
+		double a00, a11, a22, a01, a02, a12;
+		double b0, b1, b2;
+		double c;
+		double weight;
+	};
+
+	struct Edge final
+	{
+		unsigned int pointA;
+		unsigned int pointB;
+		unsigned int triangle; // The lowest numbered triangle using the edge
+		unsigned int useCount; // 1 on a border, more than 2 where the mesh is not manifold
+	};
+
+	struct Collapse final
+	{
+		unsigned int from;
+		unsigned int to;
+		float        cost;
+	};
+
+	// -------------------------------------------------------------------- //
+
+	void AddPlane(Quadric& quadric, double normalX, double normalY, double normalZ, double distance, double weight)
+	{
+		quadric.a00    += weight * normalX * normalX;
+		quadric.a11    += weight * normalY * normalY;
+		quadric.a22    += weight * normalZ * normalZ;
+		quadric.a01    += weight * normalX * normalY;
+		quadric.a02    += weight * normalX * normalZ;
+		quadric.a12    += weight * normalY * normalZ;
+		quadric.b0     += weight * normalX * distance;
+		quadric.b1     += weight * normalY * distance;
+		quadric.b2     += weight * normalZ * distance;
+		quadric.c      += weight * distance * distance;
+		quadric.weight += weight;
+	}
+
+	void AddQuadric(Quadric& quadric, const Quadric& other)
+	{
+		quadric.a00    += other.a00;
+		quadric.a11    += other.a11;
+		quadric.a22    += other.a22;
+		quadric.a01    += other.a01;
+		quadric.a02    += other.a02;
+		quadric.a12    += other.a12;
+		quadric.b0     += other.b0;
+		quadric.b1     += other.b1;
+		quadric.b2     += other.b2;
+		quadric.c      += other.c;
+		quadric.weight += other.weight;
+	}
+
+	// Weighted mean of the squared distances, so that the result is in model units squared however large the area behind it
+	double GetError(const Quadric& quadric, const DirectX::XMFLOAT3& position)
+	{
+		double x = position.x;
+		double y = position.y;
+		double z = position.z;
+
+		double error = quadric.a00 * x * x + quadric.a11 * y * y + quadric.a22 * z * z
+		             + 2.0 * (quadric.a01 * x * y + quadric.a02 * x * z + quadric.a12 * y * z)
+		             + 2.0 * (quadric.b0 * x + quadric.b1 * y + quadric.b2 * z)
+		             + quadric.c;
+
+		if (error <= 0.0 || quadric.weight <= 0.0)
+			return 0.0;
+
+		return error / quadric.weight;
+	}
+
+	// -------------------------------------------------------------------- //
+
+	void GetTriangleNormal(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b, const DirectX::XMFLOAT3& c, double (&normalOut)[3])
+	{
+		double abX = (double)b.x - a.x, abY = (double)b.y - a.y, abZ = (double)b.z - a.z;
+		double acX = (double)c.x - a.x, acY = (double)c.y - a.y, acZ = (double)c.z - a.z;
+
+		normalOut[0] = abY * acZ - abZ * acY;
+		normalOut[1] = abZ * acX - abX * acZ;
+		normalOut[2] = abX * acY - abY * acX;
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Triangles around each point, packed into one array
+	void BuildPointTriangles(const std::vector<unsigned int>& triangles,
+		                     const std::vector<unsigned int>& vertexPoint,
+		                     std::vector<unsigned int>&       pointFirstTriangleOut,
+		                     std::vector<unsigned int>&       pointTrianglesOut)
+	{
+		std::fill(pointFirstTriangleOut.begin(), pointFirstTriangleOut.end(), 0u);
+
+		for (unsigned int index : triangles)
+		{
+			pointFirstTriangleOut[vertexPoint[index] + 1]++;
+		}
+
+		for (size_t point = 1; point < pointFirstTriangleOut.size(); point++)
+		{
+			pointFirstTriangleOut[point] += pointFirstTriangleOut[point - 1];
+		}
+
+		pointTrianglesOut.resize(triangles.size());
+
+		std::vector<unsigned int> fillCursor(pointFirstTriangleOut.begin(), pointFirstTriangleOut.end() - 1);
+
+		for (unsigned int triangle = 0; triangle < triangles.size() / 3; triangle++)
+		{
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				pointTrianglesOut[fillCursor[vertexPoint[triangles[triangle * 3 + corner]]]++] = triangle;
+			}
+		}
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Every edge once, in the order of the triangles that first use them. Found by looking through the triangles around one end
+	// rather than by sorting, which keeps it linear.
+	void BuildEdges(const std::vector<unsigned int>& triangles,
+		            const std::vector<unsigned int>& vertexPoint,
+		            const std::vector<unsigned int>& pointFirstTriangle,
+		            const std::vector<unsigned int>& pointTriangles,
+		            std::vector<Edge>&               edgesOut)
+	{
+		edgesOut.clear();
+
+		for (unsigned int triangle = 0; triangle < triangles.size() / 3; triangle++)
+		{
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				unsigned int pointA = vertexPoint[triangles[triangle * 3 + corner]];
+				unsigned int pointB = vertexPoint[triangles[triangle * 3 + (corner + 1) % 3]];
+
+				Edge edge;
+				edge.pointA   = pointA;
+				edge.pointB   = pointB;
+				edge.triangle = triangle;
+				edge.useCount = 0;
+
+				for (unsigned int i = pointFirstTriangle[pointA]; i < pointFirstTriangle[pointA + 1]; i++)
+				{
+					unsigned int        other   = pointTriangles[i];
+					const unsigned int* corners = &triangles[other * 3];
+
+					if (vertexPoint[corners[0]] != pointB && vertexPoint[corners[1]] != pointB && vertexPoint[corners[2]] != pointB)
+						continue;
+
+					edge.useCount++;
+					edge.triangle = other < edge.triangle ? other : edge.triangle;
+				}
+
+				if (edge.triangle == triangle)
+					edgesOut.push_back(edge);
+			}
+		}
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Stable radix sort on the cost - the costs are never negative, so their bits sort the same way as their values. Ties stay
+	// in the order the candidates were found, which is what keeps the result the same on every run.
+	void SortCollapses(std::vector<Collapse>& collapses, std::vector<Collapse>& scratch)
+	{
+		const unsigned int kRadixBits = 11;
+		const unsigned int kRadixSize = 1 << kRadixBits;
+
+		scratch.resize(collapses.size());
+
+		for (unsigned int shift = 0; shift < 32; shift += kRadixBits)
+		{
+			unsigned int counts[kRadixSize] = {};
+
+			for (const Collapse& collapse : collapses)
+			{
+				unsigned int bits;
+				memcpy(&bits, &collapse.cost, sizeof(bits));
+
+				counts[(bits >> shift) & (kRadixSize - 1)]++;
+			}
+
+			unsigned int total = 0;
+
+			for (unsigned int bucket = 0; bucket < kRadixSize; bucket++)
+			{
+				unsigned int count = counts[bucket];
+				counts[bucket]     = total;
+				total             += count;
+			}
+
+			for (const Collapse& collapse : collapses)
+			{
+				unsigned int bits;
+				memcpy(&bits, &collapse.cost, sizeof(bits));
+
+				scratch[counts[(bits >> shift) & (kRadixSize - 1)]++] = collapse;
+			}
+
+			collapses.swap(scratch);
+		}
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Moving from onto to must not turn any of from's remaining triangles over, or fold them close to it
+	bool GetIsCollapseValid(unsigned int                             from,
+		                    unsigned int                             to,
+		                    const std::vector<unsigned int>&         triangles,
+		                    const std::vector<unsigned int>&         vertexPoint,
+		                    const std::vector<DirectX::XMFLOAT3>&    pointPositions,
+		                    const unsigned int*                      pointTriangles,
+		                    unsigned int                             pointTriangleCount)
+	{
+		for (unsigned int i = 0; i < pointTriangleCount; i++)
+		{
+			const unsigned int* corners = &triangles[pointTriangles[i] * 3];
+
+			unsigned int points[3] = { vertexPoint[corners[0]], vertexPoint[corners[1]], vertexPoint[corners[2]] };
+
+			// Triangles along the collapsed edge disappear, so they cannot flip
+			if (points[0] == to || points[1] == to || points[2] == to)
+				continue;
+
+			DirectX::XMFLOAT3 moved[3];
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				moved[corner] = pointPositions[points[corner] == from ? to : points[corner]];
+			}
+
+			double before[3];
+			double after[3];
+
+			GetTriangleNormal(pointPositions[points[0]], pointPositions[points[1]], pointPositions[points[2]], before);
+			GetTriangleNormal(moved[0], moved[1], moved[2], after);
+
+			double dot          = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+			double beforeLength = sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2]);
+			double afterLength  = sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+
+			// Reject anything that would turn a triangle by more than about 75 degrees
+			if (dot <= 0.25 * beforeLength * afterLength)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+float MeshSimplifier::Simplify(const std::vector<VertexData>& vertices, const std::vector<unsigned int>& indices, unsigned int targetIndexCount, float maxError, std::vector<unsigned int>& indicesOut)
+{
+	unsigned int vertexCount = (unsigned int)vertices.size();
+
+	// Group the vertices that share a position into points - collapses happen between points, so that a hard edge (the same
+	// position with different normals) moves as one. Points are numbered in the order their first vertex appears.
+	std::vector<unsigned int>      vertexPoint(vertexCount);
+	std::vector<DirectX::XMFLOAT3> pointPositions;
+
+	{
+		unsigned int tableSize = 1;
+
+		while (tableSize < vertexCount * 2)
+			tableSize <<= 1;
+
+		std::vector<unsigned int> table(tableSize, kNoVertex);
+
+		for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+		{
+			unsigned int bits[3];
+			memcpy(bits, &vertices[vertex].vertexPosition, sizeof(bits));
+
+			unsigned int slot = ((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u)) & (tableSize - 1);
+
+			while (table[slot] != kNoVertex && memcmp(&vertices[table[slot]].vertexPosition, bits, sizeof(bits)) != 0)
+				slot = (slot + 1) & (tableSize - 1);
+
+			if (table[slot] == kNoVertex)
+			{
+				table[slot] = vertex;
+				vertexPoint[vertex] = (unsigned int)pointPositions.size();
+				pointPositions.push_back(vertices[vertex].vertexPosition);
+			}
+			else
+			{
+				vertexPoint[vertex] = vertexPoint[table[slot]];
+			}
+		}
+	}
+
+	unsigned int pointCount = (unsigned int)pointPositions.size();
+
+	// The vertices at each point
+	std::vector<unsigned int> pointFirstVertex(pointCount + 1, 0);
+	std::vector<unsigned int> pointVertices(vertexCount);
+
+	for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+	{
+		pointFirstVertex[vertexPoint[vertex] + 1]++;
+	}
+
+	for (unsigned int point = 0; point < pointCount; point++)
+	{
+		pointFirstVertex[point + 1] += pointFirstVertex[point];
+	}
+
+	{
+		std::vector<unsigned int> fillCursor(pointFirstVertex.begin(), pointFirstVertex.end() - 1);
+
+		for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+		{
+			pointVertices[fillCursor[vertexPoint[vertex]]++] = vertex;
+		}
+	}
+
+	// Work on a copy with any already-degenerate triangles taken out
+	std::vector<unsigned int> triangles;
+	triangles.reserve(indices.size());
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		unsigned int a = vertexPoint[indices[i]];
+		unsigned int b = vertexPoint[indices[i + 1]];
+		unsigned int c = vertexPoint[indices[i + 2]];
+
+		if (a != b && b != c && a != c)
+			triangles.insert(triangles.end(), indices.begin() + i, indices.begin() + i + 3);
+	}
+
+	std::vector<unsigned int> pointFirstTriangle(pointCount + 1);
+	std::vector<unsigned int> pointTriangles;
+	std::vector<Edge>         edges;
+
+	BuildPointTriangles(triangles, vertexPoint, pointFirstTriangle, pointTriangles);
+	BuildEdges(triangles, vertexPoint, pointFirstTriangle, pointTriangles, edges);
+
+	// Each point starts with the planes of the triangles around it, weighted by area, plus planes through any border edges at
+	// right angles to the surface
+	std::vector<Quadric> quadrics(pointCount, Quadric());
+
+	for (unsigned int triangle = 0; triangle < triangles.size() / 3; triangle++)
+	{
+		unsigned int points[3] = { vertexPoint[triangles[triangle * 3]], vertexPoint[triangles[triangle * 3 + 1]], vertexPoint[triangles[triangle * 3 + 2]] };
+
+		const DirectX::XMFLOAT3& a = pointPositions[points[0]];
+
+		double normal[3];
+		GetTriangleNormal(a, pointPositions[points[1]], pointPositions[points[2]], normal);
+
+		double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+		if (length <= 0.0)
+			continue;
+
+		double normalX  = normal[0] / length;
+		double normalY  = normal[1] / length;
+		double normalZ  = normal[2] / length;
+		double distance = -(normalX * a.x + normalY * a.y + normalZ * a.z);
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			AddPlane(quadrics[points[corner]], normalX, normalY, normalZ, distance, length * 0.5);
+		}
+	}
+
+	for (const Edge& edge : edges)
+	{
+		if (edge.useCount != 1)
+			continue;
+
+		const unsigned int* corners = &triangles[edge.triangle * 3];
+
+		double triangleNormal[3];
+		GetTriangleNormal(pointPositions[vertexPoint[corners[0]]], pointPositions[vertexPoint[corners[1]]], pointPositions[vertexPoint[corners[2]]], triangleNormal);
+
+		const DirectX::XMFLOAT3& a = pointPositions[edge.pointA];
+		const DirectX::XMFLOAT3& b = pointPositions[edge.pointB];
+
+		double edgeX = (double)b.x - a.x;
+		double edgeY = (double)b.y - a.y;
+		double edgeZ = (double)b.z - a.z;
+
+		double normalX = edgeY * triangleNormal[2] - edgeZ * triangleNormal[1];
+		double normalY = edgeZ * triangleNormal[0] - edgeX * triangleNormal[2];
+		double normalZ = edgeX * triangleNormal[1] - edgeY * triangleNormal[0];
+		double length  = sqrt(normalX * normalX + normalY * normalY + normalZ * normalZ);
+
+		if (length <= 0.0)
+			continue;
+
+		normalX /= length;
+		normalY /= length;
+		normalZ /= length;
+
+		double distance = -(normalX * a.x + normalY * a.y + normalZ * a.z);
+		double weight   = (edgeX * edgeX + edgeY * edgeY + edgeZ * edgeZ) * kBorderWeight;
+
+		AddPlane(quadrics[edge.pointA], normalX, normalY, normalZ, distance, weight);
+		AddPlane(quadrics[edge.pointB], normalX, normalY, normalZ, distance, weight);
+	}
+
+	unsigned int targetTriangleCount = targetIndexCount / 3;
+	double       maxCost             = (double)maxError * (double)maxError;
+	float        reachedCost         = 0.0f;
+
+	std::vector<unsigned char> pointFlags(pointCount);
+	std::vector<unsigned char> pointTouched(pointCount);
+	std::vector<unsigned int>  pointTarget(pointCount, kNoPoint);
+	std::vector<unsigned int>  vertexTarget(vertexCount, kNoVertex);
+	std::vector<Collapse>      candidates;
+	std::vector<Collapse>      sortScratch;
+	std::vector<Collapse>      applied;
+
+	while (triangles.size() / 3 > targetTriangleCount)
+	{
+		unsigned int triangleCount = (unsigned int)(triangles.size() / 3);
+
+		// Borders and non-manifold edges change as the mesh does, so they are found again on every pass
+		std::fill(pointFlags.begin(), pointFlags.end(), (unsigned char)0);
+
+		for (const Edge& edge : edges)
+		{
+			if (edge.useCount == 1)
+			{
+				pointFlags[edge.pointA] |= kPointIsBorder;
+				pointFlags[edge.pointB] |= kPointIsBorder;
+			}
+			else if (edge.useCount > 2)
+			{
+				pointFlags[edge.pointA] |= kPointIsLocked;
+				pointFlags[edge.pointB] |= kPointIsLocked;
+			}
+		}
+
+		// The cheaper direction of each edge, if either is allowed
+		candidates.clear();
+
+		for (const Edge& edge : edges)
+		{
+			if (edge.useCount > 2)
+				continue;
+
+			bool         isBorderEdge = edge.useCount == 1;
+			unsigned int ends[2]      = { edge.pointA, edge.pointB };
+
+			Collapse best;
+			best.from = kNoPoint;
+			best.to   = kNoPoint;
+			best.cost = 0.0f;
+
+			double bestCost = maxCost;
+
+			// Either way round, the merged point carries both quadrics
+			Quadric combined = quadrics[edge.pointA];
+			AddQuadric(combined, quadrics[edge.pointB]);
+
+			for (unsigned int direction = 0; direction < 2; direction++)
+			{
+				unsigned int from = ends[direction];
+				unsigned int to   = ends[1 - direction];
+
+				// Border points may only slide along the border, or the outline would be pulled in
+				if ((pointFlags[from] & kPointIsLocked) || ((pointFlags[from] & kPointIsBorder) && !isBorderEdge))
+					continue;
+
+				double cost = GetError(combined, pointPositions[to]);
+
+				if (cost <= bestCost && (best.from == kNoPoint || cost < bestCost))
+				{
+					best.from = from;
+					best.to   = to;
+					best.cost = (float)cost;
+					bestCost  = cost;
+				}
+			}
+
+			if (best.from != kNoPoint)
+				candidates.push_back(best);
+		}
+
+		SortCollapses(candidates, sortScratch);
+
+		// Take the cheapest collapses that do not share any triangles with one already taken this pass - everything around a
+		// collapse is touched, so the checks on later ones are never made against triangles that have since moved
+		std::fill(pointTouched.begin(), pointTouched.end(), (unsigned char)0);
+		applied.clear();
+
+		unsigned int removedTriangles = 0;
+		unsigned int wantedTriangles  = triangleCount - targetTriangleCount;
+
+		for (const Collapse& collapse : candidates)
+		{
+			if (removedTriangles >= wantedTriangles)
+				break;
+
+			if (pointTouched[collapse.from] || pointTouched[collapse.to])
+				continue;
+
+			const unsigned int* fromTriangles     = &pointTriangles[pointFirstTriangle[collapse.from]];
+			unsigned int        fromTriangleCount = pointFirstTriangle[collapse.from + 1] - pointFirstTriangle[collapse.from];
+
+			if (!GetIsCollapseValid(collapse.from, collapse.to, triangles, vertexPoint, pointPositions, fromTriangles, fromTriangleCount))
+				continue;
+
+			for (unsigned int i = 0; i < fromTriangleCount; i++)
+			{
+				const unsigned int* corners = &triangles[fromTriangles[i] * 3];
+
+				bool sharesEdge = false;
+
+				for (unsigned int corner = 0; corner < 3; corner++)
+				{
+					unsigned int point = vertexPoint[corners[corner]];
+
+					pointTouched[point] = 1;
+					sharesEdge         |= point == collapse.to;
+				}
+
+				if (sharesEdge)
+					removedTriangles++;
+			}
+
+			pointTouched[collapse.to]  = 1;
+			pointTarget[collapse.from] = collapse.to;
+
+			AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+
+			reachedCost = collapse.cost > reachedCost ? collapse.cost : reachedCost;
+
+			applied.push_back(collapse);
+		}
+
+		if (applied.empty())
+			break;
+
+		// Work out which vertex each moved vertex becomes. Prefer the one it shares a triangle with across the collapsed edge, so that
+		// a seam keeps its attributes on each side, and otherwise fall back to whichever vertex at the new point has the closest normal.
+		for (const Collapse& collapse : applied)
+		{
+			const unsigned int* fromTriangles     = &pointTriangles[pointFirstTriangle[collapse.from]];
+			unsigned int        fromTriangleCount = pointFirstTriangle[collapse.from + 1] - pointFirstTriangle[collapse.from];
+
+			for (unsigned int i = 0; i < fromTriangleCount; i++)
+			{
+				const unsigned int* corners = &triangles[fromTriangles[i] * 3];
+
+				for (unsigned int corner = 0; corner < 3; corner++)
+				{
+					unsigned int vertex = corners[corner];
+
+					if (vertexPoint[vertex] != collapse.from || vertexTarget[vertex] != kNoVertex)
+						continue;
+
+					for (unsigned int other = 0; other < 3; other++)
+					{
+						if (vertexPoint[corners[other]] == collapse.to)
+						{
+							vertexTarget[vertex] = corners[other];
+							break;
+						}
+					}
+				}
+			}
+
+			for (unsigned int i = pointFirstVertex[collapse.from]; i < pointFirstVertex[collapse.from + 1]; i++)
+			{
+				unsigned int vertex = pointVertices[i];
+
+				if (vertexTarget[vertex] != kNoVertex)
+					continue;
+
+				const DirectX::XMFLOAT3& normal  = vertices[vertex].normal;
+				float                    bestDot = -2.0f;
+
+				for (unsigned int j = pointFirstVertex[collapse.to]; j < pointFirstVertex[collapse.to + 1]; j++)
+				{
+					const DirectX::XMFLOAT3& candidateNormal = vertices[pointVertices[j]].normal;
+
+					float dot = normal.x * candidateNormal.x + normal.y * candidateNormal.y + normal.z * candidateNormal.z;
+
+					if (dot > bestDot)
+					{
+						bestDot              = dot;
+						vertexTarget[vertex] = pointVertices[j];
+					}
+				}
+			}
+		}
+
+		// Rewrite the triangles, dropping the ones that collapsed to a line
+		size_t kept = 0;
+
+		for (size_t i = 0; i < triangles.size(); i += 3)
+		{
+			unsigned int corners[3];
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				unsigned int vertex = triangles[i + corner];
+
+				corners[corner] = pointTarget[vertexPoint[vertex]] != kNoPoint ? vertexTarget[vertex] : vertex;
+			}
+
+			unsigned int a = vertexPoint[corners[0]];
+			unsigned int b = vertexPoint[corners[1]];
+			unsigned int c = vertexPoint[corners[2]];
+
+			if (a == b || b == c || a == c)
+				continue;
+
+			triangles[kept++] = corners[0];
+			triangles[kept++] = corners[1];
+			triangles[kept++] = corners[2];
+		}
+
+		triangles.resize(kept);
+
+		for (const Collapse& collapse : applied)
+		{
+			pointTarget[collapse.from] = kNoPoint;
+
+			for (unsigned int i = pointFirstVertex[collapse.from]; i < pointFirstVertex[collapse.from + 1]; i++)
+			{
+				vertexTarget[pointVertices[i]] = kNoVertex;
+			}
+		}
+
+		BuildPointTriangles(triangles, vertexPoint, pointFirstTriangle, pointTriangles);
+		BuildEdges(triangles, vertexPoint, pointFirstTriangle, pointTriangles, edges);
+	}
+
+	indicesOut.swap(triangles);
+
+	return sqrtf(reachedCost);
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int MeshSimplifier::GenerateLods(const std::vector<VertexData>& vertices, std::vector<unsigned int>& indices, float maxError, MeshLod* lodsOut, unsigned int maxLodCount)
+{
+	if (maxLodCount == 0)
+		return 0;
+
+	lodsOut[0].firstIndex = 0;
+	lodsOut[0].indexCount = (unsigned int)indices.size();
+	lodsOut[0].error      = 0.0f;
+
+	unsigned int              lodCount = 1;
+	float                     error    = 0.0f;
+	std::vector<unsigned int> previous(indices);
+	std::vector<unsigned int> simplified;
+
+	while (lodCount < maxLodCount && error < maxError)
+	{
+		unsigned int targetIndexCount = (unsigned int)((float)(previous.size() / 3) * kLodReduction) * 3;
+
+		// Each level is made from the last one, which is much quicker than starting from full detail every time. Its error is measured
+		// against the last level too, so adding them up gives a bound on how far it is from the full detail mesh.
+		float levelError = Simplify(vertices, previous, targetIndexCount, maxError - error, simplified);
+
+		if ((float)simplified.size() > (float)previous.size() * kMinimumLodReduction)
+			break;
+
+		MeshOptimiser::OptimiseVertexCache(simplified, (unsigned int)vertices.size());
+
+		error += levelError;
+
+		lodsOut[lodCount].firstIndex = (unsigned int)indices.size();
+		lodsOut[lodCount].indexCount = (unsigned int)simplified.size();
+		lodsOut[lodCount].error      = error;
+
+		indices.insert(indices.end(), simplified.begin(), simplified.end());
+		previous.swap(simplified);
+
+		lodCount++;
+	}
+
+	return lodCount;
+}
+
+// -------------------------------------------------------------------- //
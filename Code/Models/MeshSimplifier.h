@@ -0,0 +1,37 @@
+#ifndef _MESH_SIMPLIFIER_H_
+#define _MESH_SIMPLIFIER_H_
+
+#include <vector>
+
+#include "Model.h"
+
+// -------------------------------------------------------------------- //
+
+// Quadric error metric simplifier (Garland & Heckbert) using half-edge collapses, so every level of detail indexes the same vertex buffer.
+// Vertices that share a position are moved together so that hard edges do not tear, and open borders only ever slide along themselves.
+// Each pass sorts the candidate collapses by cost (breaking ties on vertex numbers) and applies the cheapest ones that do not touch each
+// other, which keeps the result identical from run to run and machine to machine.
+struct MeshSimplifier final
+{
+public:
+	// Collapses edges until the mesh is down to targetIndexCount indices, or the next collapse would move the surface further than
+	// maxError (in model units). Returns the largest error reached.
+	static float        Simplify(const std::vector<VertexData>&   vertices,
+		                         const std::vector<unsigned int>& indices,
+		                         unsigned int                     targetIndexCount,
+		                         float                            maxError,
+		                         std::vector<unsigned int>&       indicesOut);
+
+	// indices holds the full detail mesh on entry. Each further level halves the one before and is appended to the end of indices,
+	// already optimised for the vertex cache. Stops early once a level cannot be reduced much further within maxError.
+	// Returns the number of levels filled in, including the full detail one.
+	static unsigned int GenerateLods(const std::vector<VertexData>& vertices,
+		                             std::vector<unsigned int>&     indices,
+		                             float                          maxError,
+		                             MeshLod*                       lodsOut,
+		                             unsigned int                   maxLodCount);
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,349 @@
+#include "Meshlet.h"
+
+#include <math.h>
+#include <string.h>
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// Fills in the bounds of a finished meshlet from its triangles
+	void CalculateMeshletBounds(const VertexData* vertices, const unsigned int* indices, Meshlet& meshlet)
+	{
+		const unsigned int* first = indices + meshlet.firstIndex;
+		const unsigned int* end   = first + meshlet.indexCount;
+
+		// Bounding sphere around the centre of the box - not the smallest possible, but close for the flat patches meshlets tend to be
+		DirectX::XMFLOAT3 boxMin = vertices[*first].vertexPosition;
+		DirectX::XMFLOAT3 boxMax = boxMin;
+
+		for (const unsigned int* index = first; index < end; index++)
+		{
+			const DirectX::XMFLOAT3& position = vertices[*index].vertexPosition;
+
+			boxMin.x = fminf(boxMin.x, position.x); boxMax.x = fmaxf(boxMax.x, position.x);
+			boxMin.y = fminf(boxMin.y, position.y); boxMax.y = fmaxf(boxMax.y, position.y);
+			boxMin.z = fminf(boxMin.z, position.z); boxMax.z = fmaxf(boxMax.z, position.z);
+		}
+
+		Vector3D centre((boxMin.x + boxMax.x) * 0.5f, (boxMin.y + boxMax.y) * 0.5f, (boxMin.z + boxMax.z) * 0.5f);
+		float    radiusSquared = 0.0f;
+
+		for (const unsigned int* index = first; index < end; index++)
+		{
+			const DirectX::XMFLOAT3& position = vertices[*index].vertexPosition;
+
+			radiusSquared = fmaxf(radiusSquared, Vector3D(position.x - centre.x, position.y - centre.y, position.z - centre.z).LengthSquared());
+		}
+
+		// The cone axis is the average of the triangles' facing directions
+		Vector3D normalSum(0.0f, 0.0f, 0.0f);
+
+		for (const unsigned int* index = first; index < end; index += 3)
+		{
+			const DirectX::XMFLOAT3& a = vertices[index[0]].vertexPosition;
+			const DirectX::XMFLOAT3& b = vertices[index[1]].vertexPosition;
+			const DirectX::XMFLOAT3& c = vertices[index[2]].vertexPosition;
+
+			// Clockwise winding is front facing, so this points out of the front face
+			Vector3D normal = Vector3D(b.x - a.x, b.y - a.y, b.z - a.z).Cross(Vector3D(c.x - a.x, c.y - a.y, c.z - a.z));
+			float    length = normal.Length();
+
+			// Zero area triangles are never drawn, so they do not widen the cone
+			if (length > 0.0f)
+				normalSum += normal / length;
+		}
+
+		meshlet.centre     = DirectX::XMFLOAT3(centre.x, centre.y, centre.z);
+		meshlet.radius     = sqrtf(radiusSquared);
+		meshlet.coneAxis   = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		meshlet.coneCutoff = 1.0f;
+
+		float sumLength = normalSum.Length();
+
+		if (sumLength <= 0.0f)
+			return;
+
+		Vector3D axis    = normalSum / sumLength;
+		float    minimum = 1.0f;
+
+		for (const unsigned int* index = first; index < end; index += 3)
+		{
+			const DirectX::XMFLOAT3& a = vertices[index[0]].vertexPosition;
+			const DirectX::XMFLOAT3& b = vertices[index[1]].vertexPosition;
+			const DirectX::XMFLOAT3& c = vertices[index[2]].vertexPosition;
+
+			Vector3D normal = Vector3D(b.x - a.x, b.y - a.y, b.z - a.z).Cross(Vector3D(c.x - a.x, c.y - a.y, c.z - a.z));
+			float    length = normal.Length();
+
+			if (length > 0.0f)
+				minimum = fminf(minimum, normal.Dot(axis) / length);
+		}
+
+		meshlet.coneAxis = DirectX::XMFLOAT3(axis.x, axis.y, axis.z);
+
+		// Normals spread over more than a hemisphere - some triangle will always face the camera
+		if (minimum <= 0.0f)
+			return;
+
+		// The cluster faces away once the view direction is within (90 degrees - spread) of the axis, and cos(90 - spread) = sin(spread)
+		meshlet.coneCutoff = sqrtf(fmaxf(0.0f, 1.0f - minimum * minimum));
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+void MeshletBuilder::Build(const std::vector<VertexData>& vertices, std::vector<unsigned int>& indices, unsigned int firstIndex, unsigned int indexCount, std::vector<Meshlet>& meshletsOut)
+{
+	unsigned int triangleCount = indexCount / 3;
+	unsigned int vertexCount   = (unsigned int)vertices.size();
+
+	if (triangleCount == 0 || (unsigned long long)firstIndex + indexCount > indices.size())
+		return;
+
+	const unsigned int* rangeIndices = indices.data() + firstIndex;
+
+	// Triangles using each vertex, as offsets into one shared list
+	std::vector<unsigned int> vertexTriangleStart(vertexCount + 1, 0);
+	std::vector<unsigned int> vertexTriangles(triangleCount * 3);
+
+	for (unsigned int i = 0; i < triangleCount * 3; i++)
+		vertexTriangleStart[rangeIndices[i] + 1]++;
+
+	for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+		vertexTriangleStart[vertex + 1] += vertexTriangleStart[vertex];
+
+	{
+		std::vector<unsigned int> fillPosition(vertexTriangleStart.begin(), vertexTriangleStart.end() - 1);
+
+		for (unsigned int i = 0; i < triangleCount * 3; i++)
+			vertexTriangles[fillPosition[rangeIndices[i]]++] = i / 3;
+	}
+
+	std::vector<unsigned int> reordered;
+	std::vector<unsigned int> candidates;
+	std::vector<bool>         triangleUsed(triangleCount, false);
+
+	// Which meshlet each vertex was last added to, so that counting a triangle's new vertices is three array reads
+	std::vector<unsigned int> vertexMeshlet(vertexCount, ~0u);
+
+	reordered.reserve(triangleCount * 3);
+
+	Meshlet      meshlet         = {};
+	unsigned int meshletNumber   = 0;
+	unsigned int meshletVertices = 0;
+	unsigned int nextSeed        = 0;
+
+	meshlet.firstIndex = firstIndex;
+
+	auto countNewVertices = [&](unsigned int triangle)
+	{
+		const unsigned int* corners = rangeIndices + triangle * 3;
+		unsigned int        count   = 0;
+
+		count += vertexMeshlet[corners[0]] != meshletNumber;
+		count += vertexMeshlet[corners[1]] != meshletNumber && corners[1] != corners[0];
+		count += vertexMeshlet[corners[2]] != meshletNumber && corners[2] != corners[0] && corners[2] != corners[1];
+
+		return count;
+	};
+
+	for (unsigned int added = 0; added < triangleCount; added++)
+	{
+		// Grow from the triangles touching the meshlet, preferring the ones that bring the fewest new vertices - this keeps meshlets
+		// round rather than long strips, which makes for tighter spheres and narrower cones. Ties go to the earliest in the existing order.
+		unsigned int best          = ~0u;
+		unsigned int bestNew       = 4;
+		unsigned int keptCandidate = 0;
+
+		for (unsigned int triangle : candidates)
+		{
+			if (triangleUsed[triangle])
+				continue;
+
+			candidates[keptCandidate++] = triangle;
+
+			unsigned int newVertices = countNewVertices(triangle);
+
+			if (meshletVertices + newVertices <= kMeshletMaxVertices && (newVertices < bestNew || (newVertices == bestNew && triangle < best)))
+			{
+				best    = triangle;
+				bestNew = newVertices;
+			}
+		}
+
+		candidates.resize(keptCandidate);
+
+		// Nothing connected left to add, so carry on from the next triangle in the existing order
+		if (best == ~0u && candidates.empty())
+		{
+			while (triangleUsed[nextSeed])
+				nextSeed++;
+
+			if (meshletVertices + countNewVertices(nextSeed) <= kMeshletMaxVertices)
+				best = nextSeed;
+		}
+
+		// Close the meshlet if it is full, or the triangle found does not fit
+		if (best == ~0u || meshlet.indexCount == kMeshletMaxTriangles * 3)
+		{
+			meshletsOut.push_back(meshlet);
+
+			meshlet            = {};
+			meshlet.firstIndex = firstIndex + (unsigned int)reordered.size();
+			meshletVertices    = 0;
+			meshletNumber++;
+
+			candidates.clear();
+
+			if (best == ~0u)
+			{
+				while (triangleUsed[nextSeed])
+					nextSeed++;
+
+				best = nextSeed;
+			}
+		}
+
+		triangleUsed[best] = true;
+		meshlet.indexCount += 3;
+
+		for (unsigned int corner = 0; corner < 3; corner++)
+		{
+			unsigned int vertex = rangeIndices[best * 3 + corner];
+
+			reordered.push_back(vertex);
+
+			if (vertexMeshlet[vertex] == meshletNumber)
+				continue;
+
+			vertexMeshlet[vertex] = meshletNumber;
+			meshletVertices++;
+
+			for (unsigned int i = vertexTriangleStart[vertex]; i < vertexTriangleStart[vertex + 1]; i++)
+			{
+				if (!triangleUsed[vertexTriangles[i]])
+					candidates.push_back(vertexTriangles[i]);
+			}
+		}
+	}
+
+	meshletsOut.push_back(meshlet);
+
+	memcpy(indices.data() + firstIndex, reordered.data(), sizeof(unsigned int) * reordered.size());
+
+	for (size_t i = meshletsOut.size() - (meshletNumber + 1); i < meshletsOut.size(); i++)
+		CalculateMeshletBounds(vertices.data(), indices.data(), meshletsOut[i]);
+}
+
+// -------------------------------------------------------------------- //
+
+MeshletCuller::MeshletCuller()
+	: mCentres()
+	, mAxes()
+	, mRadii()
+	, mVisibilityMask()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+MeshletCuller::~MeshletCuller()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int MeshletCuller::Cull(const Meshlet* meshlets, unsigned int meshletCount, const DirectX::XMFLOAT4X4& world, const Frustum& frustum, const Vector3D& cameraPosition, std::vector<MeshletDrawRange>& drawRangesOut, MeshletCullStats* statsOut)
+{
+	MeshletCullStats stats = {};
+	stats.meshletCount     = meshletCount;
+
+	mCentres.Resize(meshletCount);
+	mAxes.Resize(meshletCount);
+	mRadii.resize(meshletCount);
+
+	// Uniform scale, so any row of the matrix gives it
+	float scale = sqrtf(world._11 * world._11 + world._12 * world._12 + world._13 * world._13);
+
+	for (unsigned int i = 0; i < meshletCount; i++)
+	{
+		const Meshlet& meshlet = meshlets[i];
+
+		mCentres.x[i] = meshlet.centre.x;
+		mCentres.y[i] = meshlet.centre.y;
+		mCentres.z[i] = meshlet.centre.z;
+
+		mAxes.x[i]    = meshlet.coneAxis.x;
+		mAxes.y[i]    = meshlet.coneAxis.y;
+		mAxes.z[i]    = meshlet.coneAxis.z;
+
+		mRadii[i]     = meshlet.radius * scale;
+	}
+
+	// Into world space - the axes only need the rotation, and the scale is divided back out so that they stay unit length
+	DirectX::XMFLOAT3X3 rotation(world._11 / scale, world._12 / scale, world._13 / scale,
+		                         world._21 / scale, world._22 / scale, world._23 / scale,
+		                         world._31 / scale, world._32 / scale, world._33 / scale);
+
+	Vector3Batch::TransformPoint(mCentres, world, mCentres);
+	Vector3Batch::Transform(mAxes, rotation, mAxes);
+
+	frustum.CullSpheres(mCentres, mRadii.data(), mVisibilityMask);
+
+	unsigned int visibleTriangles = 0;
+	size_t       firstNewRange    = drawRangesOut.size();
+
+	for (unsigned int i = 0; i < meshletCount; i++)
+	{
+		const Meshlet& meshlet   = meshlets[i];
+		unsigned int   triangles = meshlet.indexCount / 3;
+
+		stats.triangleCount += triangles;
+
+		if (!Frustum::GetIsVisible(mVisibilityMask, i))
+		{
+			stats.frustumCulledCount++;
+			stats.culledTriangleCount += triangles;
+			continue;
+		}
+
+		if (meshlet.coneCutoff < 1.0f)
+		{
+			float toCentreX = mCentres.x[i] - cameraPosition.x;
+			float toCentreY = mCentres.y[i] - cameraPosition.y;
+			float toCentreZ = mCentres.z[i] - cameraPosition.z;
+
+			float distance  = sqrtf(toCentreX * toCentreX + toCentreY * toCentreY + toCentreZ * toCentreZ);
+			float alongAxis = toCentreX * mAxes.x[i] + toCentreY * mAxes.y[i] + toCentreZ * mAxes.z[i];
+
+			if (alongAxis >= meshlet.coneCutoff * distance + mRadii[i])
+			{
+				stats.backFaceCulledCount++;
+				stats.culledTriangleCount += triangles;
+				continue;
+			}
+		}
+
+		visibleTriangles += triangles;
+
+		// Meshlets are runs of the same index data, so neighbours can be drawn together
+		if (drawRangesOut.size() > firstNewRange && drawRangesOut.back().firstIndex + drawRangesOut.back().indexCount == meshlet.firstIndex)
+		{
+			drawRangesOut.back().indexCount += meshlet.indexCount;
+		}
+		else
+		{
+			drawRangesOut.push_back({ meshlet.firstIndex, meshlet.indexCount });
+		}
+	}
+
+	if (statsOut)
+		*statsOut = stats;
+
+	return visibleTriangles;
+}
+
+// -------------------------------------------------------------------- //
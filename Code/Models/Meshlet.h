@@ -0,0 +1,99 @@
+#ifndef _MESHLET_H_
+#define _MESHLET_H_
+
+#include <vector>
+
+#include <directxmath.h>
+
+#include "Model.h"
+
+#include "../Camera/Frustum.h"
+#include "../Maths/VectorBatch.h"
+
+// -------------------------------------------------------------------- //
+
+// Small enough for a cluster's vertices to stay in the post-transform cache, and for the bounds to be tight enough to cull with
+const unsigned int kMeshletMaxVertices  = 64;
+const unsigned int kMeshletMaxTriangles = 124;
+
+// -------------------------------------------------------------------- //
+
+// A cluster of triangles that are next to each other in a model's index data, with bounds for culling it as a whole
+struct Meshlet final
+{
+	unsigned int      firstIndex;
+	unsigned int      indexCount;
+
+	DirectX::XMFLOAT3 centre;     // Bounding sphere, in model space
+	float             radius;
+
+	// Every triangle's normal is within asin(coneCutoff) of coneAxis, so the whole cluster faces away from any viewpoint for which
+	// dot(centre - viewpoint, coneAxis) >= coneCutoff * |centre - viewpoint| + radius. A cutoff of 1 means it can never be back-facing.
+	DirectX::XMFLOAT3 coneAxis;
+	float             coneCutoff;
+};
+
+// -------------------------------------------------------------------- //
+
+// A run of the index data to pass straight to ShaderHandler::DrawIndexed()
+struct MeshletDrawRange final
+{
+	unsigned int firstIndex;
+	unsigned int indexCount;
+};
+
+struct MeshletCullStats final
+{
+	unsigned int meshletCount;
+	unsigned int frustumCulledCount;
+	unsigned int backFaceCulledCount;
+
+	unsigned int triangleCount;
+	unsigned int culledTriangleCount;
+};
+
+// -------------------------------------------------------------------- //
+
+struct MeshletBuilder final
+{
+public:
+	// Splits a range of a triangle list into meshlets, appending them to meshletsOut, and reorders the triangles in the range so that
+	// each meshlet is a run of the indices. Meshlets are started in the existing order, so a cache-optimised range stays roughly so.
+	static void Build(const std::vector<VertexData>& vertices,
+		              std::vector<unsigned int>&     indices,
+		              unsigned int                   firstIndex,
+		              unsigned int                   indexCount,
+		              std::vector<Meshlet>&          meshletsOut);
+};
+
+// -------------------------------------------------------------------- //
+
+// Culls a model's meshlets against the view, a batch at a time. Keeps its working arrays between calls so that a frame's worth of
+// culling does not allocate once they have grown to fit.
+class MeshletCuller final
+{
+public:
+	MeshletCuller();
+	~MeshletCuller();
+
+	// world must be a rotation, translation and uniform scale - the cone test is not valid under shear or non-uniform scale.
+	// frustum and cameraPosition are in world space. Visible meshlets are appended to drawRangesOut, with neighbouring ones merged into a
+	// single range. Returns how many triangles were left to draw.
+	unsigned int Cull(const Meshlet*                 meshlets,
+		              unsigned int                   meshletCount,
+		              const DirectX::XMFLOAT4X4&     world,
+		              const Frustum&                 frustum,
+		              const Vector3D&                cameraPosition,
+		              std::vector<MeshletDrawRange>& drawRangesOut,
+		              MeshletCullStats*              statsOut = nullptr);
+
+private:
+	Vector3Batch              mCentres;
+	Vector3Batch              mAxes;
+	std::vector<float>        mRadii;
+	std::vector<unsigned int> mVisibilityMask;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
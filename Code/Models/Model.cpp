@@ -1,8 +1,111 @@
 #include "Model.h"
 
-#include <fstream>
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <vector>
 
+#include "MeshCache.h"
+#include "MeshOptimiser.h"
+#include "MeshSimplifier.h"
+#include "Meshlet.h"
+#include "NormalGenerator.h"
+#include "ObjParser.h"
+
+#include "../Memory/AssetArchive.h"
+#include "../Memory/MappedFile.h"
 #include "../Shaders/ShaderHandler.h"
+#include "../Threading/WorkerPool.h"
+
+// --------------------------------------------------------- //
+
+namespace
+{
+	// How far the coarsest level of detail may stray, as a fraction of the model's bounding box diagonal. SelectLod() only picks
+	// levels whose error is too small to see at the current distance, so this mostly limits how much is kept for far away.
+	const float        kMaxLodRelativeError         = 0.25f;
+
+	// Meshes with at least this many triangles have any missing normals generated over the caller's worker pool, if it gave one
+	const unsigned int kParallelNormalTriangleCount = 1u << 18;
+}
+
+// --------------------------------------------------------- //
+
+// Everything an import produces, before it is either written to a cache or copied into the model
+struct ImportedMesh final
+{
+	std::vector<VertexData>   vertices;
+	std::vector<unsigned int> indices;
+	std::vector<Meshlet>      meshlets;
+
+	MeshLod                   lods[kMaxMeshLods] = {};
+	unsigned int              lodCount           = 0;
+
+	MeshOptimisationStats     optimisationStats  = {};
+	DirectX::XMFLOAT3         boundsMin;
+	DirectX::XMFLOAT3         boundsMax;
+	unsigned long long        contentHash        = 0;
+};
+
+// --------------------------------------------------------- //
+
+namespace
+{
+	// Parses an OBJ file's contents, then optimises the result, generates its levels of detail and splits them into meshlets
+	bool ImportObj(const char* data, size_t size, WorkerPool* workerPool, ImportedMesh& meshOut)
+	{
+		std::vector<VertexData>&   vertices = meshOut.vertices;
+		std::vector<unsigned int>& indices  = meshOut.indices;
+		MeshLod*                   lods     = meshOut.lods;
+
+		if (!ObjParser::Parse(data, size, vertices, indices))
+			return false;
+
+		// Faces without "vn" references come out with zero normals - smooth them from the surrounding triangles
+		bool normalsMissing = std::any_of(vertices.begin(), vertices.end(), [](const VertexData& vertex)
+		{
+			return vertex.normal.x == 0.0f && vertex.normal.y == 0.0f && vertex.normal.z == 0.0f;
+		});
+
+		if (normalsMissing)
+		{
+			WorkerPool* normalPool = indices.size() / 3 >= kParallelNormalTriangleCount ? workerPool : nullptr;
+
+			NormalGenerator::GenerateNormals(vertices, indices, 0, (unsigned int)indices.size(), NormalWeighting::ANGLE, true, normalPool);
+		}
+
+		if (!MeshOptimiser::Optimise(vertices, indices, true, meshOut.optimisationStats))
+			return false;
+
+		// The levels of detail are appended to the full detail indices, sharing its vertices
+		DirectX::XMFLOAT3& boundsMin = meshOut.boundsMin;
+		DirectX::XMFLOAT3& boundsMax = meshOut.boundsMax;
+		MeshCache::CalculateBounds(vertices.data(), (unsigned int)vertices.size(), boundsMin, boundsMax);
+
+		float diagonal = sqrtf((boundsMax.x - boundsMin.x) * (boundsMax.x - boundsMin.x)
+		                     + (boundsMax.y - boundsMin.y) * (boundsMax.y - boundsMin.y)
+		                     + (boundsMax.z - boundsMin.z) * (boundsMax.z - boundsMin.z));
+
+		unsigned int lodCount = MeshSimplifier::GenerateLods(vertices, indices, diagonal * kMaxLodRelativeError, lods, kMaxMeshLods);
+
+		// Splitting into meshlets reorders each level's triangles, so the vertex cache figures are taken again afterwards
+		for (unsigned int lod = 0; lod < lodCount; lod++)
+		{
+			lods[lod].firstMeshlet = (unsigned int)meshOut.meshlets.size();
+
+			MeshletBuilder::Build(vertices, indices, lods[lod].firstIndex, lods[lod].indexCount, meshOut.meshlets);
+
+			lods[lod].meshletCount = (unsigned int)meshOut.meshlets.size() - lods[lod].firstMeshlet;
+		}
+
+		meshOut.optimisationStats.after = MeshOptimiser::AnalyseVertexCache(std::vector<unsigned int>(indices.begin(), indices.begin() + lods[0].indexCount), (unsigned int)vertices.size());
+
+		meshOut.lodCount    = lodCount;
+		meshOut.contentHash = MeshCache::HashMesh(vertices.data(), (unsigned int)vertices.size(), indices.data(), (unsigned int)indices.size());
+
+		return true;
+	}
+}
 
 // --------------------------------------------------------- //
 
@@ -10,6 +113,18 @@ Model::Model(ShaderHandler& shaderHandler, std::string filePathToLoadFrom)
 	: mShaderHandler(shaderHandler)
 	, mVertexData(nullptr)
 	, mIndexData(nullptr)
+	, mMeshletData(nullptr)
+	, mVertexCount(0)
+	, mIndexCount(0)
+	, mMeshletCount(0)
+	, mOwnsData(false)
+	, mCache(nullptr)
+	, mBoundsMin(0.0f, 0.0f, 0.0f)
+	, mBoundsMax(0.0f, 0.0f, 0.0f)
+	, mContentHash(0)
+	, mOptimisationStats()
+	, mLods()
+	, mLodCount(0)
 {
 	if (filePathToLoadFrom != "")
 		LoadInModelFromFile(filePathToLoadFrom);
@@ -24,20 +139,102 @@ Model::~Model()
 
 // --------------------------------------------------------- //
 
-bool Model::LoadInModelFromFile(std::string filePath)
+bool Model::LoadInModelFromFile(std::string filePath, WorkerPool* workerPool)
 {
-	std::fstream file;
-	file.open(filePath.c_str());
+	std::string cachePath = filePath + kMeshCacheExtension;
+	MappedFile  file;
+	MeshCache*  cache     = new MeshCache();
+
+	bool sourceFound = file.Open(filePath);
+
+	if (cache->Open(cachePath))
+	{
+		const MeshCacheHeader& header = cache->GetHeader();
+
+		// The timestamp check avoids reading the whole source in the common case. If only the timestamp moved (a fresh checkout,
+		// or a save with no changes) the contents are compared by hash before giving up on the cache.
+		bool upToDate = !sourceFound
+			         || (header.sourceSize == file.GetSize() && header.sourceModifiedTime == file.GetModifiedTime())
+			         || (header.sourceSize == file.GetSize() && header.sourceHash == MeshCache::HashBytes(file.GetData(), file.GetSize()));
+
+		if (upToDate)
+		{
+			RemoveAllPriorDataStored();
+			SetFromCache(cache);
+			return true;
+		}
+
+		cache->Close();
+	}
 
 	// Error checking
-	if (!file.is_open() || !file.good())
+	if (!sourceFound)
+	{
+		delete cache;
 		return false;
+	}
 
 	// Now the file is open now we can load in the data for the model
+	ImportedMesh mesh;
+
+	if (!ImportObj(file.GetData(), file.GetSize(), workerPool, mesh))
+	{
+		delete cache;
+		return false;
+	}
+
+	RemoveAllPriorDataStored();
+
+	if (MeshCache::Write(cachePath, mesh.vertices.data(), (unsigned int)mesh.vertices.size(), mesh.indices.data(), (unsigned int)mesh.indices.size(), mesh.meshlets.data(), (unsigned int)mesh.meshlets.size(), mesh.lods, mesh.lodCount, mesh.optimisationStats, mesh.contentHash, file) && cache->Open(cachePath))
+	{
+		SetFromCache(cache);
+		return true;
+	}
+
+	// The cache could not be written (e.g. a read-only install), so keep a copy of our own instead
+	delete cache;
+
+	SetFromImport(mesh);
+
+	return true;
+}
+
+// --------------------------------------------------------- //
+
+bool Model::LoadInModelFromArchive(const AssetArchive& archive, const std::string& name, WorkerPool* workerPool)
+{
+	// A mesh cache packed alongside the source is used as is - in place, if the archive stored it uncompressed
+	if (const AssetArchiveEntry* cacheEntry = archive.Find(name + kMeshCacheExtension))
+	{
+		MeshCache* cache = new MeshCache();
+
+		if (cache->OpenFromArchive(archive, *cacheEntry))
+		{
+			RemoveAllPriorDataStored();
+			SetFromCache(cache);
+			return true;
+		}
+
+		delete cache;
+	}
+
+	const AssetArchiveEntry* sourceEntry = archive.Find(name);
+
+	if (!sourceEntry)
+		return false;
+
+	std::vector<char> storage;
+	const char*       data;
+	size_t            size;
 
+	// There is nowhere to write a cache back to, so the import is redone on every load - pack with the caches to avoid it
+	ImportedMesh mesh;
 
-	// Close the file
-	file.close();
+	if (!archive.Read(*sourceEntry, storage, data, size) || !ImportObj(data, size, workerPool, mesh))
+		return false;
+
+	RemoveAllPriorDataStored();
+	SetFromImport(mesh);
 
 	return true;
 }
@@ -46,17 +243,138 @@ bool Model::LoadInModelFromFile(std::string filePath)
 
 void Model::RemoveAllPriorDataStored()
 {
-	if (mVertexData)
+	if (mOwnsData)
 	{
-		delete mVertexData;
-		mVertexData = nullptr;
+		delete[] mVertexData;
+		delete[] mIndexData;
+		delete[] mMeshletData;
 	}
 
-	if (mIndexData)
+	mVertexData  = nullptr;
+	mIndexData   = nullptr;
+	mMeshletData = nullptr;
+	mOwnsData    = false;
+
+	if (mCache)
 	{
-		delete mIndexData;
-		mIndexData = nullptr;
+		delete mCache;
+		mCache = nullptr;
 	}
+
+	mVertexCount  = 0;
+	mIndexCount   = 0;
+	mMeshletCount = 0;
+
+	mBoundsMin = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	mBoundsMax = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+
+	mContentHash = 0;
+
+	mOptimisationStats = MeshOptimisationStats();
+
+	mLodCount = 0;
 }
 
-// --------------------------------------------------------- //
\ No newline at end of file
+// --------------------------------------------------------- //
+
+void Model::SetFromCache(MeshCache* cache)
+{
+	const MeshCacheHeader& header = cache->GetHeader();
+
+	mCache        = cache;
+	mVertexData   = cache->GetVertices();
+	mIndexData    = cache->GetIndices();
+	mMeshletData  = cache->GetMeshlets();
+	mVertexCount  = header.vertexCount;
+	mIndexCount   = header.indexCount;
+	mMeshletCount = header.meshletCount;
+	mOwnsData     = false;
+	mBoundsMin    = header.boundsMin;
+	mBoundsMax    = header.boundsMax;
+	mContentHash  = header.contentHash;
+
+	mOptimisationStats.before.acmr = header.acmrBefore;
+	mOptimisationStats.before.atvr = header.atvrBefore;
+	mOptimisationStats.after.acmr  = header.acmrAfter;
+	mOptimisationStats.after.atvr  = header.atvrAfter;
+
+	memcpy(mLods, header.lods, sizeof(MeshLod) * header.lodCount);
+	mLodCount = header.lodCount;
+}
+
+// --------------------------------------------------------- //
+
+void Model::SetFromImport(const ImportedMesh& mesh)
+{
+	mVertexCount  = (unsigned int)mesh.vertices.size();
+	mIndexCount   = (unsigned int)mesh.indices.size();
+	mMeshletCount = (unsigned int)mesh.meshlets.size();
+
+	VertexData*   vertexData  = new VertexData[mVertexCount];
+	unsigned int* indexData   = new unsigned int[mIndexCount];
+	Meshlet*      meshletData = new Meshlet[mMeshletCount];
+
+	memcpy(vertexData,  mesh.vertices.data(), sizeof(VertexData)   * mVertexCount);
+	memcpy(indexData,   mesh.indices.data(),  sizeof(unsigned int) * mIndexCount);
+	memcpy(meshletData, mesh.meshlets.data(), sizeof(Meshlet)      * mMeshletCount);
+
+	mVertexData  = vertexData;
+	mIndexData   = indexData;
+	mMeshletData = meshletData;
+	mOwnsData    = true;
+
+	mOptimisationStats = mesh.optimisationStats;
+	mBoundsMin         = mesh.boundsMin;
+	mBoundsMax         = mesh.boundsMax;
+	mContentHash       = mesh.contentHash;
+
+	memcpy(mLods, mesh.lods, sizeof(MeshLod) * mesh.lodCount);
+	mLodCount = mesh.lodCount;
+}
+
+// --------------------------------------------------------- //
+
+const Meshlet* Model::GetMeshlets(unsigned int lod) const
+{
+	if (lod >= mLodCount || !mMeshletData)
+		return nullptr;
+
+	return mMeshletData + mLods[lod].firstMeshlet;
+}
+
+// --------------------------------------------------------- //
+
+size_t Model::GetMemoryUsage() const
+{
+	return sizeof(VertexData) * (size_t)mVertexCount + sizeof(unsigned int) * (size_t)mIndexCount + sizeof(Meshlet) * (size_t)mMeshletCount;
+}
+
+// --------------------------------------------------------- //
+
+unsigned int Model::SelectLod(float distance, float projectionScale, float maxPixelError) const
+{
+	if (distance <= 0.0f || projectionScale <= 0.0f)
+		return 0;
+
+	// The biggest error in model units that still projects to no more than maxPixelError pixels here
+	float allowedError = maxPixelError * distance / projectionScale;
+	unsigned int lod   = 0;
+
+	// Errors only grow with each level, so stop at the first one that is too coarse
+	while (lod + 1 < mLodCount && mLods[lod + 1].error <= allowedError)
+		lod++;
+
+	return lod;
+}
+
+// --------------------------------------------------------- //
+
+float Model::GetLodDistance(unsigned int lod, float projectionScale, float maxPixelError) const
+{
+	if (lod >= mLodCount || maxPixelError <= 0.0f)
+		return 0.0f;
+
+	return mLods[lod].error * projectionScale / maxPixelError;
+}
+
+// --------------------------------------------------------- //
@@ -1,6 +1,7 @@
 #ifndef _MODEL_H_
 #define _MODEL_H_
 
+#include <stddef.h>
 #include <string>
 
 #include <d3d11_1.h>
@@ -17,7 +18,43 @@ struct VertexData final
 
 // -------------------------------------------------------------- //
 
+// Post-transform vertex cache efficiency of an index buffer, from a simulated FIFO cache - see MeshOptimiser
+struct VertexCacheStats final
+{
+	float acmr; // Average cache miss ratio - vertex shader runs per triangle. 0.5 is the best possible, 3 the worst.
+	float atvr; // Average transformed vertex ratio - vertex shader runs per referenced vertex. 1 is the best possible.
+};
+
+struct MeshOptimisationStats final
+{
+	VertexCacheStats before;
+	VertexCacheStats after;
+};
+
+// -------------------------------------------------------------- //
+
+// One level of detail - a range of the model's index data, drawn with the same vertices as every other level
+struct MeshLod final
+{
+	unsigned int firstIndex;
+	unsigned int indexCount;
+	float        error;        // Furthest the surface can be from the full detail mesh, in model units
+
+	unsigned int firstMeshlet; // The level split into meshlets for MeshletCuller - together they cover the index range above
+	unsigned int meshletCount;
+};
+
+// Level 0 is always the full detail mesh
+const unsigned int kMaxMeshLods = 6;
+
+// -------------------------------------------------------------- //
+
+class AssetArchive;
+class MeshCache;
 class ShaderHandler;
+class WorkerPool;
+struct ImportedMesh;
+struct Meshlet;
 
 class Model final
 {
@@ -25,15 +62,75 @@ public:
 	Model(ShaderHandler& shaderHandler, std::string filePathToLoadFrom = "");
 	~Model();
 
-	bool LoadInModelFromFile(std::string filePath);
+	// Only Wavefront OBJ files are supported. A binary mesh cache is written next to the source on the first load and mapped
+	// straight into memory on later ones, for as long as the source is unchanged. Importing a large mesh spreads some of the work
+	// over workerPool where one is given - it may be the pool this is running on.
+	bool LoadInModelFromFile(std::string filePath, WorkerPool* workerPool = nullptr);
+
+	// Loads the named OBJ out of an archive that stays open for the model's lifetime. A "<name>.meshcache" entry is used in
+	// preference to the source, which otherwise has to be imported from scratch.
+	bool LoadInModelFromArchive(const AssetArchive& archive, const std::string& name, WorkerPool* workerPool = nullptr);
 	void RemoveAllPriorDataStored();
 
+	const VertexData*   GetVertexData() const  { return mVertexData; }
+	const unsigned int* GetIndexData()  const  { return mIndexData; }
+	unsigned int        GetVertexCount() const { return mVertexCount; }
+	unsigned int        GetIndexCount()  const { return mIndexCount; } // Every level of detail together
+
+	unsigned int        GetLodCount()    const { return mLodCount; }
+	const MeshLod&      GetLod(unsigned int lod) const { return mLods[lod]; }
+
+	// Picks the coarsest level whose error would cover no more than maxPixelError pixels at this distance from the camera.
+	// projectionScale is BaseCamera::GetLodProjectionScale() - it is the same for every model in a frame.
+	unsigned int        SelectLod(float distance, float projectionScale, float maxPixelError = 1.0f) const;
+
+	// Distance beyond which SelectLod() will pick the given level, for callers that would rather compare distances
+	float               GetLodDistance(unsigned int lod, float projectionScale, float maxPixelError = 1.0f) const;
+
+	const Meshlet*      GetMeshlets(unsigned int lod)     const;
+	unsigned int        GetMeshletCount(unsigned int lod) const { return mLods[lod].meshletCount; }
+
+	const DirectX::XMFLOAT3& GetBoundsMin() const { return mBoundsMin; }
+	const DirectX::XMFLOAT3& GetBoundsMax() const { return mBoundsMax; }
+
+	// Models with the same hash have identical vertex and index data, so one can stand in for the other - see TrackPieceFactory
+	unsigned long long  GetContentHash() const { return mContentHash; }
+
+	// Bytes of vertex, index and meshlet data held, whether mapped from the cache or owned
+	size_t              GetMemoryUsage() const;
+
+	// How much the import-time mesh optimisation improved vertex cache use
+	const MeshOptimisationStats& GetOptimisationStats() const { return mOptimisationStats; }
+
 private:
+	// Takes ownership of an open cache and points the model's data into it
+	void SetFromCache(MeshCache* cache);
+
+	// Copies a mesh imported without a cache to map it from
+	void SetFromImport(const ImportedMesh& mesh);
+
 	ShaderHandler& mShaderHandler;
 
-	// Vertex and index data
-	VertexData*    mVertexData;
-	unsigned int*  mIndexData;
+	// Vertex, index and meshlet data - either pointing into mCache, or owned by the model if there was no cache to use
+	const VertexData*   mVertexData;
+	const unsigned int* mIndexData;
+	const Meshlet*      mMeshletData;
+	unsigned int        mVertexCount;
+	unsigned int        mIndexCount;
+	unsigned int        mMeshletCount;
+	bool                mOwnsData;
+
+	MeshCache*          mCache;
+
+	DirectX::XMFLOAT3   mBoundsMin;
+	DirectX::XMFLOAT3   mBoundsMax;
+
+	unsigned long long  mContentHash;
+
+	MeshOptimisationStats mOptimisationStats;
+
+	MeshLod             mLods[kMaxMeshLods];
+	unsigned int        mLodCount;
 };
 
 // -------------------------------------------------------------- //
@@ -0,0 +1,524 @@
+#include "NormalGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <math.h>
+
+#include "../Maths/SIMDLanes.h"
+#include "../Threading/WorkerPool.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// Triangles are counted and staged in ranges of this many, and vertices are summed in buckets of this many - small enough
+	// that a bucket's sums stay in cache
+	const unsigned int kTriangleRangeSize = 16384;
+	const unsigned int kVertexBucketSize  = 16384;
+
+	// Without a pool, corners are walked in blocks of this many rather than bucketed
+	const unsigned int kCornerBlockSize   = 1024;
+
+	const float        kPi                = 3.14159265f;
+
+	// Below this a vector is treated as having no direction
+	const float        kMinLength         = 1e-20f;
+
+	// -------------------------------------------------------------------- //
+
+	// Every corner of the range (triangle * 3 + corner), grouped by which bucket of vertices it belongs to and in ascending order
+	// within each bucket. A stable counting sort, done per triangle range so that it runs in parallel without atomics.
+	struct BucketedCorners final
+	{
+		std::vector<unsigned int> bucketStarts; // bucketCount + 1 entries
+		std::vector<unsigned int> corners;
+	};
+
+	// Returns false if an index is out of range
+	bool BucketCorners(const unsigned int* triangles, unsigned int triangleCount, unsigned int vertexCount, WorkerPool& workerPool, BucketedCorners& bucketedOut)
+	{
+		unsigned int rangeCount  = (triangleCount + kTriangleRangeSize - 1) / kTriangleRangeSize;
+		unsigned int bucketCount = (vertexCount   + kVertexBucketSize  - 1) / kVertexBucketSize;
+
+		// How many corners each triangle range has in each bucket, then where the range writes the next one
+		std::vector<unsigned int> rangeCursors((size_t)rangeCount * bucketCount, 0);
+		std::atomic<bool>         indexOutOfRange(false);
+
+		workerPool.ParallelFor(triangleCount, kTriangleRangeSize, [&](unsigned int first, unsigned int end)
+		{
+			unsigned int* counts = rangeCursors.data() + (size_t)(first / kTriangleRangeSize) * bucketCount;
+
+			for (unsigned int corner = first * 3; corner < end * 3; corner++)
+			{
+				if (triangles[corner] < vertexCount)
+					counts[triangles[corner] / kVertexBucketSize]++;
+				else
+					indexOutOfRange = true;
+			}
+		});
+
+		if (indexOutOfRange)
+			return false;
+
+		bucketedOut.bucketStarts.resize(bucketCount + 1);
+
+		unsigned int total = 0;
+
+		for (unsigned int bucket = 0; bucket < bucketCount; bucket++)
+		{
+			bucketedOut.bucketStarts[bucket] = total;
+
+			for (unsigned int range = 0; range < rangeCount; range++)
+			{
+				unsigned int& cursor = rangeCursors[(size_t)range * bucketCount + bucket];
+				unsigned int  count  = cursor;
+
+				cursor = total;
+				total += count;
+			}
+		}
+
+		bucketedOut.bucketStarts[bucketCount] = total;
+		bucketedOut.corners.resize(total);
+
+		workerPool.ParallelFor(triangleCount, kTriangleRangeSize, [&](unsigned int first, unsigned int end)
+		{
+			unsigned int* cursors = rangeCursors.data() + (size_t)(first / kTriangleRangeSize) * bucketCount;
+
+			for (unsigned int corner = first * 3; corner < end * 3; corner++)
+			{
+				bucketedOut.corners[cursors[triangles[corner] / kVertexBucketSize]++] = corner;
+			}
+		});
+
+		return true;
+	}
+
+	// Without a pool there is only the one thread, so the corners can go straight onto their vertices, skipping the bucketing. Each
+	// vertex still sums its corners in ascending order, as a bucket would, so the result is the same bit for bit.
+	// Returns false if an index is out of range, before any corner is summed.
+	bool WalkCornersInOrder(const unsigned int* triangles, unsigned int triangleCount, unsigned int vertexCount, const std::function<void(const unsigned int*, unsigned int)>& sumCorners)
+	{
+		for (unsigned int corner = 0; corner < triangleCount * 3; corner++)
+		{
+			if (triangles[corner] >= vertexCount)
+				return false;
+		}
+
+		unsigned int corners[kCornerBlockSize];
+
+		for (unsigned int first = 0; first < triangleCount * 3; first += kCornerBlockSize)
+		{
+			unsigned int count = std::min(kCornerBlockSize, triangleCount * 3 - first);
+
+			for (unsigned int i = 0; i < count; i++)
+				corners[i] = first + i;
+
+			sumCorners(corners, count);
+		}
+
+		return true;
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// Abramowitz and Stegun 4.4.46, within 2e-8 radians. LaneAcos() does the same operations in the same order, so they agree exactly.
+	inline float ScalarAcos(float x)
+	{
+		float a = fabsf(x);
+		float p = -0.0012624911f;
+
+		p = p * a + 0.0066700901f;
+		p = p * a - 0.0170881256f;
+		p = p * a + 0.0308918810f;
+		p = p * a - 0.0501743046f;
+		p = p * a + 0.0889789874f;
+		p = p * a - 0.2145988016f;
+		p = p * a + 1.5707963050f;
+		p = p * sqrtf(1.0f - a);
+
+		return x < 0.0f ? kPi - p : p;
+	}
+
+	// The triangle's unit normal scaled by the corner's weight. The triangle is taken starting from the corner, so each corner works
+	// its normal out from its own two edges - the three can differ in the last bit, but never between runs.
+	void CalculateCorner(const VertexData* vertices, const unsigned int* triangles, unsigned int corner, NormalWeighting weighting, float (&weightedOut)[3])
+	{
+		const unsigned int*      triangle = triangles + (corner / 3) * 3;
+		unsigned int             first    = corner % 3;
+
+		const DirectX::XMFLOAT3& a        = vertices[triangle[first]].vertexPosition;
+		const DirectX::XMFLOAT3& b        = vertices[triangle[first == 2 ? 0 : first + 1]].vertexPosition;
+		const DirectX::XMFLOAT3& c        = vertices[triangle[first == 0 ? 2 : first - 1]].vertexPosition;
+
+		float abX = b.x - a.x, abY = b.y - a.y, abZ = b.z - a.z;
+		float acX = c.x - a.x, acY = c.y - a.y, acZ = c.z - a.z;
+
+		float normalX = abY * acZ - abZ * acY;
+		float normalY = abZ * acX - abX * acZ;
+		float normalZ = abX * acY - abY * acX;
+		float length  = sqrtf(normalX * normalX + normalY * normalY + normalZ * normalZ);
+
+		// Degenerate triangles have no direction, so they count for nothing
+		if (!(length > 0.0f))
+		{
+			weightedOut[0] = weightedOut[1] = weightedOut[2] = 0.0f;
+			return;
+		}
+
+		float weight;
+
+		if (weighting == NormalWeighting::AREA)
+		{
+			weight = length * 0.5f;
+		}
+		else
+		{
+			float abLength = sqrtf(abX * abX + abY * abY + abZ * abZ);
+			float acLength = sqrtf(acX * acX + acY * acY + acZ * acZ);
+			float cosine   = (abX * acX + abY * acY + abZ * acZ) / std::max(abLength * acLength, kMinLength);
+
+			weight = ScalarAcos(std::min(std::max(cosine, -1.0f), 1.0f));
+		}
+
+		weightedOut[0] = normalX / length * weight;
+		weightedOut[1] = normalY / length * weight;
+		weightedOut[2] = normalZ / length * weight;
+	}
+
+#if defined(SIMD_LANES_ENABLED)
+
+	inline Lane LaneAcos(Lane x)
+	{
+		Lane a = LaneAbs(x);
+		Lane p = LaneSet(-0.0012624911f);
+
+		p = LaneAdd(LaneMul(p, a), LaneSet(0.0066700901f));
+		p = LaneSub(LaneMul(p, a), LaneSet(0.0170881256f));
+		p = LaneAdd(LaneMul(p, a), LaneSet(0.0308918810f));
+		p = LaneSub(LaneMul(p, a), LaneSet(0.0501743046f));
+		p = LaneAdd(LaneMul(p, a), LaneSet(0.0889789874f));
+		p = LaneSub(LaneMul(p, a), LaneSet(0.2145988016f));
+		p = LaneAdd(LaneMul(p, a), LaneSet(1.5707963050f));
+		p = LaneMul(p, LaneSqrt(LaneSub(LaneSet(1.0f), a)));
+
+		return LaneSelect(LaneLess(x, LaneSet(0.0f)), LaneSub(LaneSet(kPi), p), p);
+	}
+
+	// CalculateCorner() for kLaneWidth corners at once - the positions are gathered into lanes, and the results come back a lane each
+	void CalculateCornerLanes(const VertexData* vertices, const unsigned int* triangles, const unsigned int* corners, NormalWeighting weighting, float (&weightedOut)[3][kLaneWidth])
+	{
+		alignas(32) float gathered[9][kLaneWidth];
+
+		for (unsigned int lane = 0; lane < kLaneWidth; lane++)
+		{
+			const unsigned int* triangle = triangles + (corners[lane] / 3) * 3;
+			unsigned int        first    = corners[lane] % 3;
+
+			const DirectX::XMFLOAT3& a = vertices[triangle[first]].vertexPosition;
+			const DirectX::XMFLOAT3& b = vertices[triangle[first == 2 ? 0 : first + 1]].vertexPosition;
+			const DirectX::XMFLOAT3& c = vertices[triangle[first == 0 ? 2 : first - 1]].vertexPosition;
+
+			gathered[0][lane] = a.x; gathered[1][lane] = a.y; gathered[2][lane] = a.z;
+			gathered[3][lane] = b.x; gathered[4][lane] = b.y; gathered[5][lane] = b.z;
+			gathered[6][lane] = c.x; gathered[7][lane] = c.y; gathered[8][lane] = c.z;
+		}
+
+		Lane aX  = LaneLoad(gathered[0]), aY = LaneLoad(gathered[1]), aZ = LaneLoad(gathered[2]);
+
+		Lane abX = LaneSub(LaneLoad(gathered[3]), aX), abY = LaneSub(LaneLoad(gathered[4]), aY), abZ = LaneSub(LaneLoad(gathered[5]), aZ);
+		Lane acX = LaneSub(LaneLoad(gathered[6]), aX), acY = LaneSub(LaneLoad(gathered[7]), aY), acZ = LaneSub(LaneLoad(gathered[8]), aZ);
+
+		Lane normalX = LaneSub(LaneMul(abY, acZ), LaneMul(abZ, acY));
+		Lane normalY = LaneSub(LaneMul(abZ, acX), LaneMul(abX, acZ));
+		Lane normalZ = LaneSub(LaneMul(abX, acY), LaneMul(abY, acX));
+		Lane length  = LaneSqrt(LaneAdd(LaneAdd(LaneMul(normalX, normalX), LaneMul(normalY, normalY)), LaneMul(normalZ, normalZ)));
+
+		Lane zero    = LaneSet(0.0f);
+		Lane valid   = LaneLess(zero, length);
+		Lane weight;
+
+		if (weighting == NormalWeighting::AREA)
+		{
+			weight = LaneMul(length, LaneSet(0.5f));
+		}
+		else
+		{
+			Lane abLength = LaneSqrt(LaneAdd(LaneAdd(LaneMul(abX, abX), LaneMul(abY, abY)), LaneMul(abZ, abZ)));
+			Lane acLength = LaneSqrt(LaneAdd(LaneAdd(LaneMul(acX, acX), LaneMul(acY, acY)), LaneMul(acZ, acZ)));
+			Lane cosine   = LaneDiv(LaneAdd(LaneAdd(LaneMul(abX, acX), LaneMul(abY, acY)), LaneMul(abZ, acZ)), LaneMax(LaneMul(abLength, acLength), LaneSet(kMinLength)));
+
+			weight = LaneAcos(LaneMin(LaneMax(cosine, LaneSet(-1.0f)), LaneSet(1.0f)));
+		}
+
+		LaneStore(weightedOut[0], LaneSelect(valid, LaneMul(LaneDiv(normalX, length), weight), zero));
+		LaneStore(weightedOut[1], LaneSelect(valid, LaneMul(LaneDiv(normalY, length), weight), zero));
+		LaneStore(weightedOut[2], LaneSelect(valid, LaneMul(LaneDiv(normalZ, length), weight), zero));
+	}
+
+#endif
+
+	// Adds each corner onto its vertex's sum, in the order given. sums holds three floats per vertex from firstVertex on.
+	void SumCorners(const VertexData* vertices, const unsigned int* triangles, const unsigned int* corners, unsigned int cornerCount, unsigned int firstVertex, NormalWeighting weighting, float* sums)
+	{
+		unsigned int i = 0;
+
+#if defined(SIMD_LANES_ENABLED)
+		alignas(32) float weighted[3][kLaneWidth];
+
+		for (; i + kLaneWidth <= cornerCount; i += kLaneWidth)
+		{
+			CalculateCornerLanes(vertices, triangles, corners + i, weighting, weighted);
+
+			for (unsigned int lane = 0; lane < kLaneWidth; lane++)
+			{
+				float* sum = sums + (triangles[corners[i + lane]] - firstVertex) * 3;
+
+				sum[0] += weighted[0][lane];
+				sum[1] += weighted[1][lane];
+				sum[2] += weighted[2][lane];
+			}
+		}
+#endif
+
+		for (; i < cornerCount; i++)
+		{
+			float weighted[3];
+			CalculateCorner(vertices, triangles, corners[i], weighting, weighted);
+
+			float* sum = sums + (triangles[corners[i]] - firstVertex) * 3;
+
+			sum[0] += weighted[0];
+			sum[1] += weighted[1];
+			sum[2] += weighted[2];
+		}
+	}
+
+	// -------------------------------------------------------------------- //
+
+	// The corner's tangent and bitangent from the texture mapping, each normalised and then scaled by the corner's angle.
+	// Returns false if the mapping is degenerate here.
+	bool CalculateCornerTangent(const VertexData* vertices, const DirectX::XMFLOAT2* textureCoordinates, const unsigned int* triangles, unsigned int corner, float (&tangentOut)[3], float (&bitangentOut)[3])
+	{
+		const unsigned int* triangle = triangles + (corner / 3) * 3;
+		unsigned int        first    = corner % 3;
+		unsigned int        second   = triangle[first == 2 ? 0 : first + 1];
+		unsigned int        third    = triangle[first == 0 ? 2 : first - 1];
+
+		const DirectX::XMFLOAT3& a   = vertices[triangle[first]].vertexPosition;
+		const DirectX::XMFLOAT3& b   = vertices[second].vertexPosition;
+		const DirectX::XMFLOAT3& c   = vertices[third].vertexPosition;
+
+		const DirectX::XMFLOAT2& uvA = textureCoordinates[triangle[first]];
+		const DirectX::XMFLOAT2& uvB = textureCoordinates[second];
+		const DirectX::XMFLOAT2& uvC = textureCoordinates[third];
+
+		float abX = b.x - a.x, abY = b.y - a.y, abZ = b.z - a.z;
+		float acX = c.x - a.x, acY = c.y - a.y, acZ = c.z - a.z;
+
+		float abU = uvB.x - uvA.x, abV = uvB.y - uvA.y;
+		float acU = uvC.x - uvA.x, acV = uvC.y - uvA.y;
+
+		// Solves [ab ac] = [tangent bitangent] * [uv deltas] - the sign of the determinant carries any mirroring through
+		float determinant = abU * acV - acU * abV;
+
+		float abLength    = sqrtf(abX * abX + abY * abY + abZ * abZ);
+		float acLength    = sqrtf(acX * acX + acY * acY + acZ * acZ);
+
+		if (determinant == 0.0f || !(abLength * acLength > kMinLength))
+			return false;
+
+		float tangent[3]   = { (abX * acV - acX * abV) / determinant, (abY * acV - acY * abV) / determinant, (abZ * acV - acZ * abV) / determinant };
+		float bitangent[3] = { (acX * abU - abX * acU) / determinant, (acY * abU - abY * acU) / determinant, (acZ * abU - abZ * acU) / determinant };
+
+		float tangentLength   = sqrtf(tangent[0]   * tangent[0]   + tangent[1]   * tangent[1]   + tangent[2]   * tangent[2]);
+		float bitangentLength = sqrtf(bitangent[0] * bitangent[0] + bitangent[1] * bitangent[1] + bitangent[2] * bitangent[2]);
+
+		if (!(tangentLength > kMinLength) || !(bitangentLength > kMinLength))
+			return false;
+
+		// Weighted by angle like the normals, rather than by however much the texture happens to be stretched here
+		float cosine = (abX * acX + abY * acY + abZ * acZ) / (abLength * acLength);
+		float angle  = ScalarAcos(std::min(std::max(cosine, -1.0f), 1.0f));
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			tangentOut[axis]   = tangent[axis]   / tangentLength   * angle;
+			bitangentOut[axis] = bitangent[axis] / bitangentLength * angle;
+		}
+
+		return true;
+	}
+
+	// As SumCorners(), but six floats per vertex - the tangent sum, then the bitangent sum
+	void SumTangentCorners(const VertexData* vertices, const DirectX::XMFLOAT2* textureCoordinates, const unsigned int* triangles, const unsigned int* corners, unsigned int cornerCount, unsigned int firstVertex, float* sums)
+	{
+		for (unsigned int i = 0; i < cornerCount; i++)
+		{
+			float tangent[3];
+			float bitangent[3];
+
+			if (!CalculateCornerTangent(vertices, textureCoordinates, triangles, corners[i], tangent, bitangent))
+				continue;
+
+			float* sum = sums + (triangles[corners[i]] - firstVertex) * 6;
+
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				sum[axis]     += tangent[axis];
+				sum[axis + 3] += bitangent[axis];
+			}
+		}
+	}
+
+	// Any unit vector at right angles to the normal, for vertices whose texture mapping gives no direction
+	DirectX::XMFLOAT3 GetPerpendicular(const DirectX::XMFLOAT3& normal)
+	{
+		DirectX::XMFLOAT3 axis = fabsf(normal.x) < 0.9f ? DirectX::XMFLOAT3(1.0f, 0.0f, 0.0f) : DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);
+
+		float             along  = axis.x * normal.x + axis.y * normal.y + axis.z * normal.z;
+		DirectX::XMFLOAT3 result(axis.x - normal.x * along, axis.y - normal.y * along, axis.z - normal.z * along);
+		float             length = sqrtf(result.x * result.x + result.y * result.y + result.z * result.z);
+
+		if (!(length > kMinLength))
+			return DirectX::XMFLOAT3(1.0f, 0.0f, 0.0f);
+
+		return DirectX::XMFLOAT3(result.x / length, result.y / length, result.z / length);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool NormalGenerator::GenerateNormals(std::vector<VertexData>& vertices, const std::vector<unsigned int>& indices, unsigned int firstIndex, unsigned int indexCount, NormalWeighting weighting, bool keepExisting, WorkerPool* workerPool)
+{
+	if (indexCount % 3 != 0 || firstIndex > indices.size() || indexCount > indices.size() - firstIndex)
+		return false;
+
+	const unsigned int* triangles   = indices.data() + firstIndex;
+	unsigned int        vertexCount = (unsigned int)vertices.size();
+
+	auto finishNormals = [&](unsigned int first, unsigned int end, const float* sums)
+	{
+		for (unsigned int vertex = first; vertex < end; vertex++)
+		{
+			DirectX::XMFLOAT3& normal = vertices[vertex].normal;
+
+			if (keepExisting && normal.x * normal.x + normal.y * normal.y + normal.z * normal.z > 0.0f)
+				continue;
+
+			const float* sum    = sums + (vertex - first) * 3;
+			float        length = sqrtf(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+
+			if (length > kMinLength)
+				normal = DirectX::XMFLOAT3(sum[0] / length, sum[1] / length, sum[2] / length);
+		}
+	};
+
+	if (!workerPool)
+	{
+		std::vector<float> sums((size_t)vertexCount * 3, 0.0f);
+
+		if (!WalkCornersInOrder(triangles, indexCount / 3, vertexCount, [&](const unsigned int* corners, unsigned int cornerCount)
+		{
+			SumCorners(vertices.data(), triangles, corners, cornerCount, 0, weighting, sums.data());
+		}))
+			return false;
+
+		finishNormals(0, vertexCount, sums.data());
+		return true;
+	}
+
+	BucketedCorners bucketed;
+
+	if (!BucketCorners(triangles, indexCount / 3, vertexCount, *workerPool, bucketed))
+		return false;
+
+	// Each bucket's vertices are only ever summed by the one thread, so no two threads write the same vertex
+	workerPool->ParallelFor(vertexCount, kVertexBucketSize, [&](unsigned int first, unsigned int end)
+	{
+		unsigned int       bucket      = first / kVertexBucketSize;
+		unsigned int       cornerFirst = bucketed.bucketStarts[bucket];
+		std::vector<float> sums((size_t)(end - first) * 3, 0.0f);
+
+		SumCorners(vertices.data(), triangles, bucketed.corners.data() + cornerFirst, bucketed.bucketStarts[bucket + 1] - cornerFirst, first, weighting, sums.data());
+		finishNormals(first, end, sums.data());
+	});
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool NormalGenerator::GenerateTangents(const std::vector<VertexData>& vertices, const std::vector<DirectX::XMFLOAT2>& textureCoordinates, const std::vector<unsigned int>& indices, unsigned int firstIndex, unsigned int indexCount, std::vector<DirectX::XMFLOAT4>& tangentsOut, WorkerPool* workerPool)
+{
+	if (textureCoordinates.size() != vertices.size() || indexCount % 3 != 0 || firstIndex > indices.size() || indexCount > indices.size() - firstIndex)
+		return false;
+
+	const unsigned int* triangles   = indices.data() + firstIndex;
+	unsigned int        vertexCount = (unsigned int)vertices.size();
+
+	auto finishTangents = [&](unsigned int first, unsigned int end, const float* sums)
+	{
+		for (unsigned int vertex = first; vertex < end; vertex++)
+		{
+			const DirectX::XMFLOAT3& normal = vertices[vertex].normal;
+			const float*             sum    = sums + (vertex - first) * 6;
+
+			// Gram-Schmidt - take out the part along the normal
+			float along = normal.x * sum[0] + normal.y * sum[1] + normal.z * sum[2];
+
+			DirectX::XMFLOAT3 tangent(sum[0] - normal.x * along, sum[1] - normal.y * along, sum[2] - normal.z * along);
+			float             length = sqrtf(tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z);
+
+			if (length > kMinLength)
+				tangent = DirectX::XMFLOAT3(tangent.x / length, tangent.y / length, tangent.z / length);
+			else
+				tangent = GetPerpendicular(normal);
+
+			// Mirrored texture mapping makes the bitangent point the other way to cross(normal, tangent)
+			float crossX     = normal.y * tangent.z - normal.z * tangent.y;
+			float crossY     = normal.z * tangent.x - normal.x * tangent.z;
+			float crossZ     = normal.x * tangent.y - normal.y * tangent.x;
+			float handedness = crossX * sum[3] + crossY * sum[4] + crossZ * sum[5] < 0.0f ? -1.0f : 1.0f;
+
+			tangentsOut[vertex] = DirectX::XMFLOAT4(tangent.x, tangent.y, tangent.z, handedness);
+		}
+	};
+
+	if (!workerPool)
+	{
+		std::vector<float> sums((size_t)vertexCount * 6, 0.0f);
+
+		if (!WalkCornersInOrder(triangles, indexCount / 3, vertexCount, [&](const unsigned int* corners, unsigned int cornerCount)
+		{
+			SumTangentCorners(vertices.data(), textureCoordinates.data(), triangles, corners, cornerCount, 0, sums.data());
+		}))
+			return false;
+
+		tangentsOut.resize(vertexCount);
+		finishTangents(0, vertexCount, sums.data());
+		return true;
+	}
+
+	BucketedCorners bucketed;
+
+	if (!BucketCorners(triangles, indexCount / 3, vertexCount, *workerPool, bucketed))
+		return false;
+
+	tangentsOut.resize(vertexCount);
+
+	workerPool->ParallelFor(vertexCount, kVertexBucketSize, [&](unsigned int first, unsigned int end)
+	{
+		unsigned int       bucket      = first / kVertexBucketSize;
+		unsigned int       cornerFirst = bucketed.bucketStarts[bucket];
+		std::vector<float> sums((size_t)(end - first) * 6, 0.0f);
+
+		SumTangentCorners(vertices.data(), textureCoordinates.data(), triangles, bucketed.corners.data() + cornerFirst, bucketed.bucketStarts[bucket + 1] - cornerFirst, first, sums.data());
+		finishTangents(first, end, sums.data());
+	});
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,58 @@
+#ifndef _NORMAL_GENERATOR_H_
+#define _NORMAL_GENERATOR_H_
+
+#include <vector>
+
+#include <directxmath.h>
+
+#include "Model.h"
+
+class WorkerPool;
+
+// -------------------------------------------------------------------- //
+
+// How much each triangle counts towards the normals of its corners
+enum class NormalWeighting : unsigned int
+{
+	AREA = 0, // Big triangles dominate - cheap, but long thin triangles drag the normal around
+	ANGLE,    // By the angle at the corner - independent of how the surface happens to be triangulated
+
+	MAX
+};
+
+// -------------------------------------------------------------------- //
+
+// Rebuilds smooth per-vertex normals, and tangents, from the triangles of an index range. Vertices are only shared where the mesh
+// shares them, so hard edges split into separate vertices stay hard.
+// With a worker pool the triangles and vertices are split into fixed size ranges and run in parallel. Every vertex sums its triangles
+// in index order whichever thread does it, so the output is bit for bit the same for any number of threads, or none.
+struct NormalGenerator final
+{
+public:
+	// Vertices the range does not use are left alone, as are those whose triangles are all degenerate. With keepExisting, only
+	// vertices whose normal is zero length (e.g. an OBJ without "vn" lines) are written.
+	// Returns false, leaving the vertices alone, if the range is not whole triangles or an index is out of range.
+	static bool GenerateNormals(std::vector<VertexData>&         vertices,
+	                            const std::vector<unsigned int>& indices,
+	                            unsigned int                     firstIndex,
+	                            unsigned int                     indexCount,
+	                            NormalWeighting                  weighting,
+	                            bool                             keepExisting,
+	                            WorkerPool*                      workerPool = nullptr);
+
+	// Per-vertex tangents along increasing u, orthogonalised against the vertex normals, which must already be set. w is the
+	// handedness (1 or -1), so that the bitangent is cross(normal, tangent) * w. VertexData has no texture coordinates, so they are
+	// passed alongside - one per vertex. Vertices with no usable mapping get an arbitrary tangent perpendicular to the normal.
+	// Fails as GenerateNormals() does, and if there is not one texture coordinate per vertex.
+	static bool GenerateTangents(const std::vector<VertexData>&        vertices,
+	                             const std::vector<DirectX::XMFLOAT2>& textureCoordinates,
+	                             const std::vector<unsigned int>&      indices,
+	                             unsigned int                          firstIndex,
+	                             unsigned int                          indexCount,
+	                             std::vector<DirectX::XMFLOAT4>&       tangentsOut,
+	                             WorkerPool*                           workerPool = nullptr);
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,294 @@
+#include "ObjParser.h"
+
+#include <charconv>
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// Finds the vertex already made for a (position, normal) pair. Each position keeps a short chain of the vertices made from it -
+	// almost always just one - so a lookup is an array read next to the ones for the neighbouring corners, rather than a hash probe.
+	class VertexDeduplicator final
+	{
+	public:
+		VertexDeduplicator()
+			: mFirstVertex()
+			, mNextVertex()
+			, mVertexNormal()
+		{
+
+		}
+
+		void Reserve(size_t positionCount, size_t vertexCount)
+		{
+			mFirstVertex.reserve(positionCount);
+			mNextVertex.reserve(vertexCount);
+			mVertexNormal.reserve(vertexCount);
+		}
+
+		// Must be called once for every position, in order
+		void AddPosition()
+		{
+			mFirstVertex.push_back(kNoVertex);
+		}
+
+		// Vertex numbers count up from zero in the order they were added. Returns the existing vertex for the pair, or adds
+		// the next number for it and sets addedOut.
+		unsigned int FindOrAdd(unsigned int position, unsigned int normalKey, bool& addedOut)
+		{
+			unsigned int vertex = mFirstVertex[position];
+
+			while (vertex != kNoVertex)
+			{
+				if (mVertexNormal[vertex] == normalKey)
+				{
+					addedOut = false;
+					return vertex;
+				}
+
+				vertex = mNextVertex[vertex];
+			}
+
+			vertex = (unsigned int)mNextVertex.size();
+
+			mNextVertex.push_back(mFirstVertex[position]);
+			mVertexNormal.push_back(normalKey);
+			mFirstVertex[position] = vertex;
+
+			addedOut = true;
+			return vertex;
+		}
+
+	private:
+		static constexpr unsigned int kNoVertex = ~0u;
+
+		std::vector<unsigned int> mFirstVertex;  // Per position
+		std::vector<unsigned int> mNextVertex;   // Per vertex
+		std::vector<unsigned int> mVertexNormal; // Per vertex
+	};
+
+	// -------------------------------------------------------------------- //
+
+	inline bool IsSpace(char character)
+	{
+		return character == ' ' || character == '\t' || character == '\r';
+	}
+
+	inline const char* SkipSpaces(const char* current, const char* end)
+	{
+		while (current < end && IsSpace(*current))
+			current++;
+
+		return current;
+	}
+
+	inline const char* SkipLine(const char* current, const char* end)
+	{
+		while (current < end && *current != '\n')
+			current++;
+
+		return current < end ? current + 1 : end;
+	}
+
+	// Returns nullptr if there is no number here
+	inline const char* ParseFloat(const char* current, const char* end, float& valueOut)
+	{
+		current = SkipSpaces(current, end);
+
+		// from_chars does not accept a leading plus sign
+		if (current < end && *current == '+')
+			current++;
+
+		std::from_chars_result result = std::from_chars(current, end, valueOut);
+
+		return result.ec == std::errc() ? result.ptr : nullptr;
+	}
+
+	// Turns a one-based (or negative, relative to the end) OBJ index into a zero-based one. Returns false if it is out of range.
+	inline bool ResolveIndex(long long objIndex, size_t elementCount, unsigned int& indexOut)
+	{
+		long long resolved = objIndex > 0 ? objIndex - 1 : (long long)elementCount + objIndex;
+
+		if (objIndex == 0 || resolved < 0 || resolved >= (long long)elementCount)
+			return false;
+
+		indexOut = (unsigned int)resolved;
+		return true;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool ObjParser::Parse(const char* data, size_t size, std::vector<VertexData>& verticesOut, std::vector<unsigned int>& indicesOut)
+{
+	if (!data && size != 0)
+		return false;
+
+	const char* current = data;
+	const char* end     = data + size;
+
+	size_t firstNewVertex = verticesOut.size();
+	size_t firstNewIndex  = indicesOut.size();
+
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<DirectX::XMFLOAT4> colours;
+	std::vector<DirectX::XMFLOAT3> normals;
+	VertexDeduplicator             deduplicator;
+
+	// A rough guess from typical OBJ line lengths, so that the arrays rarely need to grow
+	size_t estimatedCount = size / 64;
+
+	positions.reserve(estimatedCount);
+	colours.reserve(estimatedCount);
+	normals.reserve(estimatedCount);
+	deduplicator.Reserve(estimatedCount, estimatedCount);
+
+	verticesOut.reserve(firstNewVertex + estimatedCount);
+	indicesOut.reserve(firstNewIndex + estimatedCount * 4);
+
+	// Corners of the polygon currently being fanned - only the first and the previous are needed
+	unsigned int firstCorner    = 0;
+	unsigned int previousCorner = 0;
+
+	while (current < end)
+	{
+		current = SkipSpaces(current, end);
+
+		if (current >= end)
+			break;
+
+		if (current + 1 < end && current[0] == 'v' && IsSpace(current[1]))
+		{
+			DirectX::XMFLOAT3 position;
+			DirectX::XMFLOAT4 colour(1.0f, 1.0f, 1.0f, 1.0f);
+
+			current = ParseFloat(current + 2, end, position.x);
+			if (current) current = ParseFloat(current, end, position.y);
+			if (current) current = ParseFloat(current, end, position.z);
+
+			if (!current)
+			{
+				verticesOut.resize(firstNewVertex);
+				indicesOut.resize(firstNewIndex);
+				return false;
+			}
+
+			// Optional vertex colour - anything else after the position (e.g. a w component) is left alone
+			const char* colourEnd = ParseFloat(current, end, colour.x);
+			if (colourEnd) colourEnd = ParseFloat(colourEnd, end, colour.y);
+			if (colourEnd) colourEnd = ParseFloat(colourEnd, end, colour.z);
+
+			if (!colourEnd)
+				colour = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+
+			positions.push_back(position);
+			colours.push_back(colour);
+			deduplicator.AddPosition();
+		}
+		else if (current + 2 < end && current[0] == 'v' && current[1] == 'n' && IsSpace(current[2]))
+		{
+			DirectX::XMFLOAT3 normal;
+
+			current = ParseFloat(current + 3, end, normal.x);
+			if (current) current = ParseFloat(current, end, normal.y);
+			if (current) current = ParseFloat(current, end, normal.z);
+
+			if (!current)
+			{
+				verticesOut.resize(firstNewVertex);
+				indicesOut.resize(firstNewIndex);
+				return false;
+			}
+
+			normals.push_back(normal);
+		}
+		else if (current + 1 < end && current[0] == 'f' && IsSpace(current[1]))
+		{
+			current += 2;
+
+			unsigned int cornerCount = 0;
+
+			while (true)
+			{
+				current = SkipSpaces(current, end);
+
+				if (current >= end || *current == '\n' || *current == '#')
+					break;
+
+				// Corner is "p", "p/t", "p//n" or "p/t/n"
+				long long              positionIndex = 0;
+				long long              normalIndex   = 0;
+				std::from_chars_result result        = std::from_chars(current, end, positionIndex);
+
+				bool valid = result.ec == std::errc();
+				current    = result.ptr;
+
+				if (valid && current < end && *current == '/')
+				{
+					current++;
+
+					// Skip the texture coordinate index
+					if (current < end && *current != '/')
+					{
+						long long textureIndex = 0;
+						result  = std::from_chars(current, end, textureIndex);
+						valid   = result.ec == std::errc();
+						current = result.ptr;
+					}
+
+					if (valid && current < end && *current == '/')
+					{
+						result  = std::from_chars(current + 1, end, normalIndex);
+						valid   = result.ec == std::errc();
+						current = result.ptr;
+					}
+				}
+
+				unsigned int position = 0;
+				unsigned int normal   = 0;
+
+				if (!valid || !ResolveIndex(positionIndex, positions.size(), position) || (normalIndex != 0 && !ResolveIndex(normalIndex, normals.size(), normal)))
+				{
+					verticesOut.resize(firstNewVertex);
+					indicesOut.resize(firstNewIndex);
+					return false;
+				}
+
+				// Normal key 0 stands for "no normal"
+				bool         added  = false;
+				unsigned int vertex = (unsigned int)firstNewVertex + deduplicator.FindOrAdd(position, normalIndex != 0 ? normal + 1 : 0, added);
+
+				if (added)
+				{
+					VertexData vertexData;
+					vertexData.vertexPosition = positions[position];
+					vertexData.normal         = normalIndex != 0 ? normals[normal] : DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+					vertexData.colour         = colours[position];
+
+					verticesOut.push_back(vertexData);
+				}
+
+				// Fan the polygon out from its first corner
+				if (cornerCount == 0)
+				{
+					firstCorner = vertex;
+				}
+				else if (cornerCount >= 2)
+				{
+					indicesOut.push_back(firstCorner);
+					indicesOut.push_back(previousCorner);
+					indicesOut.push_back(vertex);
+				}
+
+				previousCorner = vertex;
+				cornerCount++;
+			}
+		}
+
+		current = SkipLine(current, end);
+	}
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
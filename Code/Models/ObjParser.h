@@ -0,0 +1,24 @@
+#ifndef _OBJ_PARSER_H_
+#define _OBJ_PARSER_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "Model.h"
+
+// -------------------------------------------------------------------- //
+
+// Wavefront OBJ mesh parser that works straight off a block of memory (normally a MappedFile).
+// Reads "v" (with an optional "r g b" vertex colour after the position), "vn" and "f" lines - everything else is skipped. Polygons are
+// fanned into triangles, negative (relative) indices are supported, and each unique position/normal pair becomes one vertex.
+// Texture coordinate indices are accepted but ignored, as VertexData has nowhere to put them.
+struct ObjParser final
+{
+public:
+	// Appends to the outputs. Returns false on malformed numbers or out of range indices, leaving the outputs as they were.
+	static bool Parse(const char* data, size_t size, std::vector<VertexData>& verticesOut, std::vector<unsigned int>& indicesOut);
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
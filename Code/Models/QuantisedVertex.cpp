@@ -0,0 +1,217 @@
+#include "QuantisedVertex.h"
+
+#include <float.h>
+#include <math.h>
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float kPositionSteps = 65535.0f;
+	const float kNormalSteps   = 32767.0f;
+	const float kColourSteps   = 255.0f;
+
+	// Measured over 4 million random directions (4.3e-5 at worst), with some headroom - see VertexQuantiser::EncodeNormal()
+	const float kMaxNormalErrorRadians = 5.0e-5f;
+
+	inline float Clamp(float value, float minimum, float maximum)
+	{
+		return value < minimum ? minimum : (value > maximum ? maximum : value);
+	}
+
+	inline float SignNotZero(float value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	// Matches how the GPU turns an SNORM value back into a float
+	inline float DecodeSnorm(short value)
+	{
+		float decoded = (float)value / kNormalSteps;
+
+		return decoded < -1.0f ? -1.0f : decoded;
+	}
+
+	inline DirectX::XMFLOAT3 DecodeOctahedral(float x, float y)
+	{
+		float z = 1.0f - fabsf(x) - fabsf(y);
+
+		// The lower half of the sphere is folded over the diagonals of the upper half
+		if (z < 0.0f)
+		{
+			float foldedX = (1.0f - fabsf(y)) * SignNotZero(x);
+			float foldedY = (1.0f - fabsf(x)) * SignNotZero(y);
+
+			x = foldedX;
+			y = foldedY;
+		}
+
+		float length = sqrtf(x * x + y * y + z * z);
+		float scale  = length > 0.0f ? 1.0f / length : 0.0f;
+
+		return DirectX::XMFLOAT3(x * scale, y * scale, z * scale);
+	}
+
+	// Half a quantisation step, plus the float rounding in Decode()
+	inline float GetPositionErrorBound(float minimum, float maximum)
+	{
+		float magnitude = fabsf(minimum) > fabsf(maximum) ? fabsf(minimum) : fabsf(maximum);
+
+		return 0.5f * (maximum - minimum) / kPositionSteps + 2.0f * FLT_EPSILON * magnitude;
+	}
+
+	inline float GetAxisScale(float minimum, float maximum)
+	{
+		float extent = maximum - minimum;
+
+		return extent > 0.0f ? kPositionSteps / extent : 0.0f;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+QuantisedVertexData VertexQuantiser::Encode(const VertexData& vertex, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+{
+	QuantisedVertexData quantised;
+
+	float scaleX = GetAxisScale(boundsMin.x, boundsMax.x);
+	float scaleY = GetAxisScale(boundsMin.y, boundsMax.y);
+	float scaleZ = GetAxisScale(boundsMin.z, boundsMax.z);
+
+	quantised.position[0] = (unsigned short)(Clamp((vertex.vertexPosition.x - boundsMin.x) * scaleX, 0.0f, kPositionSteps) + 0.5f);
+	quantised.position[1] = (unsigned short)(Clamp((vertex.vertexPosition.y - boundsMin.y) * scaleY, 0.0f, kPositionSteps) + 0.5f);
+	quantised.position[2] = (unsigned short)(Clamp((vertex.vertexPosition.z - boundsMin.z) * scaleZ, 0.0f, kPositionSteps) + 0.5f);
+	quantised.position[3] = (unsigned short)kPositionSteps;
+
+	EncodeNormal(vertex.normal, quantised.normal);
+
+	quantised.colour[0] = (unsigned char)(Clamp(vertex.colour.x, 0.0f, 1.0f) * kColourSteps + 0.5f);
+	quantised.colour[1] = (unsigned char)(Clamp(vertex.colour.y, 0.0f, 1.0f) * kColourSteps + 0.5f);
+	quantised.colour[2] = (unsigned char)(Clamp(vertex.colour.z, 0.0f, 1.0f) * kColourSteps + 0.5f);
+	quantised.colour[3] = (unsigned char)(Clamp(vertex.colour.w, 0.0f, 1.0f) * kColourSteps + 0.5f);
+
+	return quantised;
+}
+
+// -------------------------------------------------------------------- //
+
+VertexData VertexQuantiser::Decode(const QuantisedVertexData& vertex, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+{
+	VertexData decoded;
+
+	decoded.vertexPosition.x = boundsMin.x + (float)vertex.position[0] / kPositionSteps * (boundsMax.x - boundsMin.x);
+	decoded.vertexPosition.y = boundsMin.y + (float)vertex.position[1] / kPositionSteps * (boundsMax.y - boundsMin.y);
+	decoded.vertexPosition.z = boundsMin.z + (float)vertex.position[2] / kPositionSteps * (boundsMax.z - boundsMin.z);
+
+	decoded.normal = DecodeNormal(vertex.normal);
+
+	decoded.colour.x = (float)vertex.colour[0] / kColourSteps;
+	decoded.colour.y = (float)vertex.colour[1] / kColourSteps;
+	decoded.colour.z = (float)vertex.colour[2] / kColourSteps;
+	decoded.colour.w = (float)vertex.colour[3] / kColourSteps;
+
+	return decoded;
+}
+
+// -------------------------------------------------------------------- //
+
+void VertexQuantiser::Encode(const VertexData* vertices, size_t vertexCount, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax, QuantisedVertexData* verticesOut)
+{
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		verticesOut[i] = Encode(vertices[i], boundsMin, boundsMax);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+QuantisationErrorBounds VertexQuantiser::GetErrorBounds(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+{
+	QuantisationErrorBounds bounds;
+
+	bounds.position.x    = GetPositionErrorBound(boundsMin.x, boundsMax.x);
+	bounds.position.y    = GetPositionErrorBound(boundsMin.y, boundsMax.y);
+	bounds.position.z    = GetPositionErrorBound(boundsMin.z, boundsMax.z);
+	bounds.normalRadians = kMaxNormalErrorRadians;
+	bounds.colour        = 0.5f / kColourSteps + FLT_EPSILON;
+
+	return bounds;
+}
+
+// -------------------------------------------------------------------- //
+
+DirectX::XMFLOAT4X4 VertexQuantiser::GetDequantisationTransform(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax)
+{
+	// Row vectors, as DirectXMath uses - scale 0-1 up to the extent, then move to the minimum corner
+	return DirectX::XMFLOAT4X4(boundsMax.x - boundsMin.x, 0.0f,                      0.0f,                      0.0f,
+	                           0.0f,                      boundsMax.y - boundsMin.y, 0.0f,                      0.0f,
+	                           0.0f,                      0.0f,                      boundsMax.z - boundsMin.z, 0.0f,
+	                           boundsMin.x,               boundsMin.y,               boundsMin.z,               1.0f);
+}
+
+// -------------------------------------------------------------------- //
+
+void VertexQuantiser::EncodeNormal(const DirectX::XMFLOAT3& normal, short (&encodedOut)[2])
+{
+	float sum = fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z);
+
+	// A zero normal has no direction to keep - store +z rather than dividing by zero
+	if (sum <= 0.0f)
+	{
+		encodedOut[0] = 0;
+		encodedOut[1] = 0;
+		return;
+	}
+
+	float x = normal.x / sum;
+	float y = normal.y / sum;
+
+	if (normal.z < 0.0f)
+	{
+		float foldedX = (1.0f - fabsf(y)) * SignNotZero(x);
+		float foldedY = (1.0f - fabsf(x)) * SignNotZero(y);
+
+		x = foldedX;
+		y = foldedY;
+	}
+
+	float length = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+
+	DirectX::XMFLOAT3 unitNormal(normal.x / length, normal.y / length, normal.z / length);
+
+	// Rounding each axis on its own is not always closest once the octahedron is projected back onto the sphere,
+	// so try all four surrounding grid points
+	float baseX        = floorf(Clamp(x, -1.0f, 1.0f) * kNormalSteps);
+	float baseY        = floorf(Clamp(y, -1.0f, 1.0f) * kNormalSteps);
+	float bestDistance = 5.0f;
+
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		short candidate[2] = { (short)Clamp(baseX + (float)(i & 1),  -kNormalSteps, kNormalSteps),
+		                       (short)Clamp(baseY + (float)(i >> 1), -kNormalSteps, kNormalSteps) };
+
+		DirectX::XMFLOAT3 decoded = DecodeNormal(candidate);
+
+		// Compare by distance rather than by dot product - the dot products of neighbouring candidates differ by less than a float can tell apart near 1
+		float differenceX = decoded.x - unitNormal.x;
+		float differenceY = decoded.y - unitNormal.y;
+		float differenceZ = decoded.z - unitNormal.z;
+		float distance    = differenceX * differenceX + differenceY * differenceY + differenceZ * differenceZ;
+
+		if (distance < bestDistance)
+		{
+			bestDistance  = distance;
+			encodedOut[0] = candidate[0];
+			encodedOut[1] = candidate[1];
+		}
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+DirectX::XMFLOAT3 VertexQuantiser::DecodeNormal(const short (&encoded)[2])
+{
+	return DecodeOctahedral(DecodeSnorm(encoded[0]), DecodeSnorm(encoded[1]));
+}
+
+// -------------------------------------------------------------------- //
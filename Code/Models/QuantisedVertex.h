@@ -0,0 +1,59 @@
+#ifndef _QUANTISED_VERTEX_H_
+#define _QUANTISED_VERTEX_H_
+
+#include <stddef.h>
+
+#include <directxmath.h>
+
+#include "Model.h"
+
+// -------------------------------------------------------------------- //
+
+// 16 byte version of VertexData, matching VertexLayout::QUANTISED in ShaderHandler:
+//   position - R16G16B16A16_UNORM, relative to the mesh bounds. w is always 1 so the shader gets a ready-to-use point.
+//   normal   - R16G16_SNORM, octahedral encoded
+//   colour   - R8G8B8A8_UNORM
+// The shader reads positions in the 0-1 range - put GetDequantisationTransform() in front of the world matrix to undo it.
+struct QuantisedVertexData final
+{
+	unsigned short position[4];
+	short          normal[2];
+	unsigned char  colour[4];
+};
+
+static_assert(sizeof(QuantisedVertexData) == 16, "QuantisedVertexData must match the quantised input layout");
+
+// -------------------------------------------------------------------- //
+
+// The most a value can change on a round trip through QuantisedVertexData
+struct QuantisationErrorBounds final
+{
+	DirectX::XMFLOAT3 position;      // Per axis, in model units - about half a step of the bounds split into 65535
+	float             normalRadians; // Angle between a unit normal and its decoded value
+	float             colour;        // Per channel, for colours within 0-1
+};
+
+// -------------------------------------------------------------------- //
+
+struct VertexQuantiser final
+{
+public:
+	// Positions outside the bounds are clamped to them, as are colour channels outside 0-1. Normals do not need to be unit length.
+	static QuantisedVertexData     Encode(const VertexData& vertex, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax);
+	static VertexData              Decode(const QuantisedVertexData& vertex, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax);
+
+	static void                    Encode(const VertexData* vertices, size_t vertexCount, const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax, QuantisedVertexData* verticesOut);
+
+	static QuantisationErrorBounds GetErrorBounds(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax);
+
+	// Maps the 0-1 positions the shader sees back into model space
+	static DirectX::XMFLOAT4X4     GetDequantisationTransform(const DirectX::XMFLOAT3& boundsMin, const DirectX::XMFLOAT3& boundsMax);
+
+	// Octahedral normal encoding on its own. The encoder checks the neighbouring grid points and keeps whichever decodes closest.
+	static void                    EncodeNormal(const DirectX::XMFLOAT3& normal, short (&encodedOut)[2]);
+	static DirectX::XMFLOAT3       DecodeNormal(const short (&encoded)[2]);
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -96,7 +96,7 @@ ID3D11PixelShader* ShaderHandler::CompilePixelShader(WCHAR* filePathToOverallSha
 // ------------------------------------------------------------------------------------------ //
 
 // Setting how the device will be accessing from shader buffers - when 
-bool ShaderHandler::SetDeviceInputLayout(ID3DBlob* vertexShaderBlob)
+bool ShaderHandler::SetDeviceInputLayout(ID3DBlob* vertexShaderBlob, VertexLayout vertexLayout)
 {
     // Define the input layout for the data
     D3D11_INPUT_ELEMENT_DESC layout[] =
@@ -105,12 +105,28 @@ bool ShaderHandler::SetDeviceInputLayout(ID3DBlob* vertexShaderBlob)
         { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
 	};
 
-	UINT numElements = ARRAYSIZE(layout);
+    // Matches QuantisedVertexData - the GPU unpacks the normalised values, so the shader still receives floats.
+    // The position comes out in the 0-1 range of the mesh bounds, with w already 1.
+    D3D11_INPUT_ELEMENT_DESC quantisedLayout[] =
+    {
+        { "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "NORMAL",   0, DXGI_FORMAT_R16G16_SNORM,       0, 8,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    };
+
+    const D3D11_INPUT_ELEMENT_DESC* elements    = layout;
+    UINT                            numElements = ARRAYSIZE(layout);
+
+    if (vertexLayout == VertexLayout::QUANTISED)
+    {
+        elements    = quantisedLayout;
+        numElements = ARRAYSIZE(quantisedLayout);
+    }
 
     // Create the input layout
-    ID3D11InputLayout* vertexLayout;
+    ID3D11InputLayout* inputLayout;
     HRESULT hr;
-    hr = mDeviceHandle->CreateInputLayout(layout, numElements, vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize(), &vertexLayout);
+    hr = mDeviceHandle->CreateInputLayout(elements, numElements, vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize(), &inputLayout);
     if (FAILED(hr))
     {
         vertexShaderBlob->Release();
@@ -122,7 +138,7 @@ bool ShaderHandler::SetDeviceInputLayout(ID3DBlob* vertexShaderBlob)
     vertexShaderBlob = nullptr;
 
     // Set the input layout
-    mDeviceContext->IASetInputLayout(vertexLayout);
+    mDeviceContext->IASetInputLayout(inputLayout);
 
     return true;
 }
@@ -17,6 +17,15 @@ struct VertexShaderReturnData
 
 // ----------------------------------------------------------------------------------------------- /
 
+// The vertex formats that SetDeviceInputLayout() can describe
+enum class VertexLayout
+{
+	POSITION_COLOUR, // float3 position followed by a float4 colour
+	QUANTISED        // QuantisedVertexData - 16 bytes per vertex
+};
+
+// ----------------------------------------------------------------------------------------------- /
+
 class ShaderHandler final
 {
 public:
@@ -28,7 +37,7 @@ public:
 	ID3D11PixelShader*     CompilePixelShader(WCHAR* filePathToOverallShader, LPCSTR nameOfPixelMainFunction);
 
 	// Setting how the device will be accessing from shader buffers
-	bool SetDeviceInputLayout(ID3DBlob* vertexShaderBlob);
+	bool SetDeviceInputLayout(ID3DBlob* vertexShaderBlob, VertexLayout vertexLayout = VertexLayout::POSITION_COLOUR);
 
 	// Buffer creation
 	bool CreateBuffer(D3D11_USAGE usageType, D3D11_BIND_FLAG bindFlags, D3D11_CPU_ACCESS_FLAG  CPUAccessFlag, void* bufferData, unsigned int bytesInBuffer, ID3D11Buffer** returnBuffer);
@@ -13,6 +13,9 @@ TestCube::TestCube(ShaderHandler& shaderHandler, Vector3D position)
 	, mIndexBuffer(nullptr)
 	, mVertexBuffer(nullptr)
 	, mPosition(position)
+	, mLastCamera(nullptr)
+	, mLastCameraVersion(0)
+	, mConstantsDirty(true)
 {
 	// ------------------------------------------------------------------------------------------------------------------------------------- 
 
@@ -136,22 +139,22 @@ void TestCube::Render(BaseCamera* camera)
 	if (!camera)
 		return;
 
-	// Get the local stored world matrix for this object
-	DirectX::XMMATRIX world      = DirectX::XMLoadFloat4x4(&modelMat);
-
-	ConstantBuffer cb;
-	cb.mWorld = XMMatrixTranspose(world);
+	// The constant buffer only needs re-uploading if this cube has moved or the camera has changed since it was last sent
+	if (mConstantsDirty || camera != mLastCamera || camera->GetViewProjectionVersion() != mLastCameraVersion)
+	{
+		ConstantBuffer cb;
+		cb.mWorld      = DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&modelMat));
 
-	// Get the view and projection matrixes from the camera and transpose them before passing into the shader
-	DirectX::XMMATRIX view;
-					  view     = DirectX::XMLoadFloat4x4(&camera->GetViewMatrix());
-	                  cb.mView = DirectX::XMMatrixTranspose(view);
+		// The camera keeps its matrices pre-transposed for the shader
+		cb.mView       = DirectX::XMLoadFloat4x4(&camera->GetTransposedViewMatrix());
+		cb.mProjection = DirectX::XMLoadFloat4x4(&camera->GetTransposedPerspectiveMatrix());
 
-	DirectX::XMMATRIX projection;
-					  projection     = DirectX::XMLoadFloat4x4(&camera->GetPerspectiveMatrix());
-					  cb.mProjection = DirectX::XMMatrixTranspose(projection);
+		mShaderHandler.UpdateSubresource(mConstantBuffer, 0, nullptr, &cb, 0, 0);
 
-	mShaderHandler.UpdateSubresource(mConstantBuffer, 0, nullptr, &cb, 0, 0);
+		mLastCamera        = camera;
+		mLastCameraVersion = camera->GetViewProjectionVersion();
+		mConstantsDirty    = false;
+	}
 
 	// Set the shaders
 	mShaderHandler.SetVertexShader(mVertexShader);
@@ -170,7 +173,8 @@ void TestCube::Update(const float deltaTime)
 	UNREFERENCED_PARAMETER(deltaTime);
 
 	// Make sure that the cube's position is always where it is internally stored
-	DirectX::XMStoreFloat4x4(&modelMat, DirectX::XMMatrixTranslation(mPosition.x, mPosition.y, mPosition.z));
+	if (mConstantsDirty)
+		DirectX::XMStoreFloat4x4(&modelMat, DirectX::XMMatrixTranslation(mPosition.x, mPosition.y, mPosition.z));
 }
 
 // ---------------------------------------------------------------- //
@@ -178,6 +182,8 @@ void TestCube::Update(const float deltaTime)
 void TestCube::move(const float deltaTime)
 {
 	mPosition.y += 0.1f * deltaTime;
+
+	mConstantsDirty = true;
 }
 
 // ---------------------------------------------------------------- //
\ No newline at end of file
@@ -34,6 +34,10 @@ public:
 
 	void move(const float deltaTime);
 
+	// World space bounds, used for frustum culling
+	Vector3D GetPosition()    const { return mPosition; }
+	Vector3D GetHalfExtents() const { return Vector3D(1.0f, 1.0f, 1.0f); }
+
 private:
 	ShaderHandler&     mShaderHandler;
 
@@ -46,6 +50,11 @@ private:
 	Vector3D            mPosition;
 
 	DirectX::XMFLOAT4X4 modelMat;
+
+	// What the constant buffer was last filled from
+	BaseCamera*         mLastCamera;
+	unsigned int        mLastCameraVersion;
+	bool                mConstantsDirty;
 	//DirectX::XMFLOAT4X4 viewMat;
 	//DirectX::XMFLOAT4X4 projectionMat;
 };
@@ -0,0 +1,155 @@
+#include "WorkerPool.h"
+
+#include <atomic>
+#include <memory>
+
+// -------------------------------------------------------------------- //
+
+WorkerPool::WorkerPool(unsigned int workerCount)
+	: mWorkers()
+	, mJobs()
+	, mMutex()
+	, mJobAvailable()
+	, mAllJobsDone()
+	, mRunningJobCount(0)
+	, mShuttingDown(false)
+{
+	if (workerCount == 0)
+		workerCount = std::thread::hardware_concurrency();
+
+	// hardware_concurrency() is allowed to return 0 if it cannot tell
+	if (workerCount == 0)
+		workerCount = 1;
+
+	mWorkers.reserve(workerCount);
+
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		mWorkers.emplace_back(&WorkerPool::WorkerLoop, this);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mShuttingDown = true;
+	}
+
+	mJobAvailable.notify_all();
+
+	for (std::thread& worker : mWorkers)
+	{
+		worker.join();
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+void WorkerPool::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push_back(std::move(job));
+	}
+
+	mJobAvailable.notify_one();
+}
+
+// -------------------------------------------------------------------- //
+
+void WorkerPool::WaitForAll()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	mAllJobsDone.wait(lock, [this]() { return mJobs.empty() && mRunningJobCount == 0; });
+}
+
+// -------------------------------------------------------------------- //
+
+void WorkerPool::ParallelFor(unsigned int itemCount, unsigned int rangeSize, const std::function<void(unsigned int, unsigned int)>& job)
+{
+	if (itemCount == 0)
+		return;
+
+	if (rangeSize == 0)
+		rangeSize = 1;
+
+	// Shared with the helper jobs, which can still be sat in the queue after this returns - they find no ranges left and leave
+	struct Ranges final
+	{
+		std::atomic<unsigned int> next;
+		std::atomic<unsigned int> finished;
+		std::mutex                mutex;
+		std::condition_variable   allFinished;
+	};
+
+	std::shared_ptr<Ranges> ranges     = std::make_shared<Ranges>();
+	unsigned int            rangeCount = (itemCount - 1) / rangeSize + 1;
+
+	ranges->next     = 0;
+	ranges->finished = 0;
+
+	// job is only used while a range is being run, and every range has finished before this returns, so taking it by reference is safe
+	auto runRanges = [ranges, rangeCount, rangeSize, itemCount, &job]()
+	{
+		for (unsigned int range = ranges->next++; range < rangeCount; range = ranges->next++)
+		{
+			unsigned int first = range * rangeSize;
+
+			job(first, itemCount - first < rangeSize ? itemCount : first + rangeSize);
+
+			if (++ranges->finished == rangeCount)
+			{
+				std::lock_guard<std::mutex> lock(ranges->mutex);
+				ranges->allFinished.notify_all();
+			}
+		}
+	};
+
+	unsigned int helperCount = rangeCount - 1 < GetWorkerCount() ? rangeCount - 1 : GetWorkerCount();
+
+	for (unsigned int i = 0; i < helperCount; i++)
+	{
+		Submit(runRanges);
+	}
+
+	runRanges();
+
+	std::unique_lock<std::mutex> lock(ranges->mutex);
+
+	ranges->allFinished.wait(lock, [&ranges, rangeCount]() { return ranges->finished == rangeCount; });
+}
+
+// -------------------------------------------------------------------- //
+
+void WorkerPool::WorkerLoop()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	while (true)
+	{
+		mJobAvailable.wait(lock, [this]() { return mShuttingDown || !mJobs.empty(); });
+
+		// Only leave once the queue has drained, so nothing submitted is dropped
+		if (mJobs.empty())
+			return;
+
+		std::function<void()> job = std::move(mJobs.front());
+		mJobs.pop_front();
+		mRunningJobCount++;
+
+		lock.unlock();
+		job();
+		lock.lock();
+
+		mRunningJobCount--;
+
+		if (mJobs.empty() && mRunningJobCount == 0)
+			mAllJobsDone.notify_all();
+	}
+}
+
+// -------------------------------------------------------------------- //
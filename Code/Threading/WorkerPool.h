@@ -0,0 +1,53 @@
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// -------------------------------------------------------------------- //
+
+// A fixed set of threads pulling jobs off a shared first-in-first-out queue.
+// Jobs must not throw, and must not touch anything that is only safe on the main thread (e.g. the immediate device context).
+class WorkerPool final
+{
+public:
+	// Zero means one worker per hardware thread
+	WorkerPool(unsigned int workerCount = 0);
+	~WorkerPool(); // Finishes every queued job before returning
+
+	WorkerPool(const WorkerPool&)            = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	void         Submit(std::function<void()> job);
+
+	// Blocks until the queue is empty and no job is running
+	void         WaitForAll();
+
+	// Splits [0, itemCount) into ranges of rangeSize items and runs job(first, end) on each, spread over the workers. The calling
+	// thread takes ranges too, and only waits on ranges already started, so this is safe to call from inside a job on the same pool.
+	// Which thread runs a range varies from call to call - jobs that need repeatable results must not depend on it.
+	void         ParallelFor(unsigned int itemCount, unsigned int rangeSize, const std::function<void(unsigned int, unsigned int)>& job);
+
+	unsigned int GetWorkerCount() const { return (unsigned int)mWorkers.size(); }
+
+private:
+	void WorkerLoop();
+
+	std::vector<std::thread>          mWorkers;
+	std::deque<std::function<void()>> mJobs;
+
+	std::mutex                        mMutex;
+	std::condition_variable           mJobAvailable;
+	std::condition_variable           mAllJobsDone;
+
+	unsigned int                      mRunningJobCount;
+	bool                              mShuttingDown;
+};
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _PACKED_TRACK_PIECE_H_
+#define _PACKED_TRACK_PIECE_H_
+
+#include <math.h>
+
+#include <DirectXMath.h>
+
+#include "TrackPieceType.h"
+
+// -------------------------------------------------------------------- //
+
+// Track pieces only ever face along one of the grid's axes
+enum class TrackRotation : unsigned int
+{
+	POSITIVE_Z = 0,
+	POSITIVE_X,
+	NEGATIVE_Z,
+	NEGATIVE_X,
+	POSITIVE_Y,
+	NEGATIVE_Y,
+
+	MAX
+};
+
+// -------------------------------------------------------------------- //
+
+// A placed track piece in 8 bytes, for storing whole tracks contiguously. The model and collision data are shared between every
+// piece of the same type, so they are looked up from TrackPieceFactory rather than stored. Use the factory to turn one back into a TrackPiece.
+//
+// Bit layout: [0, 5) type | [5, 8) rotation | [8, 26) grid x | [26, 44) grid y | [44, 62) grid z | [62, 64) unused
+struct PackedTrackPiece final
+{
+public:
+	constexpr PackedTrackPiece() : mBits(0) {}
+
+	// Coordinates above kMaxGridCoordinate lose their high bits, so check GetCanPack() first
+	PackedTrackPiece(TrackPieceType type, TrackRotation rotation, const DirectX::XMUINT3& gridPosition)
+		: mBits(  ( (unsigned long long)type           & kTypeMask)
+		        | (((unsigned long long)rotation       & kRotationMask)   << kRotationShift)
+		        | (((unsigned long long)gridPosition.x & kCoordinateMask) << kXShift)
+		        | (((unsigned long long)gridPosition.y & kCoordinateMask) << kYShift)
+		        | (((unsigned long long)gridPosition.z & kCoordinateMask) << kZShift))
+	{}
+
+	TrackPieceType   GetType()         const { return (TrackPieceType)(mBits & kTypeMask); }
+	TrackRotation    GetRotation()     const { return (TrackRotation)((mBits >> kRotationShift) & kRotationMask); }
+	DirectX::XMUINT3 GetGridPosition() const { return DirectX::XMUINT3((unsigned int)((mBits >> kXShift) & kCoordinateMask),
+		                                                               (unsigned int)((mBits >> kYShift) & kCoordinateMask),
+		                                                               (unsigned int)((mBits >> kZShift) & kCoordinateMask)); }
+
+	void SetType(TrackPieceType type)                         { *this = PackedTrackPiece(type, GetRotation(), GetGridPosition()); }
+	void SetRotation(TrackRotation rotation)                  { *this = PackedTrackPiece(GetType(), rotation, GetGridPosition()); }
+	void SetGridPosition(const DirectX::XMUINT3& gridPosition) { *this = PackedTrackPiece(GetType(), GetRotation(), gridPosition); }
+
+	bool operator==(const PackedTrackPiece& other) const { return mBits == other.mBits; }
+	bool operator!=(const PackedTrackPiece& other) const { return mBits != other.mBits; }
+
+	// Positions with any coordinate above this cannot be packed
+	static bool GetCanPack(const DirectX::XMUINT3& gridPosition) { return gridPosition.x <= kCoordinateMask && gridPosition.y <= kCoordinateMask && gridPosition.z <= kCoordinateMask; }
+
+	static const unsigned int kMaxGridCoordinate = (1u << 18) - 1u;
+
+	// Conversions between the quantised rotation and the facing direction that TrackPiece stores
+	static DirectX::XMFLOAT3 GetFacingDirection(TrackRotation rotation);
+	static TrackRotation     QuantiseFacingDirection(const DirectX::XMFLOAT3& facingDirection);
+
+private:
+	static const unsigned long long kTypeMask       = 0x1F;
+	static const unsigned long long kRotationMask   = 0x07;
+	static const unsigned long long kCoordinateMask = kMaxGridCoordinate;
+
+	static const unsigned int       kRotationShift  = 5;
+	static const unsigned int       kXShift         = 8;
+	static const unsigned int       kYShift         = 26;
+	static const unsigned int       kZShift         = 44;
+
+	unsigned long long mBits;
+};
+
+static_assert(sizeof(PackedTrackPiece) == 8,           "PackedTrackPiece must stay 8 bytes");
+static_assert((unsigned int)TrackPieceType::MAX <= 32, "TrackPieceType no longer fits in the packed type bits");
+static_assert((unsigned int)TrackRotation::MAX  <= 8,  "TrackRotation no longer fits in the packed rotation bits");
+
+// -------------------------------------------------------------------- //
+
+inline DirectX::XMFLOAT3 PackedTrackPiece::GetFacingDirection(TrackRotation rotation)
+{
+	switch (rotation)
+	{
+	case TrackRotation::POSITIVE_X: return DirectX::XMFLOAT3( 1.0f,  0.0f,  0.0f);
+	case TrackRotation::NEGATIVE_Z: return DirectX::XMFLOAT3( 0.0f,  0.0f, -1.0f);
+	case TrackRotation::NEGATIVE_X: return DirectX::XMFLOAT3(-1.0f,  0.0f,  0.0f);
+	case TrackRotation::POSITIVE_Y: return DirectX::XMFLOAT3( 0.0f,  1.0f,  0.0f);
+	case TrackRotation::NEGATIVE_Y: return DirectX::XMFLOAT3( 0.0f, -1.0f,  0.0f);
+	default:                        return DirectX::XMFLOAT3( 0.0f,  0.0f,  1.0f);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+inline TrackRotation PackedTrackPiece::QuantiseFacingDirection(const DirectX::XMFLOAT3& facingDirection)
+{
+	// Snap to whichever axis the direction is closest to - ties go to Z, then X, which keeps flat pieces flat
+	float absX = fabsf(facingDirection.x);
+	float absY = fabsf(facingDirection.y);
+	float absZ = fabsf(facingDirection.z);
+
+	if (absZ >= absX && absZ >= absY)
+		return facingDirection.z >= 0.0f ? TrackRotation::POSITIVE_Z : TrackRotation::NEGATIVE_Z;
+
+	if (absX >= absY)
+		return facingDirection.x >= 0.0f ? TrackRotation::POSITIVE_X : TrackRotation::NEGATIVE_X;
+
+	return facingDirection.y >= 0.0f ? TrackRotation::POSITIVE_Y : TrackRotation::NEGATIVE_Y;
+}
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -0,0 +1,246 @@
+#include "TrackGrid.h"
+
+#include "TrackPiece.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// Offsets matching the order of GridDirection
+	const int kDirectionOffsets[(unsigned int)GridDirection::MAX][3] =
+	{
+		{  1,  0,  0 },
+		{ -1,  0,  0 },
+		{  0,  1,  0 },
+		{  0, -1,  0 },
+		{  0,  0,  1 },
+		{  0,  0, -1 }
+	};
+
+	unsigned int RoundUpToPowerOfTwo(unsigned int value)
+	{
+		unsigned int result = 1;
+
+		while (result < value)
+			result <<= 1;
+
+		return result;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+TrackGrid::TrackGrid(unsigned int initialCapacity)
+	: mSlots()
+	, mMask(0)
+	, mCount(0)
+{
+	Rehash(RoundUpToPowerOfTwo(initialCapacity < 8 ? 8 : initialCapacity));
+}
+
+// -------------------------------------------------------------------- //
+
+TrackGrid::~TrackGrid()
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackGrid::Insert(const DirectX::XMUINT3& cell, TrackPiece* piece)
+{
+	if (!piece || !GetIsCellInGrid(cell))
+		return false;
+
+	// Keep the load factor below 0.7 so that probe chains stay short
+	if ((unsigned long long)(mCount + 1) * 10 > (unsigned long long)mSlots.size() * 7)
+		Rehash((unsigned int)mSlots.size() * 2);
+
+	unsigned long long key  = PackCell(cell);
+	unsigned int       slot = FindSlot(key);
+
+	if (mSlots[slot].key == key)
+		return false;
+
+	mSlots[slot].key   = key;
+	mSlots[slot].piece = piece;
+	mCount++;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackGrid::Insert(TrackPiece* piece)
+{
+	if (!piece)
+		return false;
+
+	return Insert(piece->GetGridPosition(), piece);
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackGrid::Remove(const DirectX::XMUINT3& cell)
+{
+	if (!GetIsCellInGrid(cell))
+		return false;
+
+	unsigned int slot = FindSlot(PackCell(cell));
+
+	if (mSlots[slot].key == kEmptyKey)
+		return false;
+
+	// Backward-shift deletion - pull later entries in the probe chain back into the gap so that no tombstones are needed
+	unsigned int gap  = slot;
+	unsigned int next = (gap + 1) & mMask;
+
+	while (mSlots[next].key != kEmptyKey)
+	{
+		unsigned int ideal = (unsigned int)Hash(mSlots[next].key) & mMask;
+
+		// Only move the entry if the gap lies between where it wants to be and where it is (cyclically)
+		if (((next - ideal) & mMask) >= ((next - gap) & mMask))
+		{
+			mSlots[gap] = mSlots[next];
+			gap         = next;
+		}
+
+		next = (next + 1) & mMask;
+	}
+
+	mSlots[gap].key   = kEmptyKey;
+	mSlots[gap].piece = nullptr;
+	mCount--;
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+TrackPiece* TrackGrid::Find(const DirectX::XMUINT3& cell) const
+{
+	if (!GetIsCellInGrid(cell))
+		return nullptr;
+
+	// The empty slot's piece is nullptr, so there is no need to check which case was hit
+	return mSlots[FindSlot(PackCell(cell))].piece;
+}
+
+// -------------------------------------------------------------------- //
+
+TrackPiece* TrackGrid::GetNeighbour(const DirectX::XMUINT3& cell, GridDirection direction) const
+{
+	const int* offset = kDirectionOffsets[(unsigned int)direction];
+
+	// Unsigned wrap-around takes cells off the negative edge out of the grid, so Find() rejects them
+	DirectX::XMUINT3 neighbour(cell.x + offset[0], cell.y + offset[1], cell.z + offset[2]);
+
+	return Find(neighbour);
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int TrackGrid::GetNeighbours(const DirectX::XMUINT3& cell, TrackPiece* (&neighboursOut)[(unsigned int)GridDirection::MAX]) const
+{
+	unsigned int found = 0;
+
+	for (unsigned int i = 0; i < (unsigned int)GridDirection::MAX; i++)
+	{
+		neighboursOut[i] = GetNeighbour(cell, (GridDirection)i);
+
+		if (neighboursOut[i])
+			found++;
+	}
+
+	return found;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackGrid::Reserve(unsigned int pieceCount)
+{
+	unsigned int neededCapacity = RoundUpToPowerOfTwo((unsigned int)(((unsigned long long)pieceCount * 10) / 7 + 1));
+
+	if (neededCapacity > mSlots.size())
+		Rehash(neededCapacity);
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackGrid::Clear()
+{
+	for (Slot& slot : mSlots)
+	{
+		slot.key   = kEmptyKey;
+		slot.piece = nullptr;
+	}
+
+	mCount = 0;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned long long TrackGrid::PackCell(const DirectX::XMUINT3& cell)
+{
+	return ((unsigned long long)cell.x << 42) | ((unsigned long long)cell.y << 21) | (unsigned long long)cell.z;
+}
+
+// -------------------------------------------------------------------- //
+
+DirectX::XMUINT3 TrackGrid::UnpackCell(unsigned long long key)
+{
+	return DirectX::XMUINT3((unsigned int)(key >> 42) & kMaxGridCoordinate, (unsigned int)(key >> 21) & kMaxGridCoordinate, (unsigned int)key & kMaxGridCoordinate);
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned long long TrackGrid::Hash(unsigned long long key)
+{
+	// 64 bit finaliser from MurmurHash3 - neighbouring cells differ in only a few bits so they need mixing across the whole word
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ull;
+	key ^= key >> 33;
+
+	return key;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int TrackGrid::FindSlot(unsigned long long key) const
+{
+	unsigned int slot = (unsigned int)Hash(key) & mMask;
+
+	// The load factor cap guarantees there is always an empty slot to stop at
+	while (mSlots[slot].key != key && mSlots[slot].key != kEmptyKey)
+		slot = (slot + 1) & mMask;
+
+	return slot;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackGrid::Rehash(unsigned int newCapacity)
+{
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(mSlots);
+
+	Slot emptySlot;
+	emptySlot.key   = kEmptyKey;
+	emptySlot.piece = nullptr;
+
+	mSlots.assign(newCapacity, emptySlot);
+	mMask = newCapacity - 1;
+
+	for (const Slot& slot : oldSlots)
+	{
+		if (slot.key == kEmptyKey)
+			continue;
+
+		mSlots[FindSlot(slot.key)] = slot;
+	}
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,99 @@
+#ifndef _TRACK_GRID_H_
+#define _TRACK_GRID_H_
+
+#include <vector>
+
+#include <DirectXMath.h>
+
+class TrackPiece;
+
+// -------------------------------------------------------------------- //
+
+enum class GridDirection : unsigned int
+{
+	POSITIVE_X = 0,
+	NEGATIVE_X,
+	POSITIVE_Y,
+	NEGATIVE_Y,
+	POSITIVE_Z,
+	NEGATIVE_Z,
+
+	MAX
+};
+
+// -------------------------------------------------------------------- //
+
+// Sparse index of which track piece is in which grid cell.
+// Open-addressing hash map (linear probing, backward-shift deletion) keyed on the cell's coordinates packed into 63 bits,
+// so lookups touch one or two cache lines however large the track gets and empty space costs nothing.
+// Each axis can hold coordinates up to kMaxGridCoordinate. The grid does not own the pieces.
+class TrackGrid final
+{
+public:
+	TrackGrid(unsigned int initialCapacity = 64);
+	~TrackGrid();
+
+	// Fails if the cell is already taken or is outside of the grid
+	bool         Insert(const DirectX::XMUINT3& cell, TrackPiece* piece);
+	bool         Insert(TrackPiece* piece);     // Uses the piece's own grid position
+	bool         Remove(const DirectX::XMUINT3& cell);
+
+	TrackPiece*  Find(const DirectX::XMUINT3& cell) const;
+	bool         Contains(const DirectX::XMUINT3& cell) const { return Find(cell) != nullptr; }
+
+	// nullptr if there is nothing next to the cell in that direction
+	TrackPiece*  GetNeighbour(const DirectX::XMUINT3& cell, GridDirection direction) const;
+
+	// Fills neighboursOut with the piece in each direction (nullptr where empty) and returns how many were found
+	unsigned int GetNeighbours(const DirectX::XMUINT3& cell, TrackPiece* (&neighboursOut)[(unsigned int)GridDirection::MAX]) const;
+
+	// Calls function(cell, piece) for every piece in the grid, in no particular order
+	template<typename Function>
+	void         ForEach(Function function) const;
+
+	void         Reserve(unsigned int pieceCount);
+	void         Clear();
+
+	unsigned int GetCount()    const { return mCount; }
+	unsigned int GetCapacity() const { return (unsigned int)mSlots.size(); }
+
+	static bool  GetIsCellInGrid(const DirectX::XMUINT3& cell) { return cell.x <= kMaxGridCoordinate && cell.y <= kMaxGridCoordinate && cell.z <= kMaxGridCoordinate; }
+
+	static const unsigned int kMaxGridCoordinate = (1u << 21) - 1u;
+
+private:
+	struct Slot final
+	{
+		unsigned long long key;
+		TrackPiece*        piece;
+	};
+
+	static const unsigned long long kEmptyKey = ~0ull; // Never produced by PackCell as the top bit is always clear
+
+	static unsigned long long PackCell(const DirectX::XMUINT3& cell);
+	static DirectX::XMUINT3   UnpackCell(unsigned long long key);
+	static unsigned long long Hash(unsigned long long key);
+
+	unsigned int FindSlot(unsigned long long key) const; // Returns the slot holding the key, or the empty slot where it would go
+	void         Rehash(unsigned int newCapacity);
+
+	std::vector<Slot> mSlots;
+	unsigned int      mMask;
+	unsigned int      mCount;
+};
+
+// -------------------------------------------------------------------- //
+
+template<typename Function>
+void TrackGrid::ForEach(Function function) const
+{
+	for (const Slot& slot : mSlots)
+	{
+		if (slot.key != kEmptyKey)
+			function(UnpackCell(slot.key), slot.piece);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+#endif
@@ -5,8 +5,9 @@
 
 // -------------------------------------------------------------------- //
 
-TrackPiece::TrackPiece(Model& model, TrackCollision& collision)
-	: mGridPosition(0, 0, 0)
+TrackPiece::TrackPiece(TrackPieceType type, Model& model, TrackCollision& collision)
+	: mType(type)
+	, mGridPosition(0, 0, 0)
 	, mFacingDirection(0.0f, 0.0f, 0.0f)
 	, mModel(model)
 	, mCollision(collision)
@@ -16,9 +17,46 @@ TrackPiece::TrackPiece(Model& model, TrackCollision& collision)
 
 // -------------------------------------------------------------------- //
 
+TrackPiece::TrackPiece(const PackedTrackPiece& packedPiece, Model& model, TrackCollision& collision)
+	: mType(packedPiece.GetType())
+	, mGridPosition(packedPiece.GetGridPosition())
+	, mFacingDirection(PackedTrackPiece::GetFacingDirection(packedPiece.GetRotation()))
+	, mModel(model)
+	, mCollision(collision)
+{
+
+}
+
+// -------------------------------------------------------------------- //
+
 TrackPiece::~TrackPiece()
 {
 
 }
 
+// -------------------------------------------------------------------- //
+
+bool TrackPiece::Pack(PackedTrackPiece& packedPieceOut) const
+{
+	if (!PackedTrackPiece::GetCanPack(mGridPosition))
+		return false;
+
+	packedPieceOut = PackedTrackPiece(mType, PackedTrackPiece::QuantiseFacingDirection(mFacingDirection), mGridPosition);
+
+	return true;
+}
+
+// -------------------------------------------------------------------- //
+
+DirectX::XMFLOAT4X4 TrackPiece::GetAssetTransformMatrix() const
+{
+	DirectX::XMFLOAT4X4 matrix;
+	DirectX::XMStoreFloat4x4(&matrix, DirectX::XMMatrixIdentity());
+
+	if (GetAssetTransform() == TrackPieceAssetTransform::MIRROR_X)
+		matrix._11 = -1.0f;
+
+	return matrix;
+}
+
 // -------------------------------------------------------------------- //
\ No newline at end of file
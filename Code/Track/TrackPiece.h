@@ -3,6 +3,8 @@
 
 #include <DirectXMath.h>
 
+#include "PackedTrackPiece.h"
+
 class Model;
 class TrackCollision;
 
@@ -11,10 +13,35 @@ class TrackCollision;
 class TrackPiece final
 {
 public:
-	TrackPiece(Model& model, TrackCollision& collision);
+	TrackPiece(TrackPieceType type, Model& model, TrackCollision& collision);
+	TrackPiece(const PackedTrackPiece& packedPiece, Model& model, TrackCollision& collision);
 	~TrackPiece();
 
+	// The facing direction is snapped to the nearest axis. Fails, leaving packedPieceOut alone, if the grid position does not pass
+	// PackedTrackPiece::GetCanPack() - a TrackGrid takes coordinates further out than the packed form can hold.
+	bool                     Pack(PackedTrackPiece& packedPieceOut) const;
+
+	TrackPieceType           GetType() const { return mType; }
+
+	// For mirrored types these are the source type's data - GetAssetTransform() says how to get from it to this piece
+	Model&                   GetModel()     const { return mModel; }
+	TrackCollision&          GetCollision() const { return mCollision; }
+
+	TrackPieceAssetTransform GetAssetTransform() const { return GetTrackPieceAssetTransform(mType); }
+
+	// Goes before the piece's own placement. A mirroring transform flips the winding, so the model must be drawn with the front face swapped.
+	DirectX::XMFLOAT4X4      GetAssetTransformMatrix() const;
+
+	// Changing the grid position does not move the piece within a TrackGrid - remove it and re-insert it
+	const DirectX::XMUINT3&  GetGridPosition() const                         { return mGridPosition; }
+	void                     SetGridPosition(const DirectX::XMUINT3& position) { mGridPosition = position; }
+
+	const DirectX::XMFLOAT3& GetFacingDirection() const                           { return mFacingDirection; }
+	void                     SetFacingDirection(const DirectX::XMFLOAT3& direction) { mFacingDirection = direction; }
+
 private:
+	TrackPieceType    mType;
+
 	DirectX::XMUINT3  mGridPosition;
 	DirectX::XMFLOAT3 mFacingDirection;
 
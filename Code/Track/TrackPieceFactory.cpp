@@ -1,51 +1,644 @@
 #include "TrackPieceFactory.h"
 
+#include <chrono>
+
 #include "../Models/Model.h"
 #include "../Collisions/TrackCollision.h"
+#include "../Threading/WorkerPool.h"
 
 // -------------------------------------------------------------------- //
 
-TrackPieceFactory::TrackPieceFactory(ShaderHandler& shaderHander) 
+TrackPieceFactory::TrackPieceFactory(ShaderHandler& shaderHander, const std::string& assetArchivePath) 
 	: mShaderHandler(shaderHander)
 	, kFilePathsToModels({ "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", })
 	, kFilePathsToCollisionData({ "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", "", })
+	, kAssetNames({ "start_one_entrance", "start_straight_through", "start_t_piece", "start_open", "start_air",
+	                "end_one_entrance", "end_straight_through", "end_t_piece", "end_open", "end_air",
+	                "checkpoint_straight_track", "checkpoint_air", "checkpoint_curve_left", "checkpoint_curve_right", "checkpoint_slope_up", "checkpoint_slope_down",
+	                "slope_up", "slope_up_right", "slope_up_left", "slope_down", "slope_down_right", "slope_down_left",
+	                "straight_forward", "t_piece", "four_cross", "curve_right", "curve_left",
+	                "jump_up", "jump_down" })
+	, mAssetArchive()
+	, mModels((unsigned int)TrackPieceType::MAX, nullptr)
+	, mCollisions((unsigned int)TrackPieceType::MAX, nullptr)
+	, mReferenceCounts((unsigned int)TrackPieceType::MAX, 0)
+	, mTrackPiecePool()
+	, mAssetStats()
+	, mLoaderPool(nullptr)
+	, mPendingLoads((unsigned int)TrackPieceType::MAX, PendingTypeLoad())
+	, mQueuedAssetCount(0)
+	, mFinishedAssetCount(0)
+	, mLoadMutex()
+	, mAssetFinished()
+{
+	// Only the archive's table of contents is read here - each type's model and collision data are loaded when first needed, see LoadType()
+	if (assetArchivePath != "")
+		mAssetArchive.Open(assetArchivePath);
+}
+
+// -------------------------------------------------------------------- //
+
+TrackPieceFactory::~TrackPieceFactory()
 {
-	// Load in the models for the track pieces
+	// Let any loads still running finish, as they write into this object
+	WaitUntilLoaded();
+
+	delete mLoaderPool;
+	mLoaderPool = nullptr;
+
+	// The pieces reference the models and collision data, so they have to go first
+	mTrackPiecePool.ReleaseMemory();
+
 	for (unsigned int i = 0; i < (unsigned int)TrackPieceType::MAX; i++)
 	{
-		if(kFilePathsToModels.size() > i)
-			mModels.push_back(new Model(mShaderHandler, kFilePathsToModels[i]));
+		UnloadType((TrackPieceType)i);
 	}
+}
+
+// -------------------------------------------------------------------- //
+
+TrackPieceHandle TrackPieceFactory::CreateTrackPiece(TrackPieceType pieceType)
+{
+	// Error checking just incase we are de-referencing a nullptr
+	if (!LoadType(pieceType))
+		return TrackPieceHandle();
+
+	// Create the piece with the correct data
+	mReferenceCounts[(unsigned int)pieceType]++;
+
+	return mTrackPiecePool.Allocate(pieceType, *mModels[(unsigned int)pieceType], *mCollisions[(unsigned int)pieceType]);
+}
+
+// -------------------------------------------------------------------- //
+
+TrackPieceHandle TrackPieceFactory::CreateTrackPiece(const PackedTrackPiece& packedPiece)
+{
+	TrackPieceType pieceType = packedPiece.GetType();
+
+	if (!LoadType(pieceType))
+		return TrackPieceHandle();
+
+	mReferenceCounts[(unsigned int)pieceType]++;
+
+	return mTrackPiecePool.Allocate(packedPiece, *mModels[(unsigned int)pieceType], *mCollisions[(unsigned int)pieceType]);
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackPieceFactory::DestroyTrackPiece(TrackPieceHandle handle)
+{
+	TrackPiece* piece = mTrackPiecePool.Get(handle);
+
+	if (!piece)
+		return false;
+
+	mReferenceCounts[(unsigned int)piece->GetType()]--;
+
+	return mTrackPiecePool.Release(handle);
+}
+
+// -------------------------------------------------------------------- //
 
-	// Load in the collision data for the track pieces
+void TrackPieceFactory::ClearTrackPieces()
+{
+	mTrackPiecePool.Clear();
+
+	for (unsigned int& referenceCount : mReferenceCounts)
+	{
+		referenceCount = 0;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackPieceFactory::Prefetch(const std::vector<TrackPieceType>& pieceTypes)
+{
+	// Queue everything first so that the types load alongside each other, then collect them one at a time
+	PrefetchAsync(pieceTypes);
+
+	bool allLoaded = true;
+
+	for (TrackPieceType pieceType : pieceTypes)
+	{
+		if (!LoadType(pieceType))
+			allLoaded = false;
+	}
+
+	return allLoaded;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::PrefetchAsync(const std::vector<TrackPieceType>& pieceTypes)
+{
+	for (TrackPieceType pieceType : pieceTypes)
+	{
+		QueueTypeLoad(pieceType);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::PrefetchAllAsync()
+{
 	for (unsigned int i = 0; i < (unsigned int)TrackPieceType::MAX; i++)
 	{
-		if (kFilePathsToCollisionData.size() > i)
-			mCollisions.push_back(new TrackCollision(kFilePathsToCollisionData[i]));
+		QueueTypeLoad((TrackPieceType)i);
 	}
 }
 
 // -------------------------------------------------------------------- //
 
-TrackPieceFactory::~TrackPieceFactory()
+void TrackPieceFactory::WaitUntilLoaded()
 {
-	mModels.clear();
-	mCollisions.clear();
+	{
+		std::unique_lock<std::mutex> lock(mLoadMutex);
+
+		mAssetFinished.wait(lock, [this]() { return mFinishedAssetCount == mQueuedAssetCount; });
+
+		// Start the progress count again for the next batch
+		mQueuedAssetCount   = 0;
+		mFinishedAssetCount = 0;
+	}
+
+	for (unsigned int i = 0; i < (unsigned int)TrackPieceType::MAX; i++)
+	{
+		PublishType((TrackPieceType)i);
+	}
 }
 
 // -------------------------------------------------------------------- //
 
-TrackPiece* TrackPieceFactory::CreateTrackPiece(TrackPieceType pieceType)
+float TrackPieceFactory::GetLoadingProgress()
 {
-	// Error checking just incase we are de-referencing a nullptr
-	if (!mModels[(unsigned int)pieceType] || !mCollisions[(unsigned int)pieceType])
+	std::lock_guard<std::mutex> lock(mLoadMutex);
+
+	if (mQueuedAssetCount == 0)
+		return 1.0f;
+
+	return (float)mFinishedAssetCount / (float)mQueuedAssetCount;
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int TrackPieceFactory::EvictUnusedTypes()
+{
+	unsigned int evicted = 0;
+
+	for (unsigned int i = 0; i < (unsigned int)TrackPieceType::MAX; i++)
+	{
+		if (mReferenceCounts[i] == 0 && GetIsTypeLoaded((TrackPieceType)i))
+		{
+			UnloadType((TrackPieceType)i);
+
+			mAssetStats.evictionCount++;
+			evicted++;
+		}
+	}
+
+	return evicted;
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackPieceFactory::GetIsTypeLoaded(TrackPieceType pieceType) const
+{
+	return GetModel(pieceType) && GetCollision(pieceType);
+}
+
+// -------------------------------------------------------------------- //
+
+unsigned int TrackPieceFactory::GetReferenceCount(TrackPieceType pieceType) const
+{
+	if ((unsigned int)pieceType >= mReferenceCounts.size())
+		return 0;
+
+	return mReferenceCounts[(unsigned int)pieceType];
+}
+
+// -------------------------------------------------------------------- //
+
+Model* TrackPieceFactory::GetModel(TrackPieceType pieceType) const
+{
+	if ((unsigned int)pieceType >= mModels.size())
 		return nullptr;
 
-	// Create the piece with the correct data
-	TrackPiece* returnTrackPiece = new TrackPiece(*(mModels[(unsigned int)pieceType]), *(mCollisions[(unsigned int)pieceType]));
+	return mModels[(unsigned int)pieceType];
+}
+
+// -------------------------------------------------------------------- //
+
+TrackCollision* TrackPieceFactory::GetCollision(TrackPieceType pieceType) const
+{
+	if ((unsigned int)pieceType >= mCollisions.size())
+		return nullptr;
+
+	return mCollisions[(unsigned int)pieceType];
+}
+
+// -------------------------------------------------------------------- //
+
+size_t TrackPieceFactory::GetAssetMemoryUsage() const
+{
+	size_t bytes = 0;
+
+	for (unsigned int i = 0; i < (unsigned int)TrackPieceType::MAX; i++)
+	{
+		bool firstModelUse     = mModels[i]     != nullptr;
+		bool firstCollisionUse = mCollisions[i] != nullptr;
+
+		for (unsigned int earlier = 0; earlier < i; earlier++)
+		{
+			firstModelUse     = firstModelUse     && mModels[earlier]     != mModels[i];
+			firstCollisionUse = firstCollisionUse && mCollisions[earlier] != mCollisions[i];
+		}
+
+		if (firstModelUse)
+			bytes += mModels[i]->GetMemoryUsage();
+
+		if (firstCollisionUse)
+			bytes += mCollisions[i]->GetMemoryUsage();
+	}
+
+	return bytes;
+}
+
+// -------------------------------------------------------------------- //
+
+size_t TrackPieceFactory::GetAssetMemorySaved() const
+{
+	size_t unsharedBytes = 0;
+
+	for (unsigned int i = 0; i < (unsigned int)TrackPieceType::MAX; i++)
+	{
+		if (mModels[i])
+			unsharedBytes += mModels[i]->GetMemoryUsage();
+
+		if (mCollisions[i])
+			unsharedBytes += mCollisions[i]->GetMemoryUsage();
+	}
+
+	return unsharedBytes - GetAssetMemoryUsage();
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackPieceFactory::LoadType(TrackPieceType pieceType)
+{
+	unsigned int index = (unsigned int)pieceType;
+
+	if (index >= (unsigned int)TrackPieceType::MAX)
+		return false;
+
+	if (GetIsTypeLoaded(pieceType))
+		return true;
+
+	// Mirrored types never load anything of their own
+	if (GetTrackPieceAssetSource(pieceType) != pieceType)
+		return LinkMirroredType(pieceType);
+
+	// Already on its way from a worker - just wait for this one type
+	if (mPendingLoads[index].inFlight)
+	{
+		WaitForType(pieceType);
+		PublishType(pieceType);
+
+		return GetIsTypeLoaded(pieceType);
+	}
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	// Load in the model and collision data for this type
+	if (!mModels[index])
+		mModels[index] = LoadModel(index, GetLoaderPool());
+
+	if (!mCollisions[index])
+		mCollisions[index] = LoadCollision(index);
+
+	mAssetStats.totalLoadSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	ShareIdenticalAssets(pieceType);
+
+	return RecordLoadResult(pieceType);
+}
+
+// -------------------------------------------------------------------- //
+
+Model* TrackPieceFactory::LoadModel(unsigned int index, WorkerPool& workerPool) const
+{
+	Model* model = new Model(mShaderHandler);
+
+	// A type with nothing named for it gets an empty model - only named data that cannot be read fails the load
+	bool loaded = mAssetArchive.GetIsOpen() ? kAssetNames.size() <= index        || model->LoadInModelFromArchive(mAssetArchive, kAssetNames[index] + ".obj", &workerPool)
+	                                        : kFilePathsToModels.size() <= index || kFilePathsToModels[index] == "" || model->LoadInModelFromFile(kFilePathsToModels[index], &workerPool);
+
+	if (!loaded)
+	{
+		delete model;
+		return nullptr;
+	}
+
+	return model;
+}
+
+// -------------------------------------------------------------------- //
+
+TrackCollision* TrackPieceFactory::LoadCollision(unsigned int index) const
+{
+	std::string     name      = mAssetArchive.GetIsOpen() ? (kAssetNames.size() > index ? kAssetNames[index] + ".col" : "")
+	                                                      : (kFilePathsToCollisionData.size() > index ? kFilePathsToCollisionData[index] : "");
+	TrackCollision* collision = mAssetArchive.GetIsOpen() ? new TrackCollision(mAssetArchive, name) : new TrackCollision(name);
+
+	// As with models, a type without collision data named for it just has nothing to collide with
+	if (name != "" && !collision->GetIsLoaded())
+	{
+		delete collision;
+		return nullptr;
+	}
+
+	return collision;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::UnloadType(TrackPieceType pieceType)
+{
+	unsigned int index = (unsigned int)pieceType;
+
+	if (GetIsTypeLoaded(pieceType))
+		mAssetStats.loadedTypeCount--;
+
+	Model*          model     = mModels[index];
+	TrackCollision* collision = mCollisions[index];
+
+	mModels[index]     = nullptr;
+	mCollisions[index] = nullptr;
+
+	// Shared data is only freed along with the last type using it
+	for (unsigned int other = 0; other < (unsigned int)TrackPieceType::MAX; other++)
+	{
+		if (mModels[other] == model)
+			model = nullptr;
+
+		if (mCollisions[other] == collision)
+			collision = nullptr;
+	}
+
+	delete model;
+	delete collision;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::ShareIdenticalAssets(TrackPieceType pieceType)
+{
+	unsigned int     index     = (unsigned int)pieceType;
+	Model*&          model     = mModels[index];
+	TrackCollision*& collision = mCollisions[index];
+
+	// Each branch stops at the first match - every other copy has already been pointed at that one
+	for (unsigned int other = 0; other < (unsigned int)TrackPieceType::MAX && model; other++)
+	{
+		Model* otherModel = mModels[other];
+
+		// The counts are compared as well so that a hash collision would need two meshes of exactly the same size
+		if (otherModel && otherModel != model
+		 && otherModel->GetContentHash() == model->GetContentHash()
+		 && otherModel->GetVertexCount()  == model->GetVertexCount()
+		 && otherModel->GetIndexCount()   == model->GetIndexCount())
+		{
+			delete model;
+			model = otherModel;
+
+			mAssetStats.sharedAssetCount++;
+			break;
+		}
+	}
+
+	for (unsigned int other = 0; other < (unsigned int)TrackPieceType::MAX && collision; other++)
+	{
+		TrackCollision* otherCollision = mCollisions[other];
+
+		// As with the models, a hash collision alone is not enough - the two have to take up the same memory too
+		if (otherCollision && otherCollision != collision
+		 && otherCollision->GetContentHash() == collision->GetContentHash()
+		 && otherCollision->GetMemoryUsage() == collision->GetMemoryUsage())
+		{
+			delete collision;
+			collision = otherCollision;
+
+			mAssetStats.sharedAssetCount++;
+			break;
+		}
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackPieceFactory::LinkMirroredType(TrackPieceType pieceType)
+{
+	unsigned int   index  = (unsigned int)pieceType;
+	TrackPieceType source = GetTrackPieceAssetSource(pieceType);
+
+	// PrefetchAsync() marks a mirrored type as in flight while its source type loads
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		mPendingLoads[index].inFlight = false;
+	}
+
+	if (LoadType(source))
+	{
+		mModels[index]     = mModels[(unsigned int)source];
+		mCollisions[index] = mCollisions[(unsigned int)source];
+
+		mAssetStats.sharedAssetCount += 2;
+	}
+
+	return RecordLoadResult(pieceType);
+}
+
+// -------------------------------------------------------------------- //
+
+WorkerPool& TrackPieceFactory::GetLoaderPool()
+{
+	if (!mLoaderPool)
+		mLoaderPool = new WorkerPool();
+
+	return *mLoaderPool;
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::QueueTypeLoad(TrackPieceType pieceType)
+{
+	unsigned int index = (unsigned int)pieceType;
+
+	if (index >= (unsigned int)TrackPieceType::MAX || GetIsTypeLoaded(pieceType))
+		return;
+
+	// Mirrored types load their source type instead, and are linked to it when it is published
+	if (GetTrackPieceAssetSource(pieceType) != pieceType)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mLoadMutex);
+
+			mPendingLoads[index].inFlight = true;
+		}
+
+		QueueTypeLoad(GetTrackPieceAssetSource(pieceType));
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		PendingTypeLoad& pending = mPendingLoads[index];
+
+		if (pending.inFlight)
+			return;
+
+		pending.model         = nullptr;
+		pending.collision     = nullptr;
+		pending.jobsRemaining = 2;
+		pending.inFlight      = true;
+		pending.loadSeconds   = 0.0;
+
+		mQueuedAssetCount += 2;
+	}
+
+	WorkerPool& loaderPool = GetLoaderPool();
+
+	// The model and the collision data are separate assets, so they get a job each
+	loaderPool.Submit([this, index, &loaderPool]()
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		Model* model = LoadModel(index, loaderPool);
+
+		double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		mPendingLoads[index].model        = model;
+		mPendingLoads[index].loadSeconds += loadSeconds;
+		mPendingLoads[index].jobsRemaining--;
+		mFinishedAssetCount++;
+
+		mAssetFinished.notify_all();
+	});
+
+	loaderPool.Submit([this, index]()
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		TrackCollision* collision = LoadCollision(index);
+
+		double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		mPendingLoads[index].collision    = collision;
+		mPendingLoads[index].loadSeconds += loadSeconds;
+		mPendingLoads[index].jobsRemaining--;
+		mFinishedAssetCount++;
+
+		mAssetFinished.notify_all();
+	});
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::WaitForType(TrackPieceType pieceType)
+{
+	std::unique_lock<std::mutex> lock(mLoadMutex);
+
+	PendingTypeLoad& pending = mPendingLoads[(unsigned int)pieceType];
+
+	mAssetFinished.wait(lock, [&pending]() { return pending.jobsRemaining == 0; });
+}
+
+// -------------------------------------------------------------------- //
+
+void TrackPieceFactory::PublishType(TrackPieceType pieceType)
+{
+	unsigned int index = (unsigned int)pieceType;
+
+	if (GetTrackPieceAssetSource(pieceType) != pieceType)
+	{
+		bool queued = false;
+
+		{
+			std::lock_guard<std::mutex> lock(mLoadMutex);
+
+			queued = mPendingLoads[index].inFlight;
+		}
+
+		if (queued)
+			LinkMirroredType(pieceType);
+
+		return;
+	}
+
+	Model*          model     = nullptr;
+	TrackCollision* collision = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mLoadMutex);
+
+		PendingTypeLoad& pending = mPendingLoads[index];
+
+		if (!pending.inFlight || pending.jobsRemaining != 0)
+			return;
+
+		model     = pending.model;
+		collision = pending.collision;
+
+		mAssetStats.totalLoadSeconds += pending.loadSeconds;
+
+		pending.model     = nullptr;
+		pending.collision = nullptr;
+		pending.inFlight  = false;
+	}
+
+	// Only whole types go into the tables - a worker that could not read its half leaves the other half with nowhere to go
+	if (!model || !collision)
+	{
+		delete model;
+		delete collision;
+
+		mAssetStats.failedLoadCount++;
+		return;
+	}
+
+	// Only the main thread touches the tables, so the type cannot have been loaded another way while this was in flight
+	mModels[index]     = model;
+	mCollisions[index] = collision;
+
+	ShareIdenticalAssets(pieceType);
+	RecordLoadResult(pieceType);
+}
+
+// -------------------------------------------------------------------- //
+
+bool TrackPieceFactory::RecordLoadResult(TrackPieceType pieceType)
+{
+	if (!GetIsTypeLoaded(pieceType))
+	{
+		// Whatever half did load is let go, so that a failed type holds nothing and is tried again from scratch next time
+		UnloadType(pieceType);
+
+		mAssetStats.failedLoadCount++;
+		return false;
+	}
+
+	mAssetStats.loadCount++;
+	mAssetStats.loadedTypeCount++;
+
+	if (mAssetStats.loadedTypeCount > mAssetStats.peakLoadedTypeCount)
+		mAssetStats.peakLoadedTypeCount = mAssetStats.loadedTypeCount;
 
-	// If not a created for some reason then return nullptr
-	return returnTrackPiece;
+	return true;
 }
 
 // -------------------------------------------------------------------- //
\ No newline at end of file
@@ -1,66 +1,38 @@
 #ifndef _TRACK_PIECE_FACTORY_H_
 #define _TRACK_PIECE_FACTORY_H_
 
+#include <condition_variable>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "TrackPiece.h"
+#include "TrackPieceType.h"
+#include "PackedTrackPiece.h"
 
 #include "../Shaders/ShaderHandler.h"
+#include "../Memory/AssetArchive.h"
+#include "../Memory/PoolAllocator.h"
 
 class Model;
 class TrackCollision;
+class WorkerPool;
+
+typedef PoolHandle TrackPieceHandle;
 
 // -------------------------------------------------------------------- //
 
-enum class TrackPieceType : unsigned int
+struct TrackPieceAssetStats final
 {
-	// Starts //
-		START_ONE_ENTRANCE = 0,
-		START_STRAIGHT_THROUGH,
-		START_T_PIECE,
-		START_OPEN,
-		START_AIR,
-
-	// Ends //
-		END_ONE_ENTRANCE,
-		END_STRAIGHT_THOUGH,
-		END_T_PIECE,
-		END_OPEN,
-		END_AIR,	
-
-	// Checkpoints //
-		CHECKPOINT_STRAIGHT_TRACK,
-		CHECKPOINT_AIR,
-		CHECKPOINT_CURVE_LEFT,
-		CHECKPOINT_CURVE_RIGHT,
-		CHECKPOINT_SLOPE_UP,
-		CHECKPOINT_SLOPE_DOWN,
-
-
-	// Normal Pieces //
-
-		// Slopes
-		SLOPE_UP,
-		SLOPE_UP_RIGHT,
-		SLOPE_UP_LEFT,
-
-		SLOPE_DOWN,
-		SLOPE_DOWN_RIGHT,
-		SLOPE_DOWN_LEFT,
-
-		// Straights + curves
-		STRAIGHT_FORWARD,	
-		T_PIECE,
-		FOUR_CROSS,
-
-		CURVE_RIGHT,
-		CURVE_LEFT,
-
-		// Custom
-		JUMP_UP,
-		JUMP_DOWN,
-
-		MAX
+	unsigned int loadedTypeCount;
+	unsigned int peakLoadedTypeCount;
+
+	unsigned int loadCount;     // Running totals - a type that is evicted and used again counts twice
+	unsigned int evictionCount;
+	unsigned int failedLoadCount;
+	unsigned int sharedAssetCount; // Models and collision data that were not kept, as an identical or mirrored copy was already loaded
+
+	double       totalLoadSeconds; // Summed across worker threads, so it can exceed the wall-clock time
 };
 
 // -------------------------------------------------------------------- //
@@ -68,19 +40,121 @@ enum class TrackPieceType : unsigned int
 static class TrackPieceFactory final
 {
 public:
-	TrackPieceFactory(ShaderHandler& shaderHander);
+	// With an asset archive every type's data is read out of that one file, which is opened and mapped once here. Without one (or if
+	// it fails to open) each type is loaded from its own loose files instead.
+	TrackPieceFactory(ShaderHandler& shaderHander, const std::string& assetArchivePath = "");
 	~TrackPieceFactory();
 
-	TrackPiece* CreateTrackPiece(TrackPieceType pieceToMake);
+	// Pieces live in a pool owned by the factory - the handle stays valid until DestroyTrackPiece() or ClearTrackPieces().
+	// The model and collision data for a type are loaded the first time a piece of that type is made - if either is named but cannot
+	// be read, the handle is invalid.
+	TrackPieceHandle CreateTrackPiece(TrackPieceType pieceToMake);
+
+	// Adapter for code that still wants a full TrackPiece - large tracks should be kept as contiguous PackedTrackPieces instead
+	TrackPieceHandle CreateTrackPiece(const PackedTrackPiece& packedPiece);
+
+	// nullptr if the piece has been destroyed
+	TrackPiece*      GetTrackPiece(TrackPieceHandle handle) const { return mTrackPiecePool.Get(handle); }
+
+	bool             DestroyTrackPiece(TrackPieceHandle handle);
+
+	// Destroys every piece at once, for when a track is unloaded. The pool keeps its memory for the next track.
+	void             ClearTrackPieces();
+
+	const PoolAllocatorStats& GetTrackPieceStats() const          { return mTrackPiecePool.GetStats(); }
+
+	// Loads the data for these types now rather than on first use, for loading screens. The types are loaded concurrently, and this
+	// blocks until they are all done. Returns false if any of them could not be loaded, as CreateTrackPiece() would then fail for it.
+	bool             Prefetch(const std::vector<TrackPieceType>& pieceTypes);
+
+	// Non-blocking version of Prefetch() - the types are loaded on worker threads and appear in the factory after WaitUntilLoaded().
+	// Creating a piece of a type that is still loading waits for just that type.
+	void             PrefetchAsync(const std::vector<TrackPieceType>& pieceTypes);
+	void             PrefetchAllAsync();
+
+	// Blocks until every async load has finished, then makes the results visible to the rest of the factory
+	void             WaitUntilLoaded();
+
+	// 0 to 1 over the assets queued by PrefetchAsync() since the last WaitUntilLoaded(). Safe to poll every frame.
+	float            GetLoadingProgress();
+
+	// Frees the data of every loaded type that has no live pieces (including prefetched types never used). Returns how many were freed.
+	unsigned int     EvictUnusedTypes();
+
+	bool             GetIsUsingAssetArchive() const                { return mAssetArchive.GetIsOpen(); }
+
+	bool             GetIsTypeLoaded(TrackPieceType pieceType) const;
+	unsigned int     GetReferenceCount(TrackPieceType pieceType) const;
+
+	const TrackPieceAssetStats& GetAssetStats() const             { return mAssetStats; }
+
+	// The shared data for every piece of a type, or nullptr if it has not been loaded. Types whose data turns out to be identical (by
+	// content hash) share one copy, and mirrored types share their source type's - see GetTrackPieceAssetSource().
+	Model*           GetModel(TrackPieceType pieceType) const;
+	TrackCollision*  GetCollision(TrackPieceType pieceType) const;
+
+	// Bytes of model and collision data held, with shared copies counted once
+	size_t           GetAssetMemoryUsage() const;
+
+	// How much more GetAssetMemoryUsage() would be if every loaded type had its own copy of its data
+	size_t           GetAssetMemorySaved() const;
 
 private:
+	// A type being loaded by the workers. The workers only ever write in here (under mLoadMutex), never to the factory tables.
+	struct PendingTypeLoad final
+	{
+		Model*          model;
+		TrackCollision* collision;
+		unsigned int    jobsRemaining;
+		bool            inFlight;
+		double          loadSeconds;
+	};
+
+	bool LoadType(TrackPieceType pieceType);
+	void UnloadType(TrackPieceType pieceType);
+
+	// Only read the archive and the name tables, so the loader workers can call them alongside each other. nullptr if the data is
+	// named but could not be read. A model being imported from source shares out its work over workerPool.
+	Model*          LoadModel(unsigned int index, WorkerPool& workerPool) const;
+	TrackCollision* LoadCollision(unsigned int index) const;
+
+	// Points a just loaded type at another type's data where the content hashes match, freeing its own copy
+	void ShareIdenticalAssets(TrackPieceType pieceType);
+	bool LinkMirroredType(TrackPieceType pieceType);
+
+	// The one pool every load uses, whether queued or not - made the first time it is needed
+	WorkerPool& GetLoaderPool();
+
+	void QueueTypeLoad(TrackPieceType pieceType);
+	void WaitForType(TrackPieceType pieceType);
+	void PublishType(TrackPieceType pieceType);
+	bool RecordLoadResult(TrackPieceType pieceType);
+
 	ShaderHandler&                     mShaderHandler;
 
 	const std::vector<std::string>     kFilePathsToModels;
 	const std::vector<std::string>     kFilePathsToCollisionData;
 
+	// What each type is called in the asset archive - its model is "<name>.obj" and its collision data "<name>.col"
+	const std::vector<std::string>     kAssetNames;
+
+	AssetArchive                       mAssetArchive;
+
 	std::vector<Model*>                mModels;
 	std::vector<TrackCollision*>       mCollisions;
+	std::vector<unsigned int>          mReferenceCounts; // Live pieces of each type
+
+	PoolAllocator<TrackPiece>          mTrackPiecePool;
+
+	TrackPieceAssetStats               mAssetStats;
+
+	// Async loading
+	WorkerPool*                        mLoaderPool;
+	std::vector<PendingTypeLoad>       mPendingLoads;
+	unsigned int                       mQueuedAssetCount;
+	unsigned int                       mFinishedAssetCount;
+	std::mutex                         mLoadMutex;
+	std::condition_variable            mAssetFinished;
 };
 
 // -------------------------------------------------------------------- //
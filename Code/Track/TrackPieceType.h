@@ -0,0 +1,89 @@
+#ifndef _TRACK_PIECE_TYPE_H_
+#define _TRACK_PIECE_TYPE_H_
+
+// -------------------------------------------------------------------- //
+
+enum class TrackPieceType : unsigned int
+{
+	// Starts //
+		START_ONE_ENTRANCE = 0,
+		START_STRAIGHT_THROUGH,
+		START_T_PIECE,
+		START_OPEN,
+		START_AIR,
+
+	// Ends //
+		END_ONE_ENTRANCE,
+		END_STRAIGHT_THOUGH,
+		END_T_PIECE,
+		END_OPEN,
+		END_AIR,	
+
+	// Checkpoints //
+		CHECKPOINT_STRAIGHT_TRACK,
+		CHECKPOINT_AIR,
+		CHECKPOINT_CURVE_LEFT,
+		CHECKPOINT_CURVE_RIGHT,
+		CHECKPOINT_SLOPE_UP,
+		CHECKPOINT_SLOPE_DOWN,
+
+
+	// Normal Pieces //
+
+		// Slopes
+		SLOPE_UP,
+		SLOPE_UP_RIGHT,
+		SLOPE_UP_LEFT,
+
+		SLOPE_DOWN,
+		SLOPE_DOWN_RIGHT,
+		SLOPE_DOWN_LEFT,
+
+		// Straights + curves
+		STRAIGHT_FORWARD,	
+		T_PIECE,
+		FOUR_CROSS,
+
+		CURVE_RIGHT,
+		CURVE_LEFT,
+
+		// Custom
+		JUMP_UP,
+		JUMP_DOWN,
+
+		MAX
+};
+
+// -------------------------------------------------------------------- //
+
+// How a type is made from the data of the type it shares assets with
+enum class TrackPieceAssetTransform : unsigned int
+{
+	NONE = 0,
+	MIRROR_X,  // Reflected across the piece's local x = 0 plane, which reverses the triangles' winding
+
+	MAX
+};
+
+// Left-hand pieces are drawn and collided with as the mirror image of the right-hand ones, so only the right-hand data is ever loaded.
+// Every other type uses its own data.
+inline TrackPieceType GetTrackPieceAssetSource(TrackPieceType type)
+{
+	switch (type)
+	{
+	case TrackPieceType::CHECKPOINT_CURVE_LEFT: return TrackPieceType::CHECKPOINT_CURVE_RIGHT;
+	case TrackPieceType::SLOPE_UP_LEFT:         return TrackPieceType::SLOPE_UP_RIGHT;
+	case TrackPieceType::SLOPE_DOWN_LEFT:       return TrackPieceType::SLOPE_DOWN_RIGHT;
+	case TrackPieceType::CURVE_LEFT:            return TrackPieceType::CURVE_RIGHT;
+	default:                                    return type;
+	}
+}
+
+inline TrackPieceAssetTransform GetTrackPieceAssetTransform(TrackPieceType type)
+{
+	return GetTrackPieceAssetSource(type) != type ? TrackPieceAssetTransform::MIRROR_X : TrackPieceAssetTransform::NONE;
+}
+
+// -------------------------------------------------------------------- //
+
+#endif
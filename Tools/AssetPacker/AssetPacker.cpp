@@ -0,0 +1,128 @@
+// Packs a directory of assets into one archive for TrackPieceFactory - see Code/Memory/AssetArchive.h.
+//
+//     AssetPacker <asset directory> <output.pak> [--compress] [--no-sources]
+//
+// Entries are named by their path relative to the asset directory, with forward slashes. --compress LZ4 compresses the blobs that
+// shrink enough to be worth it. --no-sources leaves out any .obj that has a .meshcache beside it and any .col that has a .colcache
+// beside it, as the game only reads the cache - see Tools/CollisionCooker for cooking the collision caches.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\AssetPacker\AssetPacker.cpp Code\Memory\AssetArchive.cpp Code\Memory\FileUtils.cpp Code\Memory\LZ4.cpp
+//        Code\Memory\MappedFile.cpp
+
+#include <filesystem>
+#include <fstream>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "../../Code/Memory/AssetArchive.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const char* const kObjExtension            = ".obj";
+	const char* const kMeshCacheExtension      = ".meshcache"; // Matches Code/Models/MeshCache.h, which pulls in the renderer
+	const char* const kCollisionExtension      = ".col";
+	const char* const kCollisionCacheExtension = ".colcache";  // Matches Code/Collisions/CollisionCache.h
+
+	bool ReadWholeFile(const std::filesystem::path& filePath, std::vector<char>& dataOut)
+	{
+		std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+			return false;
+
+		dataOut.resize((size_t)file.tellg());
+		file.seekg(0);
+		file.read(dataOut.data(), (std::streamsize)dataOut.size());
+
+		return file.good() || dataOut.empty();
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("Usage: AssetPacker <asset directory> <output%s> [--compress] [--no-sources]\n", kAssetArchiveExtension);
+		return 1;
+	}
+
+	std::filesystem::path assetDirectory = argv[1];
+	std::string           outputPath     = argv[2];
+	bool                  compress       = false;
+	bool                  skipSources    = false;
+
+	for (int i = 3; i < argc; i++)
+	{
+		std::string option = argv[i];
+
+		if (option == "--compress")
+			compress = true;
+		else if (option == "--no-sources")
+			skipSources = true;
+		else
+		{
+			printf("Unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	std::error_code error;
+
+	if (!std::filesystem::is_directory(assetDirectory, error))
+	{
+		printf("%s is not a directory\n", argv[1]);
+		return 1;
+	}
+
+	std::vector<AssetArchiveSource> sources;
+	unsigned long long              totalSize = 0;
+
+	for (const std::filesystem::directory_entry& file : std::filesystem::recursive_directory_iterator(assetDirectory))
+	{
+		if (!file.is_regular_file())
+			continue;
+
+		const std::filesystem::path& filePath = file.path();
+
+		// Never pack an archive into itself
+		if (std::filesystem::equivalent(filePath, outputPath, error))
+			continue;
+
+		if (skipSources && filePath.extension() == kObjExtension && std::filesystem::exists(filePath.string() + kMeshCacheExtension, error))
+			continue;
+
+		if (skipSources && filePath.extension() == kCollisionExtension && std::filesystem::exists(filePath.string() + kCollisionCacheExtension, error))
+			continue;
+
+		AssetArchiveSource source;
+		source.name = filePath.lexically_relative(assetDirectory).generic_string();
+
+		if (!ReadWholeFile(filePath, source.data))
+		{
+			printf("Could not read %s\n", filePath.string().c_str());
+			return 1;
+		}
+
+		totalSize += source.data.size();
+		sources.push_back(std::move(source));
+	}
+
+	if (!AssetArchive::Write(outputPath, sources, compress))
+	{
+		printf("Could not write %s\n", outputPath.c_str());
+		return 1;
+	}
+
+	unsigned long long archiveSize = std::filesystem::file_size(outputPath, error);
+
+	printf("Packed %u files, %llu bytes, into %s - %llu bytes\n", (unsigned int)sources.size(), totalSize, outputPath.c_str(), archiveSize);
+
+	return 0;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,122 @@
+// Cooks track collision meshes into the caches TrackCollision loads instantly - see Code/Collisions/CollisionCache.h.
+//
+//     CollisionCooker <file or directory>... [--force]
+//
+// Each source gets a cache written beside it, named as TrackCollision looks for it. Directories are searched for every .col file.
+// Caches that are already up to date are left alone unless --force is given. Run it before AssetPacker --no-sources, which then
+// leaves out the sources that have a cache.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\CollisionCooker\CollisionCooker.cpp Code\Collisions\TrackCollision.cpp Code\Collisions\CollisionBVH.cpp
+//        Code\Collisions\CollisionCache.cpp Code\Models\ObjParser.cpp Code\Models\MeshCache.cpp Code\Memory\AssetArchive.cpp
+//        Code\Memory\FileUtils.cpp Code\Memory\LZ4.cpp Code\Memory\MappedFile.cpp Code\Maths\CommonMaths.cpp
+
+#include <chrono>
+#include <filesystem>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "../../Code/Collisions/CollisionCache.h"
+#include "../../Code/Collisions/TrackCollision.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const char* const kCollisionExtension = ".col";
+
+	bool GetIsUpToDate(const std::string& filePath)
+	{
+		MappedFile     source;
+		CollisionCache cache;
+
+		return source.Open(filePath) && cache.Open(filePath + kCollisionCacheExtension) && cache.GetIsUpToDate(source);
+	}
+
+	// Opens the cache the way the game does, so that one it would turn down is caught here rather than cooked again on every load
+	bool Verify(const std::string& filePath)
+	{
+		CollisionCache cache;
+		CollisionBVH   bvh;
+
+		if (!cache.Open(filePath + kCollisionCacheExtension) || !cache.Attach(bvh))
+			return false;
+
+		const CollisionCacheHeader& header = cache.GetHeader();
+
+		printf("Cooked %s - %u of %u triangles, %u nodes, depth %u, %llu bytes\n", filePath.c_str(), header.triangleCount, header.sourceTriangleCount, header.nodeCount, bvh.GetDepth(),
+		       (unsigned long long)(header.triangleOffset + (unsigned long long)header.triangleCount * header.triangleStride));
+
+		return true;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> sources;
+	bool                     force = false;
+	std::error_code          error;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--force")
+		{
+			force = true;
+		}
+		else if (std::filesystem::is_directory(argument, error))
+		{
+			for (const std::filesystem::directory_entry& file : std::filesystem::recursive_directory_iterator(argument))
+			{
+				if (file.is_regular_file() && file.path().extension() == kCollisionExtension)
+					sources.push_back(file.path().string());
+			}
+		}
+		else if (argument.size() > 2 && argument.compare(0, 2, "--") == 0)
+		{
+			printf("Unknown option %s\n", argv[i]);
+			return 1;
+		}
+		else
+		{
+			sources.push_back(argument);
+		}
+	}
+
+	if (sources.empty())
+	{
+		printf("Usage: CollisionCooker <file or directory>... [--force]\n");
+		return 1;
+	}
+
+	unsigned int cookedCount = 0;
+	unsigned int failedCount = 0;
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (const std::string& source : sources)
+	{
+		if (!force && GetIsUpToDate(source))
+			continue;
+
+		if (!TrackCollision::Cook(source) || !Verify(source))
+		{
+			printf("Could not cook %s\n", source.c_str());
+			failedCount++;
+			continue;
+		}
+
+		cookedCount++;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	printf("Cooked %u of %u files in %.2f seconds, %u failed\n", cookedCount, (unsigned int)sources.size(), seconds, failedCount);
+
+	return failedCount > 0 ? 1 : 0;
+}
+
+// -------------------------------------------------------------------- //
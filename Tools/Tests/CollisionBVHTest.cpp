@@ -0,0 +1,387 @@
+// Checks CollisionBVH's queries against testing every triangle, then times them - see Code/Collisions/CollisionBVH.h.
+//
+//     CollisionBVHTest [segments] [lanes]
+//
+// Defaults to TestTrack's banked 90 degree bend, 256 segments long and 24 lanes wide with a wall along each side (about 13k triangles).
+// Rays cast down at it as a wheel's would and across it into the walls, and closest points from below and above, are compared with
+// the same query over every triangle the hierarchy holds. Sphere casts are checked by sampling the path: nothing may be within the
+// radius before the hit, and the surface must be exactly the radius away at it. Exits with 1 if any query disagrees.
+//
+//     cl /std:c++17 /O2 /EHsc /arch:AVX Tools\Tests\CollisionBVHTest.cpp Code\Collisions\CollisionBVH.cpp Code\Maths\CommonMaths.cpp
+//     g++ -std=c++17 -O2 -mavx Tools/Tests/CollisionBVHTest.cpp Code/Collisions/CollisionBVH.cpp Code/Maths/CommonMaths.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../Code/Collisions/CollisionBVH.h"
+
+#include "TestTrack.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float        kMaxRayDistance   = 100.0f;
+	const unsigned int kCheckCount       = 2000;
+	const unsigned int kSphereCheckCount = 500;
+	const unsigned int kBenchmarkCount   = 200000;
+
+	// The hierarchy's corners and these are the same floats, so only the order of the arithmetic differs
+	const float        kMaxDistanceError = 1e-4f;
+	const float        kSampleStep       = 0.05f;
+
+	struct Vector final
+	{
+		double x, y, z;
+	};
+
+	Vector operator+(const Vector& a, const Vector& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+	Vector operator-(const Vector& a, const Vector& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+	Vector operator*(const Vector& a, double scale)    { return { a.x * scale, a.y * scale, a.z * scale }; }
+
+	double Dot(const Vector& a, const Vector& b)   { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	Vector Cross(const Vector& a, const Vector& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+	Vector ToVector(const DirectX::XMFLOAT3& v)    { return { v.x, v.y, v.z }; }
+
+	// The triangles as the hierarchy holds them, after quantisation, so that the brute force queries test the same surface
+	void GetTriangles(const CollisionBVH& bvh, std::vector<Vector>& cornersOut)
+	{
+		const DirectX::XMFLOAT3& origin = bvh.GetQuantisationOrigin();
+		const DirectX::XMFLOAT3& scale  = bvh.GetQuantisationScale();
+
+		for (unsigned int i = 0; i < bvh.GetTriangleCount(); i++)
+		{
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				const unsigned short* position = bvh.GetTriangles()[i].positions[corner];
+
+				cornersOut.push_back(ToVector(DirectX::XMFLOAT3(origin.x + position[0] * scale.x, origin.y + position[1] * scale.y, origin.z + position[2] * scale.z)));
+			}
+		}
+	}
+
+	// Moller-Trumbore against every triangle, returning the nearest distance along the unit direction
+	bool BruteForceRayCast(const std::vector<Vector>& corners, const Vector& origin, const Vector& direction, double maxDistance, double& distanceOut)
+	{
+		bool found = false;
+
+		distanceOut = maxDistance;
+
+		for (size_t i = 0; i < corners.size(); i += 3)
+		{
+			Vector edgeA       = corners[i + 1] - corners[i];
+			Vector edgeB       = corners[i + 2] - corners[i];
+			Vector p           = Cross(direction, edgeB);
+			double determinant = Dot(edgeA, p);
+
+			if (determinant == 0.0)
+				continue;
+
+			Vector toOrigin = origin - corners[i];
+			double u        = Dot(toOrigin, p) / determinant;
+
+			if (u < 0.0 || u > 1.0)
+				continue;
+
+			Vector q = Cross(toOrigin, edgeA);
+			double v = Dot(direction, q) / determinant;
+
+			if (v < 0.0 || u + v > 1.0)
+				continue;
+
+			double distance = Dot(edgeB, q) / determinant;
+
+			if (distance >= 0.0 && distance < distanceOut)
+			{
+				distanceOut = distance;
+				found       = true;
+			}
+		}
+
+		return found;
+	}
+
+	// Real-Time Collision Detection 5.1.5
+	Vector ClosestPointOnTriangle(const Vector& point, const Vector& a, const Vector& b, const Vector& c)
+	{
+		Vector ab = b - a, ac = c - a, ap = point - a;
+		double d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+
+		if (d1 <= 0.0 && d2 <= 0.0)
+			return a;
+
+		Vector bp = point - b;
+		double d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+
+		if (d3 >= 0.0 && d4 <= d3)
+			return b;
+
+		double vc = d1 * d4 - d3 * d2;
+
+		if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+			return a + ab * (d1 / (d1 - d3));
+
+		Vector cp = point - c;
+		double d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+
+		if (d6 >= 0.0 && d5 <= d6)
+			return c;
+
+		double vb = d5 * d2 - d1 * d6;
+
+		if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+			return a + ac * (d2 / (d2 - d6));
+
+		double va = d3 * d6 - d5 * d4;
+
+		if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+		double denominator = 1.0 / (va + vb + vc);
+
+		return a + ab * (vb * denominator) + ac * (vc * denominator);
+	}
+
+	double BruteForceClosestDistance(const std::vector<Vector>& corners, const Vector& point)
+	{
+		double best = 1.0e30;
+
+		for (size_t i = 0; i < corners.size(); i += 3)
+		{
+			Vector offset = ClosestPointOnTriangle(point, corners[i], corners[i + 1], corners[i + 2]) - point;
+
+			best = std::min(best, sqrt(Dot(offset, offset)));
+		}
+
+		return best;
+	}
+
+	DirectX::XMFLOAT3 Along(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float distance)
+	{
+		return DirectX::XMFLOAT3(origin.x + direction.x * distance, origin.y + direction.y * distance, origin.z + direction.z * distance);
+	}
+
+	DirectX::XMFLOAT3 Normalised(const DirectX::XMFLOAT3& v)
+	{
+		float length = sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+
+		return DirectX::XMFLOAT3(v.x / length, v.y / length, v.z / length);
+	}
+
+	double MillionsPerSecond(std::chrono::steady_clock::time_point startTime, unsigned int queryCount)
+	{
+		return queryCount / std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() / 1.0e6;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int segments = argc > 1 ? (unsigned int)atoi(argv[1]) : TestTrack::kDefaultSegments;
+	unsigned int lanes    = argc > 2 ? (unsigned int)atoi(argv[2]) : TestTrack::kDefaultLanes;
+
+	if (segments == 0 || lanes == 0)
+	{
+		printf("Usage: CollisionBVHTest [segments] [lanes]\n");
+		return 1;
+	}
+
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int>      indices;
+
+	TestTrack::Build(segments, lanes, positions, indices);
+
+	CollisionBVH bvh;
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	if (!bvh.Build(positions, indices))
+	{
+		printf("Could not build the hierarchy\n");
+		return 1;
+	}
+
+	double buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	printf("%u triangles built in %.2f ms - %u nodes, depth %u, %u KB\n", (unsigned int)(indices.size() / 3), buildMilliseconds, bvh.GetNodeCount(), bvh.GetDepth(),
+	       (unsigned int)(bvh.GetMemoryUsage() / 1024));
+
+	std::vector<Vector> corners;
+	GetTriangles(bvh, corners);
+
+	// A fixed seed, so that every run checks the same queries
+	std::mt19937                          random(1);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	// Wheel rays - from above the road, pointing down and a little off
+	std::vector<DirectX::XMFLOAT3> wheelOrigins(kBenchmarkCount), wheelDirections(kBenchmarkCount);
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+	{
+		float angle  = unit(random) * TestTrack::kHalfPi;
+		float radius = TestTrack::kBendRadius + (unit(random) - 0.5f) * (TestTrack::kRoadWidth + 2.0f);
+
+		wheelOrigins[i]    = DirectX::XMFLOAT3(radius * cosf(angle), 6.0f + unit(random) * 2.0f, radius * sinf(angle));
+		wheelDirections[i] = DirectX::XMFLOAT3((unit(random) - 0.5f) * 0.2f, -1.0f, (unit(random) - 0.5f) * 0.2f);
+	}
+
+	// Across the road from its centre line, mostly into the walls
+	std::vector<DirectX::XMFLOAT3> acrossOrigins(kBenchmarkCount), acrossDirections(kBenchmarkCount);
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+	{
+		float angle   = unit(random) * TestTrack::kHalfPi;
+		float heading = unit(random) * 4.0f * TestTrack::kHalfPi;
+
+		acrossOrigins[i]    = DirectX::XMFLOAT3(TestTrack::kBendRadius * cosf(angle), 1.0f + unit(random) * 3.0f, TestTrack::kBendRadius * sinf(angle));
+		acrossDirections[i] = DirectX::XMFLOAT3(cosf(heading), (unit(random) - 0.5f) * 0.3f, sinf(heading));
+	}
+
+	bool passed = true;
+
+	//------------------------ Ray casts ------------------------//
+	const std::vector<DirectX::XMFLOAT3>* rayOrigins[]    = { &wheelOrigins, &acrossOrigins };
+	const std::vector<DirectX::XMFLOAT3>* rayDirections[] = { &wheelDirections, &acrossDirections };
+	const char* const                     rayNames[]      = { "Wheel rays", "Rays across the road" };
+
+	for (unsigned int set = 0; set < 2; set++)
+	{
+		unsigned int mismatches = 0, hitCount = 0;
+
+		for (unsigned int i = 0; i < kCheckCount; i++)
+		{
+			const DirectX::XMFLOAT3& origin    = (*rayOrigins[set])[i];
+			const DirectX::XMFLOAT3& direction = (*rayDirections[set])[i];
+
+			CollisionHit hit;
+			double       bruteDistance;
+
+			bool found      = bvh.RayCast(origin, direction, kMaxRayDistance, hit);
+			bool bruteFound = BruteForceRayCast(corners, ToVector(origin), ToVector(Normalised(direction)), kMaxRayDistance, bruteDistance);
+
+			if (found != bruteFound || (found && fabs(hit.distance - bruteDistance) > kMaxDistanceError))
+				mismatches++;
+
+			hitCount += bruteFound ? 1 : 0;
+		}
+
+		printf("%s: %u of %u disagree with brute force (%u hit)\n", rayNames[set], mismatches, kCheckCount, hitCount);
+
+		passed = passed && mismatches == 0;
+	}
+
+	//------------------------ Closest points ------------------------//
+	unsigned int closestMismatches = 0;
+
+	for (unsigned int i = 0; i < kCheckCount; i++)
+	{
+		DirectX::XMFLOAT3 point = wheelOrigins[i];
+		point.y -= unit(random) * 8.0f; // Some above the road and some below it
+
+		CollisionHit hit;
+
+		bool   found         = bvh.ClosestPoint(point, 1000.0f, hit);
+		double bruteDistance = BruteForceClosestDistance(corners, ToVector(point));
+
+		if (!found || fabs(hit.distance - bruteDistance) > kMaxDistanceError)
+			closestMismatches++;
+	}
+
+	printf("Closest points: %u of %u disagree with brute force\n", closestMismatches, kCheckCount);
+
+	passed = passed && closestMismatches == 0;
+
+	//------------------------ Sphere casts ------------------------//
+	// Checked with ClosestPoint(), now that it agrees with brute force, as sampling every path against every triangle would take minutes
+	unsigned int sphereMismatches = 0, sphereHitCount = 0;
+	double       worstContactError = 0.0;
+
+	for (unsigned int i = 0; i < kSphereCheckCount; i++)
+	{
+		bool                     across    = (i & 1) != 0;
+		const DirectX::XMFLOAT3& origin    = across ? acrossOrigins[i] : wheelOrigins[i];
+		DirectX::XMFLOAT3        direction = Normalised(across ? acrossDirections[i] : wheelDirections[i]);
+		float                    radius    = 0.3f + unit(random) * 0.5f;
+
+		CollisionHit hit, closest;
+		bool         found   = bvh.SphereCast(origin, direction, radius, kMaxRayDistance, hit);
+		float        clearTo = found ? hit.distance - kSampleStep : kMaxRayDistance;
+		bool         correct = true;
+
+		for (float distance = 0.0f; distance < clearTo && correct; distance += kSampleStep)
+			correct = !bvh.ClosestPoint(Along(origin, direction, distance), radius * 0.999f, closest);
+
+		if (found && hit.distance > 0.0f)
+		{
+			double contactError = bvh.ClosestPoint(Along(origin, direction, hit.distance), radius * 2.0f, closest) ? fabs(closest.distance - radius) : radius;
+
+			worstContactError = std::max(worstContactError, contactError);
+			correct           = correct && contactError <= 1e-3;
+		}
+
+		sphereMismatches += correct ? 0 : 1;
+		sphereHitCount   += found ? 1 : 0;
+	}
+
+	printf("Sphere casts: %u of %u wrong (%u hit), surface within %.2e of the radius at the hit\n", sphereMismatches, kSphereCheckCount, sphereHitCount, worstContactError);
+
+	passed = passed && sphereMismatches == 0;
+
+	//------------------------ Throughput ------------------------//
+	double       sink     = 0.0; // Printed, so that the timed loops are not optimised away
+	CollisionHit hit;
+
+	printf("Throughput over %u queries\n", kBenchmarkCount);
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+		sink += bvh.RayCast(wheelOrigins[i], wheelDirections[i], kMaxRayDistance, hit) ? hit.distance : 0.0f;
+
+	printf("  wheel rays            %6.2f M/s\n", MillionsPerSecond(startTime, kBenchmarkCount));
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+		sink += bvh.RayCast(acrossOrigins[i], acrossDirections[i], kMaxRayDistance, hit) ? hit.distance : 0.0f;
+
+	printf("  rays across the road  %6.2f M/s\n", MillionsPerSecond(startTime, kBenchmarkCount));
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+		sink += bvh.SphereCast(wheelOrigins[i], wheelDirections[i], 0.4f, kMaxRayDistance, hit) ? hit.distance : 0.0f;
+
+	printf("  sphere casts          %6.2f M/s\n", MillionsPerSecond(startTime, kBenchmarkCount));
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+		sink += bvh.ClosestPoint(DirectX::XMFLOAT3(wheelOrigins[i].x, wheelOrigins[i].y - 5.0f, wheelOrigins[i].z), 1.0f, hit) ? hit.distance : 0.0f;
+
+	printf("  closest points        %6.2f M/s\n", MillionsPerSecond(startTime, kBenchmarkCount));
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < kCheckCount; i++)
+	{
+		double distance;
+
+		if (BruteForceRayCast(corners, ToVector(wheelOrigins[i]), ToVector(Normalised(wheelDirections[i])), kMaxRayDistance, distance))
+			sink += distance;
+	}
+
+	printf("  brute force rays      %6.4f M/s (checksum %.0f)\n", MillionsPerSecond(startTime, kCheckCount), sink);
+
+	printf("%s\n", passed ? "Every query agrees" : "Some queries disagree");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
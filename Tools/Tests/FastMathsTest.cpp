@@ -0,0 +1,129 @@
+// Measures how far FastPrecision's sin/cos strays from the exact results and how much quicker it is - see Code/Maths/FastMaths.h.
+//
+//     FastMathsTest [sample count]
+//
+// The error is swept over the +-100 radians the polynomial is used for, against double precision sin/cos, and checked against the
+// bounds FastMaths.h documents. Angles outside that range and NaNs must come out exactly as ExactPrecision's. Exits with 1 if
+// anything is out of bounds. The throughput loop then times both tiers over the same 1M angles.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\FastMathsTest.cpp
+//     g++ -std=c++17 -O2 Tools/Tests/FastMathsTest.cpp
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../../Code/Maths/FastMaths.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// The bounds FastMaths.h documents for angles within +-100 radians
+	const double       kMaxSinError        = 5.4e-6;
+	const double       kMaxCosError        = 1.5e-5;
+	const float        kPolynomialRange    = 100.0f;
+
+	const unsigned int kBenchmarkCount     = 1u << 20;
+	const unsigned int kBenchmarkRepeats   = 20;
+
+	bool GetIsSameFloat(float a, float b)
+	{
+		return memcmp(&a, &b, sizeof(float)) == 0 || (a != a && b != b); // Any NaN matches any other
+	}
+
+	template<typename Precision>
+	double TimeSinCos(const std::vector<float>& angles, std::vector<float>& sinesOut, std::vector<float>& cosinesOut)
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int repeat = 0; repeat < kBenchmarkRepeats; repeat++)
+		{
+			for (unsigned int i = 0; i < (unsigned int)angles.size(); i++)
+				PrecisionMaths<Precision>::SinCos(angles[i], sinesOut[i], cosinesOut[i]);
+		}
+
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / ((double)angles.size() * kBenchmarkRepeats);
+	}
+
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int sampleCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 2000000;
+
+	if (sampleCount < 2)
+	{
+		printf("Usage: FastMathsTest [sample count]\n");
+		return 1;
+	}
+
+	bool passed = true;
+
+	//------------------------ Accuracy ------------------------//
+	double maxSinError = 0.0, maxCosError = 0.0;
+	float  worstSinAngle = 0.0f, worstCosAngle = 0.0f;
+
+	for (unsigned int i = 0; i < sampleCount; i++)
+	{
+		float angle = -kPolynomialRange + (2.0f * kPolynomialRange) * ((float)i / (float)(sampleCount - 1));
+		float sine, cosine;
+
+		PrecisionMaths<FastPrecision>::SinCos(angle, sine, cosine);
+
+		double sinError = fabs((double)sine   - sin((double)angle));
+		double cosError = fabs((double)cosine - cos((double)angle));
+
+		if (sinError > maxSinError) { maxSinError = sinError; worstSinAngle = angle; }
+		if (cosError > maxCosError) { maxCosError = cosError; worstCosAngle = angle; }
+	}
+
+	printf("Fast sin/cos over %u angles in +-%.0f radians\n", sampleCount, kPolynomialRange);
+	printf("  sin max error %.3e at %.4f (bound %.1e) %s\n", maxSinError, worstSinAngle, kMaxSinError, maxSinError <= kMaxSinError ? "" : "FAILED");
+	printf("  cos max error %.3e at %.4f (bound %.1e) %s\n", maxCosError, worstCosAngle, kMaxCosError, maxCosError <= kMaxCosError ? "" : "FAILED");
+
+	passed = passed && maxSinError <= kMaxSinError && maxCosError <= kMaxCosError;
+
+	// Past the range, and for anything that is not a number, the fast tier hands over to the exact one
+	const float  outsideAngles[]   = { 100.5f, -250.0f, 3.0e9f, -1.0e30f, INFINITY, -INFINITY, NAN };
+	unsigned int outsideMismatches = 0;
+
+	for (float angle : outsideAngles)
+	{
+		float fastSine, fastCosine, exactSine, exactCosine;
+
+		PrecisionMaths<FastPrecision>::SinCos(angle, fastSine, fastCosine);
+		PrecisionMaths<ExactPrecision>::SinCos(angle, exactSine, exactCosine);
+
+		if (!GetIsSameFloat(fastSine, exactSine) || !GetIsSameFloat(fastCosine, exactCosine))
+			outsideMismatches++;
+	}
+
+	printf("  outside the range and NaN: %u of %u differ from exact %s\n", outsideMismatches, (unsigned int)(sizeof(outsideAngles) / sizeof(float)), outsideMismatches == 0 ? "" : "FAILED");
+
+	passed = passed && outsideMismatches == 0;
+
+	//------------------------ Throughput ------------------------//
+	std::vector<float> angles(kBenchmarkCount), sines(kBenchmarkCount), cosines(kBenchmarkCount);
+
+	for (unsigned int i = 0; i < kBenchmarkCount; i++)
+		angles[i] = (float)(i % 1000) * 0.01f - 5.0f;
+
+	double exactSinCos = TimeSinCos<ExactPrecision>(angles, sines, cosines);
+	double fastSinCos  = TimeSinCos<FastPrecision>(angles, sines, cosines);
+
+	// Printing a result keeps the timed loops from being optimised away
+	printf("Throughput over %u angles, %u repeats (checksum %.3f)\n", kBenchmarkCount, kBenchmarkRepeats, sines[kBenchmarkCount / 3] + cosines[kBenchmarkCount / 5]);
+	printf("  sin/cos    exact %.2f ns, fast %.2f ns\n", exactSinCos, fastSinCos);
+
+	printf("%s\n", passed ? "Within bounds" : "Out of bounds");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,237 @@
+// Times MeshSimplifier in triangles per second and checks that it gives the same indices on every run - see
+// Code/Models/MeshSimplifier.h.
+//
+//     MeshSimplifierBenchmark [torus rings] [torus segments]
+//
+// Defaults to a 400 x 200 torus (160k triangles), plus a box built from six grids with their own normals so that every edge is a
+// seam. Each mesh is simplified to half, then given a full LOD chain, twice over. Exits with 1 if the two runs differ at all, or if
+// a torus level strays from the true surface by more than the error it reports.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\MeshSimplifierBenchmark.cpp Code\Models\MeshSimplifier.cpp Code\Models\MeshOptimiser.cpp
+//     g++ -std=c++17 -O2 Tools/Tests/MeshSimplifierBenchmark.cpp Code/Models/MeshSimplifier.cpp Code/Models/MeshOptimiser.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../Code/Models/MeshSimplifier.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float kTwoPi          = 6.2831853f;
+	const float kTorusRadius    = 3.0f;
+	const float kTubeRadius     = 1.0f;
+	const float kTorusMaxError  = 1.0f;
+
+	const int   kBoxGridSize    = 100;
+	const float kBoxMaxError    = 0.5f;
+
+	void BuildTorus(unsigned int rings, unsigned int segments, std::vector<VertexData>& verticesOut, std::vector<unsigned int>& indicesOut)
+	{
+		for (unsigned int ring = 0; ring < rings; ring++)
+		{
+			for (unsigned int segment = 0; segment < segments; segment++)
+			{
+				float u = kTwoPi * ring / rings;
+				float v = kTwoPi * segment / segments;
+
+				VertexData vertex;
+				vertex.vertexPosition = DirectX::XMFLOAT3((kTorusRadius + kTubeRadius * cosf(v)) * cosf(u), kTubeRadius * sinf(v), (kTorusRadius + kTubeRadius * cosf(v)) * sinf(u));
+				vertex.normal         = DirectX::XMFLOAT3(cosf(v) * cosf(u), sinf(v), cosf(v) * sinf(u));
+				vertex.colour         = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+
+				verticesOut.push_back(vertex);
+			}
+		}
+
+		for (unsigned int ring = 0; ring < rings; ring++)
+		{
+			for (unsigned int segment = 0; segment < segments; segment++)
+			{
+				unsigned int a = ring * segments + segment;
+				unsigned int b = ((ring + 1) % rings) * segments + segment;
+				unsigned int c = ((ring + 1) % rings) * segments + (segment + 1) % segments;
+				unsigned int d = ring * segments + (segment + 1) % segments;
+
+				indicesOut.insert(indicesOut.end(), { a, b, c, a, c, d });
+			}
+		}
+	}
+
+	// Each face has its own vertices, so the simplifier has to keep the shared positions on the edges together
+	void BuildHardEdgedBox(int gridSize, std::vector<VertexData>& verticesOut, std::vector<unsigned int>& indicesOut)
+	{
+		for (int face = 0; face < 6; face++)
+		{
+			int          axis = face / 2;
+			float        side = (face % 2) ? -1.0f : 1.0f;
+			unsigned int base = (unsigned int)verticesOut.size();
+
+			for (int row = 0; row <= gridSize; row++)
+			{
+				for (int column = 0; column <= gridSize; column++)
+				{
+					float position[3], normal[3] = { 0.0f, 0.0f, 0.0f };
+
+					position[axis]           = side;
+					position[(axis + 1) % 3] = -1.0f + 2.0f * column / gridSize;
+					position[(axis + 2) % 3] = -1.0f + 2.0f * row / gridSize;
+					normal[axis]             = side;
+
+					VertexData vertex;
+					vertex.vertexPosition = DirectX::XMFLOAT3(position[0], position[1], position[2]);
+					vertex.normal         = DirectX::XMFLOAT3(normal[0], normal[1], normal[2]);
+					vertex.colour         = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+
+					verticesOut.push_back(vertex);
+				}
+			}
+
+			for (int row = 0; row < gridSize; row++)
+			{
+				for (int column = 0; column < gridSize; column++)
+				{
+					unsigned int a = base + row * (gridSize + 1) + column;
+					unsigned int b = a + 1;
+					unsigned int c = a + gridSize + 1;
+					unsigned int d = c + 1;
+
+					if (side > 0.0f)
+						indicesOut.insert(indicesOut.end(), { a, b, d, a, d, c });
+					else
+						indicesOut.insert(indicesOut.end(), { a, d, b, a, c, d });
+				}
+			}
+		}
+	}
+
+	// How far a point is from the surface of the torus BuildTorus() samples
+	double TorusDistance(const DirectX::XMFLOAT3& point)
+	{
+		double ring = sqrt((double)point.x * point.x + (double)point.z * point.z) - kTorusRadius;
+
+		return fabs(sqrt(ring * ring + (double)point.y * point.y) - kTubeRadius);
+	}
+
+	// Furthest any triangle's centre sits from the torus - the corners are all vertices of the full detail mesh
+	double WorstTorusDistance(const std::vector<VertexData>& vertices, const std::vector<unsigned int>& indices, const MeshLod& lod)
+	{
+		double worst = 0.0;
+
+		for (unsigned int i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; i += 3)
+		{
+			const DirectX::XMFLOAT3& a = vertices[indices[i]].vertexPosition;
+			const DirectX::XMFLOAT3& b = vertices[indices[i + 1]].vertexPosition;
+			const DirectX::XMFLOAT3& c = vertices[indices[i + 2]].vertexPosition;
+
+			worst = std::max(worst, TorusDistance(DirectX::XMFLOAT3((a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f)));
+		}
+
+		return worst;
+	}
+
+	double Seconds(std::chrono::steady_clock::time_point startTime)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	// Returns false if the two runs differ, or the torus strays further than the errors reported
+	bool Run(const char* name, const std::vector<VertexData>& vertices, const std::vector<unsigned int>& indices, float maxError, bool isTorus)
+	{
+		unsigned int triangleCount = (unsigned int)(indices.size() / 3);
+
+		//------------------------ Simplify ------------------------//
+		std::vector<unsigned int> halved, halvedAgain;
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		float  error   = MeshSimplifier::Simplify(vertices, indices, (unsigned int)indices.size() / 2, maxError, halved);
+		double seconds = Seconds(startTime);
+
+		MeshSimplifier::Simplify(vertices, indices, (unsigned int)indices.size() / 2, maxError, halvedAgain);
+
+		printf("%s, %u triangles\n", name, triangleCount);
+		printf("  Simplify to %u triangles (error %.4f) in %.1f ms, %.2f M input triangles/s\n", (unsigned int)(halved.size() / 3), error, seconds * 1000.0, triangleCount / seconds / 1.0e6);
+
+		//------------------------ LOD chain ------------------------//
+		std::vector<unsigned int> chain = indices, chainAgain = indices;
+		MeshLod                   lods[kMaxMeshLods], lodsAgain[kMaxMeshLods];
+
+		startTime = std::chrono::steady_clock::now();
+
+		unsigned int lodCount = MeshSimplifier::GenerateLods(vertices, chain, maxError, lods, kMaxMeshLods);
+
+		seconds = Seconds(startTime);
+
+		unsigned int lodCountAgain = MeshSimplifier::GenerateLods(vertices, chainAgain, maxError, lodsAgain, kMaxMeshLods);
+
+		printf("  GenerateLods %u levels in %.1f ms, %.2f M input triangles/s\n", lodCount, seconds * 1000.0, triangleCount / seconds / 1.0e6);
+
+		bool withinError = true;
+
+		for (unsigned int lod = 0; lod < lodCount; lod++)
+		{
+			printf("    level %u: %7u triangles, error %.4f", lod, lods[lod].indexCount / 3, lods[lod].error);
+
+			if (isTorus)
+			{
+				double distance = WorstTorusDistance(vertices, chain, lods[lod]);
+
+				// The full detail level is only as close as its own flat triangles
+				double allowed = lods[lod].error + WorstTorusDistance(vertices, chain, lods[0]);
+
+				printf(", furthest from the torus %.4f %s", distance, distance <= allowed ? "" : "FAILED");
+
+				withinError = withinError && distance <= allowed;
+			}
+
+			printf("\n");
+		}
+
+		bool isSameLods = lodCount == lodCountAgain;
+
+		for (unsigned int lod = 0; lod < lodCount && isSameLods; lod++)
+			isSameLods = lods[lod].firstIndex == lodsAgain[lod].firstIndex && lods[lod].indexCount == lodsAgain[lod].indexCount && lods[lod].error == lodsAgain[lod].error;
+
+		bool deterministic = halved == halvedAgain && chain == chainAgain && isSameLods;
+
+		printf("  Second run %s\n", deterministic ? "identical" : "DIFFERS");
+
+		return deterministic && withinError;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int rings    = argc > 1 ? (unsigned int)atoi(argv[1]) : 400;
+	unsigned int segments = argc > 2 ? (unsigned int)atoi(argv[2]) : 200;
+
+	if (rings < 3 || segments < 3)
+	{
+		printf("Usage: MeshSimplifierBenchmark [torus rings] [torus segments]\n");
+		return 1;
+	}
+
+	std::vector<VertexData>   torusVertices, boxVertices;
+	std::vector<unsigned int> torusIndices, boxIndices;
+
+	BuildTorus(rings, segments, torusVertices, torusIndices);
+	BuildHardEdgedBox(kBoxGridSize, boxVertices, boxIndices);
+
+	bool passed = Run("Torus", torusVertices, torusIndices, kTorusMaxError, true);
+
+	passed = Run("Hard edged box", boxVertices, boxIndices, kBoxMaxError, false) && passed;
+
+	printf("%s\n", passed ? "Deterministic and within the reported errors" : "Failed");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
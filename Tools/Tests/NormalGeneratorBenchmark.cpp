@@ -0,0 +1,270 @@
+// Times NormalGenerator with and without a worker pool and checks that every thread count gives the same bits - see
+// Code/Models/NormalGenerator.h.
+//
+//     NormalGeneratorBenchmark [grid size] [max threads]
+//
+// Defaults to a 1200 x 1200 rolling heightfield (2.88M triangles) and pools of 1, 2, 4 and 8 threads. Both weightings are timed,
+// then the tangents. Angle weighted normals are also compared against the same sums done in double precision. Exits with 1 if any
+// pool's output differs from the single threaded one by a single bit, or the normals stray from the double precision ones.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\NormalGeneratorBenchmark.cpp Code\Models\NormalGenerator.cpp Code\Threading\WorkerPool.cpp
+//     g++ -std=c++17 -O2 -pthread Tools/Tests/NormalGeneratorBenchmark.cpp Code/Models/NormalGenerator.cpp Code/Threading/WorkerPool.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../../Code/Models/NormalGenerator.h"
+#include "../../Code/Threading/WorkerPool.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const unsigned int kRepeats            = 3;
+
+	// Float sums against double ones, over a smooth surface
+	const double       kMaxNormalDegrees   = 1.0e-4;
+
+	void BuildHeightfield(unsigned int gridSize, std::vector<VertexData>& verticesOut, std::vector<unsigned int>& indicesOut)
+	{
+		for (unsigned int row = 0; row <= gridSize; row++)
+		{
+			for (unsigned int column = 0; column <= gridSize; column++)
+			{
+				float x = (float)column * 0.5f;
+				float z = (float)row * 0.5f;
+
+				VertexData vertex;
+				vertex.vertexPosition = DirectX::XMFLOAT3(x, 4.0f * sinf(x * 0.05f) * cosf(z * 0.07f) + 0.5f * sinf(x * 0.6f + z * 0.3f), z);
+				vertex.normal         = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+				vertex.colour         = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+
+				verticesOut.push_back(vertex);
+			}
+		}
+
+		for (unsigned int row = 0; row < gridSize; row++)
+		{
+			for (unsigned int column = 0; column < gridSize; column++)
+			{
+				unsigned int a = row * (gridSize + 1) + column;
+				unsigned int b = a + 1;
+				unsigned int c = a + gridSize + 1;
+				unsigned int d = c + 1;
+
+				indicesOut.insert(indicesOut.end(), { a, c, b, b, c, d });
+			}
+		}
+	}
+
+	// Largest angle, in degrees, between the generated normals and angle weighted ones summed in double precision
+	double CompareWithDoublePrecision(const std::vector<VertexData>& vertices, const std::vector<unsigned int>& indices)
+	{
+		std::vector<double> sums(vertices.size() * 3, 0.0);
+
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			double corners[3][3];
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				const DirectX::XMFLOAT3& position = vertices[indices[i + corner]].vertexPosition;
+
+				corners[corner][0] = position.x;
+				corners[corner][1] = position.y;
+				corners[corner][2] = position.z;
+			}
+
+			double edgeA[3], edgeB[3];
+
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				edgeA[axis] = corners[1][axis] - corners[0][axis];
+				edgeB[axis] = corners[2][axis] - corners[0][axis];
+			}
+
+			double normal[3] = { edgeA[1] * edgeB[2] - edgeA[2] * edgeB[1], edgeA[2] * edgeB[0] - edgeA[0] * edgeB[2], edgeA[0] * edgeB[1] - edgeA[1] * edgeB[0] };
+			double length    = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			if (length == 0.0)
+				continue;
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				double toNext[3], toPrevious[3];
+
+				for (unsigned int axis = 0; axis < 3; axis++)
+				{
+					toNext[axis]     = corners[(corner + 1) % 3][axis] - corners[corner][axis];
+					toPrevious[axis] = corners[(corner + 2) % 3][axis] - corners[corner][axis];
+				}
+
+				double cosine = (toNext[0] * toPrevious[0] + toNext[1] * toPrevious[1] + toNext[2] * toPrevious[2]) /
+				                sqrt((toNext[0] * toNext[0] + toNext[1] * toNext[1] + toNext[2] * toNext[2]) * (toPrevious[0] * toPrevious[0] + toPrevious[1] * toPrevious[1] + toPrevious[2] * toPrevious[2]));
+				double angle  = acos(std::max(-1.0, std::min(1.0, cosine)));
+
+				for (unsigned int axis = 0; axis < 3; axis++)
+					sums[indices[i + corner] * 3 + axis] += normal[axis] / length * angle;
+			}
+		}
+
+		double worst = 0.0;
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			const double* sum    = &sums[i * 3];
+			double        length = sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+
+			if (length == 0.0)
+				continue;
+
+			const DirectX::XMFLOAT3& normal       = vertices[i].normal;
+			double                   normalLength = sqrt((double)normal.x * normal.x + (double)normal.y * normal.y + (double)normal.z * normal.z);
+
+			double x = sum[0] / length - normal.x / normalLength;
+			double y = sum[1] / length - normal.y / normalLength;
+			double z = sum[2] / length - normal.z / normalLength;
+
+			// From the chord - acos of a dot product a rounding away from 1 reads as hundredths of a degree
+			worst = std::max(worst, 2.0 * asin(std::min(1.0, sqrt(x * x + y * y + z * z) * 0.5)) * 180.0 / 3.14159265358979);
+		}
+
+		return worst;
+	}
+
+	// Best of a few runs, as the first touches memory the others find already paged in
+	double TimeNormals(const std::vector<VertexData>& source, const std::vector<unsigned int>& indices, NormalWeighting weighting, WorkerPool* workerPool, std::vector<VertexData>& verticesOut)
+	{
+		double best = 1.0e9;
+
+		for (unsigned int repeat = 0; repeat < kRepeats; repeat++)
+		{
+			verticesOut = source;
+
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			NormalGenerator::GenerateNormals(verticesOut, indices, 0, (unsigned int)indices.size(), weighting, false, workerPool);
+
+			best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+		}
+
+		return best;
+	}
+
+	double TimeTangents(const std::vector<VertexData>& vertices, const std::vector<DirectX::XMFLOAT2>& textureCoordinates, const std::vector<unsigned int>& indices, WorkerPool* workerPool,
+	                    std::vector<DirectX::XMFLOAT4>& tangentsOut)
+	{
+		double best = 1.0e9;
+
+		for (unsigned int repeat = 0; repeat < kRepeats; repeat++)
+		{
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			NormalGenerator::GenerateTangents(vertices, textureCoordinates, indices, 0, (unsigned int)indices.size(), tangentsOut, workerPool);
+
+			best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+		}
+
+		return best;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int gridSize   = argc > 1 ? (unsigned int)atoi(argv[1]) : 1200;
+	unsigned int maxThreads = argc > 2 ? (unsigned int)atoi(argv[2]) : 8;
+
+	if (gridSize == 0 || maxThreads == 0)
+	{
+		printf("Usage: NormalGeneratorBenchmark [grid size] [max threads]\n");
+		return 1;
+	}
+
+	std::vector<VertexData>   source;
+	std::vector<unsigned int> indices;
+
+	BuildHeightfield(gridSize, source, indices);
+
+	unsigned int triangleCount = (unsigned int)(indices.size() / 3);
+
+	printf("Heightfield of %u vertices, %u triangles\n", (unsigned int)source.size(), triangleCount);
+
+	bool passed = true;
+
+	//------------------------ Normals ------------------------//
+	const NormalWeighting weightings[]     = { NormalWeighting::AREA, NormalWeighting::ANGLE };
+	const char* const     weightingNames[] = { "Area", "Angle" };
+
+	std::vector<VertexData> withoutPool, withPool;
+
+	for (unsigned int weighting = 0; weighting < 2; weighting++)
+	{
+		double milliseconds = TimeNormals(source, indices, weightings[weighting], nullptr, withoutPool);
+
+		printf("%s weighted normals\n", weightingNames[weighting]);
+		printf("  no pool    %7.1f ms, %.1f M triangles/s\n", milliseconds, triangleCount / milliseconds / 1000.0);
+
+		if (weightings[weighting] == NormalWeighting::ANGLE)
+		{
+			double degrees = CompareWithDoublePrecision(withoutPool, indices);
+
+			printf("  within %.2e degrees of double precision sums %s\n", degrees, degrees <= kMaxNormalDegrees ? "" : "FAILED");
+
+			passed = passed && degrees <= kMaxNormalDegrees;
+		}
+
+		for (unsigned int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+		{
+			WorkerPool workerPool(threadCount);
+
+			milliseconds = TimeNormals(source, indices, weightings[weighting], &workerPool, withPool);
+
+			bool identical = memcmp(withPool.data(), withoutPool.data(), withPool.size() * sizeof(VertexData)) == 0;
+
+			printf("  %u threads  %7.1f ms, %.1f M triangles/s, %s\n", threadCount, milliseconds, triangleCount / milliseconds / 1000.0, identical ? "identical" : "DIFFERS");
+
+			passed = passed && identical;
+		}
+	}
+
+	//------------------------ Tangents ------------------------//
+	// Planar mapped from above, so every vertex has a usable mapping
+	std::vector<DirectX::XMFLOAT2> textureCoordinates(withoutPool.size());
+
+	for (size_t i = 0; i < withoutPool.size(); i++)
+		textureCoordinates[i] = DirectX::XMFLOAT2(withoutPool[i].vertexPosition.x, withoutPool[i].vertexPosition.z);
+
+	std::vector<DirectX::XMFLOAT4> tangentsWithoutPool, tangentsWithPool;
+
+	double milliseconds = TimeTangents(withoutPool, textureCoordinates, indices, nullptr, tangentsWithoutPool);
+
+	printf("Tangents\n");
+	printf("  no pool    %7.1f ms, %.1f M triangles/s\n", milliseconds, triangleCount / milliseconds / 1000.0);
+
+	for (unsigned int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		WorkerPool workerPool(threadCount);
+
+		milliseconds = TimeTangents(withoutPool, textureCoordinates, indices, &workerPool, tangentsWithPool);
+
+		bool identical = tangentsWithPool.size() == tangentsWithoutPool.size() &&
+		                 memcmp(tangentsWithPool.data(), tangentsWithoutPool.data(), tangentsWithPool.size() * sizeof(DirectX::XMFLOAT4)) == 0;
+
+		printf("  %u threads  %7.1f ms, %.1f M triangles/s, %s\n", threadCount, milliseconds, triangleCount / milliseconds / 1000.0, identical ? "identical" : "DIFFERS");
+
+		passed = passed && identical;
+	}
+
+	printf("%s\n", passed ? "Every thread count gives the same normals and tangents" : "Failed");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
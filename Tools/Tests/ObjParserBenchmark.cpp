@@ -0,0 +1,225 @@
+// Times loading a large OBJ through MappedFile and ObjParser against reading it with std::getline and std::istringstream, and checks
+// what the parser makes of it - see Code/Models/ObjParser.h.
+//
+//     ObjParserBenchmark [grid side] [repeats]
+//
+// Defaults to a rolling 1200 x 1200 vertex heightfield with a normal per vertex, its 2.9M triangles written as quads the way modelling
+// tools export them (about 180 MB). The file is written to the temporary directory and removed afterwards. The baseline reads the same
+// "v", "vn" and "f" lines into the same arrays, without merging position/normal pairs. A few small files check vertex colours, negative
+// indices and that a bad index fails and leaves the outputs alone. Exits with 1 if either reader gets the counts wrong.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\ObjParserBenchmark.cpp Code\Models\ObjParser.cpp Code\Memory\MappedFile.cpp
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../../Code/Memory/MappedFile.h"
+#include "../../Code/Models/ObjParser.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float kGridSpacing = 0.25f;
+
+	// Positions and normals are written in the same order, so vertex i's normal is normal i
+	bool WriteHeightfield(const std::string& filePath, unsigned int side)
+	{
+		FILE* file = fopen(filePath.c_str(), "w");
+
+		if (!file)
+			return false;
+
+		for (unsigned int z = 0; z < side; z++)
+		{
+			for (unsigned int x = 0; x < side; x++)
+				fprintf(file, "v %.6f %.6f %.6f\n", x * kGridSpacing, sinf(x * 0.05f) * cosf(z * 0.07f) * 4.0f, z * kGridSpacing);
+		}
+
+		for (unsigned int z = 0; z < side; z++)
+		{
+			for (unsigned int x = 0; x < side; x++)
+			{
+				float dx     = 0.05f * cosf(x * 0.05f) * cosf(z * 0.07f) * 4.0f / kGridSpacing;
+				float dz     = -0.07f * sinf(x * 0.05f) * sinf(z * 0.07f) * 4.0f / kGridSpacing;
+				float length = sqrtf(dx * dx + 1.0f + dz * dz);
+
+				fprintf(file, "vn %.6f %.6f %.6f\n", -dx / length, 1.0f / length, -dz / length);
+			}
+		}
+
+		// OBJ indices count from 1
+		for (unsigned int z = 0; z + 1 < side; z++)
+		{
+			for (unsigned int x = 0; x + 1 < side; x++)
+			{
+				unsigned int a = z * side + x + 1;
+				unsigned int b = a + side;
+
+				fprintf(file, "f %u//%u %u//%u %u//%u %u//%u\n", a, a, b, b, b + 1, b + 1, a + 1, a + 1);
+			}
+		}
+
+		return fclose(file) == 0;
+	}
+
+	// The usual way to read an OBJ - a line at a time, through a string stream. Polygons are fanned the same way ObjParser fans them.
+	bool ReadWithStreams(const std::string& filePath, std::vector<DirectX::XMFLOAT3>& positionsOut, std::vector<DirectX::XMFLOAT3>& normalsOut, std::vector<unsigned int>& indicesOut)
+	{
+		std::ifstream file(filePath);
+
+		if (!file)
+			return false;
+
+		std::string               line, keyword, corner;
+		std::vector<unsigned int> polygon;
+
+		while (std::getline(file, line))
+		{
+			std::istringstream stream(line);
+			DirectX::XMFLOAT3  vector;
+
+			keyword.clear();
+			stream >> keyword;
+
+			if (keyword == "v")
+			{
+				stream >> vector.x >> vector.y >> vector.z;
+				positionsOut.push_back(vector);
+			}
+			else if (keyword == "vn")
+			{
+				stream >> vector.x >> vector.y >> vector.z;
+				normalsOut.push_back(vector);
+			}
+			else if (keyword == "f")
+			{
+				polygon.clear();
+
+				while (stream >> corner)
+					polygon.push_back((unsigned int)std::stoul(corner) - 1);
+
+				for (unsigned int i = 2; i < (unsigned int)polygon.size(); i++)
+				{
+					indicesOut.push_back(polygon[0]);
+					indicesOut.push_back(polygon[i - 1]);
+					indicesOut.push_back(polygon[i]);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool Parse(const char* text, std::vector<VertexData>& verticesOut, std::vector<unsigned int>& indicesOut)
+	{
+		return ObjParser::Parse(text, strlen(text), verticesOut, indicesOut);
+	}
+
+	// Returns false if the parser gets any of the small files wrong
+	bool CheckSmallFiles()
+	{
+		std::vector<VertexData>   vertices;
+		std::vector<unsigned int> indices;
+
+		// A quad, then a triangle using negative indices and a vertex colour
+		const char* quad = "# quad\nv 0 0 0\nv 1 0 0 1 0.5 0\nv 1 1 0\nv 0 1 0\nvn 0 0 1\nvt 0 0\nf 1//1 2//1 3//1 4//1\nf -4/1/-1 -2/1/1 -1//1\n";
+
+		bool quadPassed = Parse(quad, vertices, indices) && vertices.size() == 4 && indices.size() == 9 && indices[3] == 0 && indices[4] == 2
+		                  && indices[5] == 3 && indices[6] == 0 && indices[7] == 2 && vertices[1].colour.x == 1.0f && vertices[1].colour.y == 0.5f;
+
+		// Refers to vertices that are not there
+		bool badPassed = !Parse("v 0 0 0\nf 1 2 3\n", vertices, indices) && vertices.size() == 4 && indices.size() == 9;
+
+		printf("Small files: quad and negative indices %s, out of range index %s\n", quadPassed ? "read" : "MISREAD", badPassed ? "rejected" : "NOT REJECTED");
+
+		return quadPassed && badPassed;
+	}
+
+	double Milliseconds(std::chrono::steady_clock::time_point startTime)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int side    = argc > 1 ? (unsigned int)atoi(argv[1]) : 1200;
+	unsigned int repeats = argc > 2 ? (unsigned int)atoi(argv[2]) : 3;
+
+	if (side < 2 || repeats == 0)
+	{
+		printf("Usage: ObjParserBenchmark [grid side] [repeats]\n");
+		return 1;
+	}
+
+	bool passed = CheckSmallFiles();
+
+	std::error_code error;
+	std::string     filePath = (std::filesystem::temp_directory_path(error) / "ObjParserBenchmark.obj").string();
+
+	if (!WriteHeightfield(filePath, side))
+	{
+		printf("Could not write %s\n", filePath.c_str());
+		return 1;
+	}
+
+	unsigned int vertexCount   = side * side;
+	unsigned int triangleCount = (side - 1) * (side - 1) * 2;
+	double       megabytes     = (double)std::filesystem::file_size(filePath, error) / 1e6;
+
+	printf("%.1f MB OBJ: %u positions, %u normals, %u triangles as quads\n", megabytes, vertexCount, vertexCount, triangleCount);
+
+	//------------------------ MappedFile + ObjParser ------------------------//
+	// Straight after writing, the file is in the page cache for both readers
+	for (unsigned int repeat = 0; repeat < repeats; repeat++)
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		MappedFile                file;
+		std::vector<VertexData>   vertices;
+		std::vector<unsigned int> indices;
+
+		bool   parsed = file.Open(filePath) && ObjParser::Parse(file.GetData(), file.GetSize(), vertices, indices);
+		double time   = Milliseconds(startTime);
+
+		printf("  mapped + ObjParser       %5.0f ms  %5.0f MB/s  %u vertices, %u triangles\n", time, megabytes / time * 1e3, (unsigned int)vertices.size(),
+		       (unsigned int)indices.size() / 3);
+
+		passed = passed && parsed && vertices.size() == vertexCount && indices.size() == triangleCount * 3;
+	}
+
+	//------------------------ getline + istringstream ------------------------//
+	{
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		std::vector<DirectX::XMFLOAT3> positions, normals;
+		std::vector<unsigned int>      indices;
+
+		bool   read = ReadWithStreams(filePath, positions, normals, indices);
+		double time = Milliseconds(startTime);
+
+		printf("  getline + istringstream  %5.0f ms  %5.0f MB/s  %u positions, %u normals, %u triangles\n", time, megabytes / time * 1e3,
+		       (unsigned int)positions.size(), (unsigned int)normals.size(), (unsigned int)indices.size() / 3);
+
+		passed = passed && read && positions.size() == vertexCount && normals.size() == vertexCount && indices.size() == triangleCount * 3;
+	}
+
+	std::filesystem::remove(filePath, error);
+
+	printf("%s\n", passed ? "Both readers read the whole file" : "A reader got the file wrong");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
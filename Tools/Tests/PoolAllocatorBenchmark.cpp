@@ -0,0 +1,187 @@
+// Times creating and destroying track pieces from a PoolAllocator against new and delete, and checks that released handles stay
+// dead - see Code/Memory/PoolAllocator.h.
+//
+//     PoolAllocatorBenchmark [live pieces] [destroy+create pairs]
+//
+// Defaults to 100k live pieces and 10M pairs, each destroying a random piece and creating another in its place, as a track editor
+// or streamer would. Both ways replace the same pieces in the same order. Bulk clearing all of them is then timed against deleting
+// each one. Along the way, every handle that is released, and every handle alive at a Clear(), is checked to no longer resolve -
+// including after its slot has been handed out again. Exits with 1 if a stale handle ever does.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\PoolAllocatorBenchmark.cpp Code\Track\TrackPiece.cpp Code\Models\*.cpp Code\Shaders\ShaderHandler.cpp
+//        Code\Collisions\TrackCollision.cpp Code\Maths\*.cpp d3d11.lib d3dcompiler.lib
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../Code/Collisions/TrackCollision.h"
+#include "../../Code/Memory/PoolAllocator.h"
+#include "../../Code/Models/Model.h"
+#include "../../Code/Shaders/ShaderHandler.h"
+#include "../../Code/Track/TrackPiece.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// The stale handle checks run over this many pairs, outside of the timed loops
+	const unsigned int kCheckedPairCount = 1000000;
+
+	TrackPieceType GetType(unsigned int pair)
+	{
+		return (TrackPieceType)(pair % (unsigned int)TrackPieceType::MAX);
+	}
+
+	double Milliseconds(std::chrono::steady_clock::time_point startTime)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void PrintStats(const char* when, const PoolAllocatorStats& stats)
+	{
+		printf("  %s: %u live (peak %u), %u slots in %u blocks, %.1f MB reserved, %llu allocations and %llu releases so far\n", when, stats.liveCount,
+		       stats.peakLiveCount, stats.slotCapacity, stats.blockCount, stats.bytesReserved / 1048576.0, stats.allocationCount, stats.releaseCount);
+	}
+
+	// Returns how many released handles still resolve, which should be none
+	unsigned int CheckStaleHandles(unsigned int liveCount, const std::vector<unsigned int>& picks, Model& model, TrackCollision& collision)
+	{
+		// Small blocks, so that the pool grows a few times on the way up
+		PoolAllocator<TrackPiece, 64> pool;
+		std::vector<PoolHandle>       handles(liveCount);
+		unsigned int                  staleCount = 0;
+
+		for (PoolHandle& handle : handles)
+			handle = pool.Allocate(TrackPieceType::STRAIGHT_FORWARD, model, collision);
+
+		for (unsigned int pair = 0; pair < kCheckedPairCount; pair++)
+		{
+			PoolHandle& handle  = handles[picks[pair]];
+			PoolHandle  old     = handle;
+			bool        release = pool.Release(old);
+
+			handle = pool.Allocate(GetType(pair), model, collision);
+
+			// The free list hands the same slot straight back, so this is the case that matters
+			staleCount += release && !pool.Get(old) && !pool.Release(old) && pool.Get(handle)->GetType() == GetType(pair) ? 0 : 1;
+		}
+
+		pool.Clear();
+
+		for (const PoolHandle& handle : handles)
+			staleCount += pool.Get(handle) ? 1 : 0;
+
+		// Slots reused after the clear must not bring the old handles back either
+		for (unsigned int i = 0; i < liveCount; i++)
+			pool.Allocate(TrackPieceType::T_PIECE, model, collision);
+
+		for (const PoolHandle& handle : handles)
+			staleCount += pool.Get(handle) ? 1 : 0;
+
+		PrintStats("after the checks", pool.GetStats());
+
+		return staleCount;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int liveCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 100000;
+	unsigned int pairCount = argc > 2 ? (unsigned int)atoi(argv[2]) : 10000000;
+
+	if (liveCount == 0 || pairCount < kCheckedPairCount)
+	{
+		printf("Usage: PoolAllocatorBenchmark [live pieces] [destroy+create pairs, at least %u]\n", kCheckedPairCount);
+		return 1;
+	}
+
+	// Every piece shares one empty model and one empty set of collision data - nothing here draws or collides with them
+	ShaderHandler  shaderHandler(nullptr, nullptr);
+	Model          model(shaderHandler);
+	TrackCollision collision("");
+
+	// A fixed seed, and the same pieces replaced in the same order both ways
+	std::mt19937              random(5);
+	std::vector<unsigned int> picks(pairCount);
+
+	for (unsigned int& pick : picks)
+		pick = random() % liveCount;
+
+	printf("%u live pieces, %u destroy+create pairs\n", liveCount, pairCount);
+
+	//------------------------ Stale handles ------------------------//
+	unsigned int staleCount = CheckStaleHandles(liveCount, picks, model, collision);
+
+	printf("  %u released handles still resolve\n", staleCount);
+
+	//------------------------ Pool ------------------------//
+	double poolChurnTime, poolClearTime;
+
+	{
+		PoolAllocator<TrackPiece> pool;
+		std::vector<PoolHandle>   handles(liveCount);
+
+		for (PoolHandle& handle : handles)
+			handle = pool.Allocate(TrackPieceType::STRAIGHT_FORWARD, model, collision);
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int pair = 0; pair < pairCount; pair++)
+		{
+			PoolHandle& handle = handles[picks[pair]];
+
+			pool.Release(handle);
+			handle = pool.Allocate(GetType(pair), model, collision);
+		}
+
+		poolChurnTime = Milliseconds(startTime);
+
+		PrintStats("pool after the pairs", pool.GetStats());
+
+		startTime = std::chrono::steady_clock::now();
+		pool.Clear();
+		poolClearTime = Milliseconds(startTime);
+	}
+
+	//------------------------ new and delete ------------------------//
+	double heapChurnTime, heapClearTime;
+
+	{
+		std::vector<TrackPiece*> pieces(liveCount);
+
+		for (TrackPiece*& piece : pieces)
+			piece = new TrackPiece(TrackPieceType::STRAIGHT_FORWARD, model, collision);
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int pair = 0; pair < pairCount; pair++)
+		{
+			TrackPiece*& piece = pieces[picks[pair]];
+
+			delete piece;
+			piece = new TrackPiece(GetType(pair), model, collision);
+		}
+
+		heapChurnTime = Milliseconds(startTime);
+		startTime     = std::chrono::steady_clock::now();
+
+		for (TrackPiece* piece : pieces)
+			delete piece;
+
+		heapClearTime = Milliseconds(startTime);
+	}
+
+	printf("  pool        %5.1f M pairs/s, Clear() %.2f ms\n", pairCount / poolChurnTime / 1e3, poolClearTime);
+	printf("  new/delete  %5.1f M pairs/s, deleting each %.2f ms\n", pairCount / heapChurnTime / 1e3, heapClearTime);
+
+	printf("%s\n", staleCount == 0 ? "No stale handle resolves" : "Stale handles resolve");
+
+	return staleCount == 0 ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
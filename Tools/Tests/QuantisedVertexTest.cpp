@@ -0,0 +1,163 @@
+// Round trips random vertices through QuantisedVertexData and checks every error against the bounds VertexQuantiser reports -
+// see Code/Models/QuantisedVertex.h.
+//
+//     QuantisedVertexTest [vertex count]
+//
+// Defaults to 4M vertices inside a lopsided box, with random unit normals (the six axes among them) and colours. Also checks
+// that positions and colours outside their ranges are clamped, and that a zero normal decodes to something finite. Exits with 1
+// if any vertex strays past the bounds. The batch Encode() is then timed over the same vertices.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\QuantisedVertexTest.cpp Code\Models\QuantisedVertex.cpp
+//     g++ -std=c++17 -O2 Tools/Tests/QuantisedVertexTest.cpp Code/Models/QuantisedVertex.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../Code/Models/QuantisedVertex.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const DirectX::XMFLOAT3 kBoundsMin(-3.0f, -0.5f, -12.0f);
+	const DirectX::XMFLOAT3 kBoundsMax( 9.0f,  2.5f,   4.0f);
+
+	const unsigned int      kEncodeRepeats = 10;
+
+	// In double precision, so that the measurement adds no rounding of its own
+	double AngleBetween(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b)
+	{
+		double lengthA = sqrt((double)a.x * a.x + (double)a.y * a.y + (double)a.z * a.z);
+		double lengthB = sqrt((double)b.x * b.x + (double)b.y * b.y + (double)b.z * b.z);
+
+		double x = a.x / lengthA - b.x / lengthB;
+		double y = a.y / lengthA - b.y / lengthB;
+		double z = a.z / lengthA - b.z / lengthB;
+
+		// From the chord, which stays accurate for tiny angles where acos of the dot product does not
+		return 2.0 * asin(std::min(1.0, sqrt(x * x + y * y + z * z) * 0.5));
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int count = argc > 1 ? (unsigned int)atoi(argv[1]) : 4000000;
+
+	if (count == 0)
+	{
+		printf("Usage: QuantisedVertexTest [vertex count]\n");
+		return 1;
+	}
+
+	QuantisationErrorBounds bounds = VertexQuantiser::GetErrorBounds(kBoundsMin, kBoundsMax);
+
+	// A fixed seed, so that every run checks the same vertices
+	std::mt19937                          random(7);
+	std::normal_distribution<float>       direction(0.0f, 1.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	const DirectX::XMFLOAT3 axes[] = { { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+	const unsigned int      axisCount = (unsigned int)(sizeof(axes) / sizeof(axes[0]));
+
+	std::vector<VertexData> vertices(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		VertexData& vertex = vertices[i];
+
+		vertex.vertexPosition = DirectX::XMFLOAT3(kBoundsMin.x + unit(random) * (kBoundsMax.x - kBoundsMin.x),
+		                                          kBoundsMin.y + unit(random) * (kBoundsMax.y - kBoundsMin.y),
+		                                          kBoundsMin.z + unit(random) * (kBoundsMax.z - kBoundsMin.z));
+
+		if (i < axisCount)
+		{
+			vertex.normal = axes[i];
+		}
+		else
+		{
+			float x      = direction(random), y = direction(random), z = direction(random);
+			float length = sqrtf(x * x + y * y + z * z);
+
+			vertex.normal = DirectX::XMFLOAT3(x / length, y / length, z / length);
+		}
+
+		vertex.colour = DirectX::XMFLOAT4(unit(random), unit(random), unit(random), unit(random));
+	}
+
+	//------------------------ Round trip ------------------------//
+	double       maxPosition[3] = { 0.0, 0.0, 0.0 };
+	double       maxNormal      = 0.0;
+	double       maxColour      = 0.0;
+	unsigned int outOfBounds    = 0;
+
+	for (const VertexData& vertex : vertices)
+	{
+		VertexData decoded = VertexQuantiser::Decode(VertexQuantiser::Encode(vertex, kBoundsMin, kBoundsMax), kBoundsMin, kBoundsMax);
+
+		double position[3] = { fabs((double)decoded.vertexPosition.x - vertex.vertexPosition.x),
+		                       fabs((double)decoded.vertexPosition.y - vertex.vertexPosition.y),
+		                       fabs((double)decoded.vertexPosition.z - vertex.vertexPosition.z) };
+		double normal      = AngleBetween(decoded.normal, vertex.normal);
+		double colour      = std::max(std::max(fabs((double)decoded.colour.x - vertex.colour.x), fabs((double)decoded.colour.y - vertex.colour.y)),
+		                              std::max(fabs((double)decoded.colour.z - vertex.colour.z), fabs((double)decoded.colour.w - vertex.colour.w)));
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+			maxPosition[axis] = std::max(maxPosition[axis], position[axis]);
+
+		maxNormal = std::max(maxNormal, normal);
+		maxColour = std::max(maxColour, colour);
+
+		if (position[0] > bounds.position.x || position[1] > bounds.position.y || position[2] > bounds.position.z || normal > bounds.normalRadians || colour > bounds.colour)
+			outOfBounds++;
+	}
+
+	printf("Round trip of %u vertices, %u bytes each down to %u\n", count, (unsigned int)sizeof(VertexData), (unsigned int)sizeof(QuantisedVertexData));
+	printf("  position max error %.3e %.3e %.3e (bounds %.3e %.3e %.3e)\n", maxPosition[0], maxPosition[1], maxPosition[2], bounds.position.x, bounds.position.y, bounds.position.z);
+	printf("  normal   max error %.3e radians (bound %.3e)\n", maxNormal, bounds.normalRadians);
+	printf("  colour   max error %.3e (bound %.3e)\n", maxColour, bounds.colour);
+	printf("  %u vertices out of bounds\n", outOfBounds);
+
+	//------------------------ Edge cases ------------------------//
+	VertexData outside;
+	outside.vertexPosition = DirectX::XMFLOAT3(kBoundsMax.x + 5.0f, kBoundsMin.y - 5.0f, kBoundsMax.z + 100.0f);
+	outside.normal         = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	outside.colour         = DirectX::XMFLOAT4(2.0f, -1.0f, 0.5f, 1.0f);
+
+	VertexData clamped = VertexQuantiser::Decode(VertexQuantiser::Encode(outside, kBoundsMin, kBoundsMax), kBoundsMin, kBoundsMax);
+
+	bool positionClamped = fabsf(clamped.vertexPosition.x - kBoundsMax.x) <= bounds.position.x && fabsf(clamped.vertexPosition.y - kBoundsMin.y) <= bounds.position.y &&
+	                       fabsf(clamped.vertexPosition.z - kBoundsMax.z) <= bounds.position.z;
+	bool colourClamped   = clamped.colour.x == 1.0f && clamped.colour.y == 0.0f;
+	bool normalFinite    = isfinite(clamped.normal.x) && isfinite(clamped.normal.y) && isfinite(clamped.normal.z);
+
+	printf("  outside the bounds: position %s, colour %s, zero normal %s\n", positionClamped ? "clamped" : "FAILED", colourClamped ? "clamped" : "FAILED", normalFinite ? "finite" : "FAILED");
+
+	bool passed = outOfBounds == 0 && positionClamped && colourClamped && normalFinite;
+
+	//------------------------ Throughput ------------------------//
+	std::vector<QuantisedVertexData> quantised(count);
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int repeat = 0; repeat < kEncodeRepeats; repeat++)
+		VertexQuantiser::Encode(vertices.data(), vertices.size(), kBoundsMin, kBoundsMax, quantised.data());
+
+	double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / ((double)count * kEncodeRepeats);
+
+	// Printing a result keeps the timed loop from being optimised away
+	printf("Encode %.2f ns/vertex, %.1f MB down to %.1f MB (%.2fx smaller, checksum %u)\n", nanoseconds, (double)count * sizeof(VertexData) / (1024.0 * 1024.0),
+	       (double)count * sizeof(QuantisedVertexData) / (1024.0 * 1024.0), (double)sizeof(VertexData) / sizeof(QuantisedVertexData), (unsigned int)quantised[count / 2].position[0]);
+
+	printf("%s\n", passed ? "Within bounds" : "Out of bounds");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
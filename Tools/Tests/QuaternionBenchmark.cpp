@@ -0,0 +1,188 @@
+// Checks Quaternion's rotations against the axis rotation matrices they replaced, then times a frame of ThirdPersonCamera mouse look
+// both ways and a frame of its movement maths - see Code/Maths/CommonMaths.h and Code/Camera/ThirdPersonCamera.cpp.
+//
+//     QuaternionBenchmark [frames]
+//
+// Defaults to 10M frames, each pitching about the camera's right vector and then yawing about the world up, as RotationalCheck() does.
+// The matrix path is the one the camera used before: six Rodrigues/axis matrices applied to the offset, right and up vectors, then
+// both axes normalised. Before timing, 1M random rotations - one axis at a time, and a pitch followed by a yaw - must agree with
+// the matrices to within 1e-6. Exits with 1 if any does not. The movement frames are MovementCheck()'s vector maths with a strafe, a
+// climb and a forward key all held down - build it against an older CommonMaths to compare.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\QuaternionBenchmark.cpp Code\Maths\CommonMaths.cpp
+//     g++ -std=c++17 -O2 Tools/Tests/QuaternionBenchmark.cpp Code/Maths/CommonMaths.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../Code/Maths/CommonMaths.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const unsigned int kCheckCount = 1000000;
+	const float        kMaxError   = 1e-6f;
+
+	// Small, as a frame's mouse movement would be
+	const float        kPitchAngle = 0.0013f;
+	const float        kYawAngle   = 0.0021f;
+
+	// MovementCheck() with 'A', space and 'W' held. Kept out of line, so that each frame is one call as it is in the camera.
+#if defined(_MSC_VER)
+	__declspec(noinline)
+#else
+	__attribute__((noinline))
+#endif
+	void MoveFocalPoint(Vector3D& focalPoint, Vector3D& right, Vector3D& up, float movementSpeed, float deltaTime)
+	{
+		focalPoint += (right * -movementSpeed) * deltaTime;
+		focalPoint += (Vector3D::worldUp * movementSpeed) * deltaTime;
+
+		Vector3D facingDirection = right.Cross(up);
+		facingDirection.y = 0.0f;
+		facingDirection.Normalise();
+
+		focalPoint += (facingDirection * movementSpeed) * deltaTime;
+	}
+
+	float Difference(const Vector3D& a, const Vector3D& b)
+	{
+		return std::max(fabsf(a.x - b.x), std::max(fabsf(a.y - b.y), fabsf(a.z - b.z)));
+	}
+
+	Vector3D RandomUnitVector(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+		Vector3D vector;
+
+		do
+		{
+			vector = Vector3D(unit(random), unit(random), unit(random));
+		} while (vector.LengthSquared() < 0.01f || vector.LengthSquared() > 1.0f);
+
+		return vector.Normalised();
+	}
+
+	double MillionsPerSecond(std::chrono::steady_clock::time_point startTime, unsigned int count)
+	{
+		return count / std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int frameCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 10000000;
+
+	if (frameCount == 0)
+	{
+		printf("Usage: QuaternionBenchmark [frames]\n");
+		return 1;
+	}
+
+	//------------------------ Against the matrices ------------------------//
+	// A fixed seed, so that every run checks the same rotations
+	std::mt19937                          random(2);
+	std::uniform_real_distribution<float> angles(-PI, PI);
+
+	float axisError = 0.0f, frameError = 0.0f, matrixError = 0.0f;
+
+	for (unsigned int check = 0; check < kCheckCount; check++)
+	{
+		Vector3D axis   = RandomUnitVector(random);
+		Vector3D vector = RandomUnitVector(random);
+		float    pitch  = angles(random);
+		float    yaw    = angles(random);
+
+		// (vector * matrix) rotates by the negative angle, so the quaternions are built with it negated
+		Quaternion rotation = Quaternion::FromAxisAngle(axis, -pitch);
+
+		axisError   = std::max(axisError,   Difference(vector * MatrixMaths::AxisRotationMatrix(axis, pitch), rotation.RotateVector(vector)));
+		matrixError = std::max(matrixError, Difference(vector * rotation.ConvertToRotationMatrix3X3(), rotation.RotateVector(vector)));
+
+		// A whole frame of mouse look - the pitch about the axis, then the yaw about the world up
+		Vector3D byMatrices = (vector * MatrixMaths::AxisRotationMatrix(axis, pitch)) * MatrixMaths::GetYAxisRotationMatrix(yaw);
+		rotation            = Quaternion::FromAxisAngle(Vector3D::worldUp, -yaw) * rotation;
+
+		frameError = std::max(frameError, Difference(byMatrices, rotation.RotateVector(vector)));
+	}
+
+	bool passed = axisError <= kMaxError && matrixError <= kMaxError && frameError <= kMaxError;
+
+	printf("%u random unit vectors and rotations, largest difference from the matrices:\n", kCheckCount);
+	printf("  about one axis %.2e, pitch then yaw %.2e, ConvertToRotationMatrix3X3() %.2e\n", axisError, frameError, matrixError);
+
+	//------------------------ Camera mouse look ------------------------//
+	// The matrix path, as RotationalCheck() was before the quaternions
+	Vector3D offset(0.0f, 0.0f, -10.0f), right(1.0f, 0.0f, 0.0f), up(0.0f, 1.0f, 0.0f);
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameCount; frame++)
+	{
+		offset *= MatrixMaths::AxisRotationMatrix(right, kPitchAngle);
+		right  *= MatrixMaths::AxisRotationMatrix(right, kPitchAngle);
+		up     *= MatrixMaths::AxisRotationMatrix(right, kPitchAngle);
+
+		offset *= MatrixMaths::GetYAxisRotationMatrix(kYawAngle);
+		right  *= MatrixMaths::GetYAxisRotationMatrix(kYawAngle);
+		up     *= MatrixMaths::GetYAxisRotationMatrix(kYawAngle);
+
+		right.Normalise();
+		up.Normalise();
+	}
+
+	double matrixRate = MillionsPerSecond(startTime, frameCount);
+
+	// The quaternion path, as RotationalCheck() is now
+	const Vector3D baseRight(1.0f, 0.0f, 0.0f), baseUp(0.0f, 1.0f, 0.0f);
+
+	Quaternion orientation;
+	Vector3D   quaternionRight = baseRight, quaternionUp = baseUp;
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameCount; frame++)
+	{
+		Quaternion rotation = Quaternion::FromAxisAngle(Vector3D::worldUp, -kYawAngle) * Quaternion::FromAxisAngle(quaternionRight, -kPitchAngle);
+		orientation         = rotation * orientation;
+
+		if (fabsf(orientation.LengthSquared() - 1.0f) > 1e-4f)
+			orientation.Normalise();
+
+		quaternionRight = orientation.RotateVector(baseRight);
+		quaternionUp    = orientation.RotateVector(baseUp);
+	}
+
+	double quaternionRate = MillionsPerSecond(startTime, frameCount);
+
+	// Printed, so that neither loop can be optimised away
+	printf("%u frames of a pitch and a yaw\n", frameCount);
+	printf("  matrices     %5.1f M frames/s (right %.3f %.3f %.3f)\n", matrixRate, right.x, right.y, right.z);
+	printf("  quaternions  %5.1f M frames/s (right %.3f %.3f %.3f)\n", quaternionRate, quaternionRight.x, quaternionRight.y, quaternionRight.z);
+
+	//------------------------ Camera movement ------------------------//
+	Vector3D focalPoint(0.0f, 0.0f, 0.0f);
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameCount; frame++)
+		MoveFocalPoint(focalPoint, quaternionRight, quaternionUp, 0.1f, 0.016f);
+
+	double movementTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / frameCount;
+
+	printf("  movement     %5.1f ns a frame (focal point %.1f %.1f %.1f)\n", movementTime, focalPoint.x, focalPoint.y, focalPoint.z);
+
+	printf("%s\n", passed ? "The quaternions rotate as the matrices do" : "The quaternions and the matrices disagree");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,258 @@
+// Checks CollisionBVH::RayCastPacket() against casting each ray on its own, and times the two - see Code/Collisions/CollisionBVH.h.
+//
+//     RayPacketTest [packet count]
+//
+// Defaults to 100k packets over TestTrack's banked bend with walls. Three kinds are traced: coherent ones, laid out like a car's wheel rays
+// pointing nearly straight down, wider cones from the same spots, and incoherent ones with every ray somewhere different. Some rays
+// are left out with a zero distance and some have no direction at all. Every ray must find the same hit as RayCast(), though either
+// triangle will do where it passes through an edge, and a second query carried through the same hits must write nothing, as nothing
+// is nearer. Exits with 1 if any ray differs.
+//
+//     cl /std:c++17 /O2 /EHsc /arch:AVX Tools\Tests\RayPacketTest.cpp Code\Collisions\CollisionBVH.cpp Code\Maths\CommonMaths.cpp
+//     g++ -std=c++17 -O2 -mavx Tools/Tests/RayPacketTest.cpp Code/Collisions/CollisionBVH.cpp Code/Maths/CommonMaths.cpp
+
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../Code/Collisions/CollisionBVH.h"
+
+#include "TestTrack.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float        kMaxRayDistance = 100.0f;
+	const unsigned int kPieceId        = 7;
+
+	// Both cast the same ray through the same triangles, but the packet's nodes are tested a lane at a time
+	const float        kMaxError       = 1e-4f;
+
+	enum class PacketKind : unsigned int
+	{
+		WHEELS = 0, // Four wheels, each a pair of rays a little apart, pointing nearly straight down
+		CONES,      // The same spots, but spread over a wide cone
+		SCATTERED,  // Every ray from somewhere else on the track
+
+		MAX
+	};
+
+	const char* const kPacketKindNames[] = { "Wheel packets", "Cone packets", "Scattered packets" };
+
+	DirectX::XMFLOAT3 RandomPointAbove(std::mt19937& random)
+	{
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		float angle  = unit(random) * TestTrack::kHalfPi;
+		float radius = TestTrack::kBendRadius + (unit(random) - 0.5f) * (TestTrack::kRoadWidth + 2.0f);
+		float height = 6.0f + unit(random) * 2.0f;
+
+		return DirectX::XMFLOAT3(radius * cosf(angle), height, radius * sinf(angle));
+	}
+
+	void BuildPackets(PacketKind kind, unsigned int packetCount, std::vector<RayPacket>& packetsOut)
+	{
+		// A fixed seed per kind, so that every run traces the same rays
+		std::mt19937                          random(1 + (unsigned int)kind);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		packetsOut.resize(packetCount);
+
+		for (unsigned int packet = 0; packet < packetCount; packet++)
+		{
+			DirectX::XMFLOAT3 car    = RandomPointAbove(random);
+			float             spread = kind == PacketKind::CONES ? 1.0f : (kind == PacketKind::WHEELS ? 0.05f : 0.2f);
+
+			for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+			{
+				DirectX::XMFLOAT3 origin;
+
+				if (kind == PacketKind::SCATTERED)
+				{
+					origin = RandomPointAbove(random);
+				}
+				else
+				{
+					// Wheels at the corners of the car, and with 8 lanes a second ray just behind each
+					float across = (ray & 1) ? 0.8f : -0.8f;
+					float along  = (ray & 2) ? 1.3f : -1.3f;
+
+					origin = DirectX::XMFLOAT3(car.x + across + (ray >= 4 ? 0.1f : 0.0f), car.y, car.z + along);
+				}
+
+				DirectX::XMFLOAT3 direction((unit(random) - 0.5f) * spread, -1.0f, (unit(random) - 0.5f) * spread);
+
+				// Now and then a ray with no direction, which can never hit anything
+				if (ray == kRayPacketSize - 1 && packet % 97 == 0)
+					direction = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+
+				packetsOut[packet].SetRay(ray, origin, direction);
+			}
+		}
+	}
+
+	// Now and then a ray left out of the query
+	float GetStartDistance(unsigned int packet, unsigned int ray)
+	{
+		return (packet % 13 == 0 && ray == 1) ? 0.0f : kMaxRayDistance;
+	}
+
+	void ResetHits(unsigned int packet, RayPacketHits& hitsOut)
+	{
+		for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+		{
+			hitsOut.distance[ray] = GetStartDistance(packet, ray);
+			hitsOut.pieceId[ray]  = ~0u;
+		}
+	}
+
+	// Returns how many rays the packet and RayCast() disagree on
+	unsigned int CheckPacket(const CollisionBVH& bvh, const RayPacket& rays, unsigned int packet, unsigned int& hitCountOut, unsigned int& edgeTieCountOut)
+	{
+		RayPacketHits hits;
+		ResetHits(packet, hits);
+
+		unsigned int hitMask    = bvh.RayCastPacket(rays, kPieceId, hits);
+		unsigned int mismatches = 0;
+
+		for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+		{
+			DirectX::XMFLOAT3 origin(rays.originX[ray], rays.originY[ray], rays.originZ[ray]);
+			DirectX::XMFLOAT3 direction(rays.directionX[ray], rays.directionY[ray], rays.directionZ[ray]);
+
+			CollisionHit hit;
+			bool         found       = bvh.RayCast(origin, direction, GetStartDistance(packet, ray), hit);
+			bool         packetFound = (hitMask & (1u << ray)) != 0;
+
+			bool agrees = found == packetFound;
+
+			if (agrees && found)
+			{
+				agrees = fabsf(hit.distance - hits.distance[ray]) <= kMaxError && hits.pieceId[ray] == kPieceId;
+
+				// A ray through an edge hits both triangles at the same distance, and which is kept depends on which is visited first
+				if (hit.triangleIndex != hits.triangleIndex[ray])
+				{
+					edgeTieCountOut++;
+				}
+				else
+				{
+					agrees = agrees && fabsf(hit.normal.x - hits.normalX[ray]) <= kMaxError && fabsf(hit.normal.y - hits.normalY[ray]) <= kMaxError &&
+					         fabsf(hit.normal.z - hits.normalZ[ray]) <= kMaxError;
+				}
+			}
+
+			mismatches  += agrees ? 0 : 1;
+			hitCountOut += found ? 1 : 0;
+		}
+
+		// Carried through a second query of the same piece, nothing is nearer than what was found, so nothing may be written
+		RayPacketHits carried = hits;
+
+		if (bvh.RayCastPacket(rays, kPieceId + 1, carried) != 0)
+			mismatches++;
+
+		return mismatches;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int packetCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 100000;
+
+	if (packetCount == 0)
+	{
+		printf("Usage: RayPacketTest [packet count]\n");
+		return 1;
+	}
+
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int>      indices;
+
+	TestTrack::Build(TestTrack::kDefaultSegments, TestTrack::kDefaultLanes, positions, indices);
+
+	CollisionBVH bvh;
+
+	if (!bvh.Build(positions, indices))
+	{
+		printf("Could not build the hierarchy\n");
+		return 1;
+	}
+
+#if defined(SIMD_LANES_AVX)
+	printf("AVX packets of %u rays", kRayPacketSize);
+#elif defined(SIMD_LANES_SSE)
+	printf("SSE packets of %u rays", kRayPacketSize);
+#else
+	printf("Scalar packets of %u rays", kRayPacketSize);
+#endif
+	printf(" over %u triangles\n", bvh.GetTriangleCount());
+
+	bool                   passed = true;
+	std::vector<RayPacket> packets;
+	double                 sink   = 0.0; // Printed, so that the timed loops are not optimised away
+
+	for (unsigned int kind = 0; kind < (unsigned int)PacketKind::MAX; kind++)
+	{
+		BuildPackets((PacketKind)kind, packetCount, packets);
+
+		//------------------------ Agreement ------------------------//
+		unsigned int mismatches = 0, hitCount = 0, edgeTieCount = 0;
+
+		for (unsigned int packet = 0; packet < packetCount; packet++)
+			mismatches += CheckPacket(bvh, packets[packet], packet, hitCount, edgeTieCount);
+
+		//------------------------ Throughput ------------------------//
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int packet = 0; packet < packetCount; packet++)
+		{
+			for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+			{
+				const RayPacket& rays = packets[packet];
+				CollisionHit     hit;
+
+				if (bvh.RayCast(DirectX::XMFLOAT3(rays.originX[ray], rays.originY[ray], rays.originZ[ray]), DirectX::XMFLOAT3(rays.directionX[ray], rays.directionY[ray], rays.directionZ[ray]),
+				                kMaxRayDistance, hit))
+					sink += hit.distance;
+			}
+		}
+
+		double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int packet = 0; packet < packetCount; packet++)
+		{
+			RayPacketHits hits;
+
+			for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+				hits.distance[ray] = kMaxRayDistance;
+
+			unsigned int hitMask = bvh.RayCastPacket(packets[packet], kPieceId, hits);
+
+			for (unsigned int ray = 0; ray < kRayPacketSize; ray++)
+				sink += (hitMask & (1u << ray)) ? hits.distance[ray] : 0.0f;
+		}
+
+		double packetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		double rayCount      = (double)packetCount * kRayPacketSize;
+
+		printf("%s: %u of %u rays disagree (%u hit, %u on an edge between two triangles)\n", kPacketKindNames[kind], mismatches, packetCount * kRayPacketSize, hitCount, edgeTieCount);
+		printf("  RayCast %.2f M rays/s, RayCastPacket %.2f M rays/s (%.2fx)\n", rayCount / singleSeconds / 1.0e6, rayCount / packetSeconds / 1.0e6, singleSeconds / packetSeconds);
+
+		passed = passed && mismatches == 0;
+	}
+
+	printf("%s (checksum %.0f)\n", passed ? "Packets and single rays agree" : "Packets and single rays disagree", sink);
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,113 @@
+#ifndef _TEST_TRACK_H_
+#define _TEST_TRACK_H_
+
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <DirectXMath.h>
+
+// -------------------------------------------------------------------- //
+
+// The surface the collision tests run against - a road grid that banks and climbs through a 90 degree bend around the origin, with a
+// thin wall up each edge. The bend runs from +x round to +z, kBendRadius out along the middle of the road. The road's height wobbles
+// a little from vertex to vertex, so that no two neighbouring triangles are quite flat with each other.
+struct TestTrack final
+{
+public:
+	static void Build(unsigned int segments, unsigned int lanes, std::vector<DirectX::XMFLOAT3>& positionsOut, std::vector<unsigned int>& indicesOut);
+
+	// The same mesh as an OBJ, for tests that load it the way the game loads a piece
+	static bool WriteObj(const std::string& filePath, unsigned int segments, unsigned int lanes);
+
+	static constexpr float        kBendRadius      = 40.0f;
+	static constexpr float        kRoadWidth       = 12.0f;
+	static constexpr float        kWallHeight      = 1.2f;
+	static constexpr float        kHalfPi          = 1.5707963f;
+
+	// About 13k triangles
+	static constexpr unsigned int kDefaultSegments = 256;
+	static constexpr unsigned int kDefaultLanes    = 24;
+};
+
+// -------------------------------------------------------------------- //
+
+inline void TestTrack::Build(unsigned int segments, unsigned int lanes, std::vector<DirectX::XMFLOAT3>& positionsOut, std::vector<unsigned int>& indicesOut)
+{
+	for (unsigned int segment = 0; segment <= segments; segment++)
+	{
+		float angle = kHalfPi * segment / segments;
+		float bank  = 0.15f * sinf(angle * 2.0f);
+
+		for (unsigned int lane = 0; lane <= lanes; lane++)
+		{
+			float offset = -kRoadWidth * 0.5f + kRoadWidth * lane / lanes;
+			float radius = kBendRadius + offset;
+			float height = offset * bank + 0.05f * sinf(segment * 0.7f) * cosf(lane * 1.3f) + 3.0f * segment / segments;
+
+			positionsOut.push_back(DirectX::XMFLOAT3(radius * cosf(angle), height, radius * sinf(angle)));
+		}
+	}
+
+	for (unsigned int segment = 0; segment < segments; segment++)
+	{
+		for (unsigned int lane = 0; lane < lanes; lane++)
+		{
+			unsigned int a = segment * (lanes + 1) + lane;
+			unsigned int b = a + 1;
+			unsigned int c = a + lanes + 1;
+			unsigned int d = c + 1;
+
+			indicesOut.insert(indicesOut.end(), { a, c, b, b, c, d });
+		}
+	}
+
+	for (unsigned int side = 0; side < 2; side++)
+	{
+		unsigned int base = (unsigned int)positionsOut.size();
+
+		for (unsigned int segment = 0; segment <= segments; segment++)
+		{
+			DirectX::XMFLOAT3 edge = positionsOut[segment * (lanes + 1) + (side ? lanes : 0)];
+
+			positionsOut.push_back(edge);
+			positionsOut.push_back(DirectX::XMFLOAT3(edge.x, edge.y + kWallHeight, edge.z));
+		}
+
+		for (unsigned int segment = 0; segment < segments; segment++)
+		{
+			unsigned int a = base + segment * 2;
+
+			indicesOut.insert(indicesOut.end(), { a, a + 1, a + 2, a + 1, a + 3, a + 2 });
+		}
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+inline bool TestTrack::WriteObj(const std::string& filePath, unsigned int segments, unsigned int lanes)
+{
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int>      indices;
+
+	Build(segments, lanes, positions, indices);
+
+	FILE* file = fopen(filePath.c_str(), "w");
+
+	if (!file)
+		return false;
+
+	for (const DirectX::XMFLOAT3& position : positions)
+		fprintf(file, "v %.6f %.6f %.6f\n", position.x, position.y, position.z);
+
+	// OBJ indices count from 1
+	for (size_t i = 0; i < indices.size(); i += 3)
+		fprintf(file, "f %u %u %u\n", indices[i] + 1, indices[i + 1] + 1, indices[i + 2] + 1);
+
+	return fclose(file) == 0;
+}
+
+// -------------------------------------------------------------------- //
+
+#endif
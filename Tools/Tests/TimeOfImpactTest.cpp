@@ -0,0 +1,347 @@
+// Checks TrackCollision's sphere and capsule time of impact against sub-stepping the same motion finely, shows what a plain overlap
+// test at 60 and 240 Hz would miss, and times each query - see Code/Collisions/TrackCollision.h.
+//
+//     TimeOfImpactTest [speed in m/s]
+//
+// Defaults to 100 m/s, so that a 60 Hz step moves 1.67 m - several times the 0.3 m radius. Half the bodies dive at the road of TestTrack's
+// banked bend, some only grazing it, and half are thrown sideways at its walls, which are single sided and have no thickness at all. The
+// sphere must touch no later than 4000 sub-steps of ClosestPoint() find it touching, and no earlier than the sub-step before. The
+// capsule must touch no later than a chain of spheres along its axis, and at the time it reports, the contact must sit on its surface.
+// Exits with 1 if either query misses a hit or gets its time wrong.
+//
+// The track is written to the temporary directory as an OBJ, loaded the way the game loads a piece, and removed afterwards.
+//
+//     cl /std:c++17 /O2 /EHsc /arch:AVX Tools\Tests\TimeOfImpactTest.cpp Code\Collisions\TrackCollision.cpp Code\Collisions\CollisionBVH.cpp
+//        Code\Collisions\CollisionCache.cpp Code\Models\ObjParser.cpp Code\Models\MeshCache.cpp Code\Memory\AssetArchive.cpp
+//        Code\Memory\FileUtils.cpp Code\Memory\LZ4.cpp Code\Memory\MappedFile.cpp Code\Maths\CommonMaths.cpp
+//     g++ -std=c++17 -O2 -mavx Tools/Tests/TimeOfImpactTest.cpp Code/Collisions/TrackCollision.cpp Code/Collisions/CollisionBVH.cpp
+//         Code/Collisions/CollisionCache.cpp Code/Models/ObjParser.cpp Code/Models/MeshCache.cpp Code/Memory/AssetArchive.cpp
+//         Code/Memory/FileUtils.cpp Code/Memory/LZ4.cpp Code/Memory/MappedFile.cpp Code/Maths/CommonMaths.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "../../Code/Collisions/TrackCollision.h"
+
+#include "TestTrack.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float        kStepSeconds       = 1.0f / 60.0f;
+	const float        kRadius            = 0.3f;
+	const float        kCapsuleHalfLength = 0.8f;
+
+	const unsigned int kCaseCount         = 2000;
+	const unsigned int kSubStepCount      = 4000;
+	const unsigned int kChainSphereCount  = 400;
+	const unsigned int kBenchmarkRepeats  = 50;
+
+	// In metres - how far the capsule may touch ahead of its chain of spheres, which bulge in less between their centres, and how
+	// far off its surface the contact may be
+	const float        kMaxChainLead      = 2e-3f;
+	const float        kMaxContactError   = 2e-3f;
+
+	struct Case final
+	{
+		DirectX::XMFLOAT3 centre;
+		DirectX::XMFLOAT3 motion;      // Over one 60 Hz step
+		DirectX::XMFLOAT3 halfAxis;    // From the capsule's centre to one end of its segment
+	};
+
+	DirectX::XMFLOAT3 Add(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b, float scale = 1.0f)
+	{
+		return DirectX::XMFLOAT3(a.x + b.x * scale, a.y + b.y * scale, a.z + b.z * scale);
+	}
+
+	DirectX::XMFLOAT3 Subtract(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b)
+	{
+		return DirectX::XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z);
+	}
+
+	float Length(const DirectX::XMFLOAT3& v)
+	{
+		return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+	}
+
+	DirectX::XMFLOAT3 Normalised(const DirectX::XMFLOAT3& v, float length = 1.0f)
+	{
+		float scale = length / Length(v);
+
+		return DirectX::XMFLOAT3(v.x * scale, v.y * scale, v.z * scale);
+	}
+
+	void BuildCases(const TrackCollision& collision, float speed, std::vector<Case>& casesOut)
+	{
+		// A fixed seed, so that every run throws the same bodies
+		std::mt19937                          random(5);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		while ((unsigned int)casesOut.size() < kCaseCount)
+		{
+			bool              atWall = (casesOut.size() & 1) != 0;
+			float             angle  = unit(random) * TestTrack::kHalfPi;
+			DirectX::XMFLOAT3 origin, direction;
+
+			// Find a point on the road from above, or on a wall from the middle of the road
+			if (atWall)
+			{
+				float heading = unit(random) * 4.0f * TestTrack::kHalfPi;
+
+				origin    = DirectX::XMFLOAT3(TestTrack::kBendRadius * cosf(angle), 1.0f + unit(random) * 2.5f, TestTrack::kBendRadius * sinf(angle));
+				direction = DirectX::XMFLOAT3(cosf(heading), 0.0f, sinf(heading));
+			}
+			else
+			{
+				float radius = TestTrack::kBendRadius + (unit(random) - 0.5f) * TestTrack::kRoadWidth;
+
+				origin    = DirectX::XMFLOAT3(radius * cosf(angle), 8.0f, radius * sinf(angle));
+				direction = DirectX::XMFLOAT3(0.0f, -1.0f, 0.0f);
+			}
+
+			CollisionHit hit;
+
+			if (!collision.RayCast(origin, direction, 50.0f, hit))
+				continue;
+
+			// Start a little off the surface, heading into it - straight on for some, grazing for others
+			DirectX::XMFLOAT3 wobble(unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f);
+			DirectX::XMFLOAT3 into = Normalised(Add(DirectX::XMFLOAT3(-hit.normal.x, -hit.normal.y, -hit.normal.z), wobble, 1.5f * unit(random)));
+			DirectX::XMFLOAT3 axis(unit(random) - 0.5f, unit(random) - 0.5f, unit(random) - 0.5f);
+
+			Case body;
+			body.centre   = Add(hit.position, hit.normal, kRadius + 0.05f + unit(random) * 1.2f);
+			body.motion   = Normalised(into, speed * kStepSeconds);
+			body.halfAxis = Normalised(axis, kCapsuleHalfLength);
+
+			casesOut.push_back(body);
+		}
+	}
+
+	// The first sub-step at which the sphere overlaps the surface, as a fraction of the step, or -1 if it never does
+	float SubStepTimeOfImpact(const TrackCollision& collision, const DirectX::XMFLOAT3& centre, const DirectX::XMFLOAT3& motion, unsigned int subStepCount, unsigned int firstSubStep = 0)
+	{
+		CollisionHit hit;
+
+		for (unsigned int subStep = firstSubStep; subStep <= subStepCount; subStep++)
+		{
+			if (collision.ClosestPoint(Add(centre, motion, (float)subStep / subStepCount), kRadius, hit))
+				return (float)subStep / subStepCount;
+		}
+
+		return -1.0f;
+	}
+
+	double MicrosecondsPerQuery(std::chrono::steady_clock::time_point startTime, unsigned int queryCount)
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count() / queryCount;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	float speed = argc > 1 ? (float)atof(argv[1]) : 100.0f;
+
+	if (!(speed > 0.0f))
+	{
+		printf("Usage: TimeOfImpactTest [speed in m/s]\n");
+		return 1;
+	}
+
+	std::error_code error;
+	std::string     trackPath = (std::filesystem::temp_directory_path(error) / "TimeOfImpactTest.obj").string();
+
+	if (!TestTrack::WriteObj(trackPath, TestTrack::kDefaultSegments, TestTrack::kDefaultLanes))
+	{
+		printf("Could not write %s\n", trackPath.c_str());
+		return 1;
+	}
+
+	bool passed = true;
+
+	// Scoped, so that the cache is closed before it is removed
+	{
+		TrackCollision collision(trackPath);
+
+		if (!collision.GetIsLoaded())
+		{
+			printf("Could not load %s\n", trackPath.c_str());
+			return 1;
+		}
+
+		std::vector<Case> cases;
+		BuildCases(collision, speed, cases);
+
+		float stepLength = speed * kStepSeconds;
+
+		printf("%u bodies at %.0f m/s - %.2f m per 60 Hz step, radius %.2f m\n", kCaseCount, speed, stepLength, kRadius);
+
+		//------------------------ Spheres ------------------------//
+		unsigned int hitCount = 0, realHitCount = 0, wrongCount = 0, missed60 = 0, missed240 = 0;
+		float        worstEarly = 0.0f;
+
+		for (const Case& body : cases)
+		{
+			float        time;
+			CollisionHit hit;
+			bool         found    = collision.SphereTimeOfImpact(body.centre, kRadius, body.motion, time, hit);
+			float        fineTime = SubStepTimeOfImpact(collision, body.centre, body.motion, kSubStepCount);
+			bool         realHit  = fineTime >= 0.0f;
+
+			hitCount     += found ? 1 : 0;
+			realHitCount += realHit ? 1 : 0;
+
+			// A hit within the last sub-step is one the sub-steps could not see
+			bool correct = found == realHit || (found && time > 1.0f - 1.0f / kSubStepCount);
+
+			if (found && realHit)
+			{
+				float early = (fineTime - time) * stepLength;
+
+				correct    = correct && time <= fineTime + 1e-4f && early <= stepLength / kSubStepCount + 1e-4f;
+				worstEarly = std::max(worstEarly, early);
+			}
+
+			wrongCount += correct ? 0 : 1;
+
+			// An overlap test at the end of each step, or of each of four steps, instead
+			if (realHit && SubStepTimeOfImpact(collision, body.centre, body.motion, 1, 1) < 0.0f)
+				missed60++;
+
+			if (realHit && SubStepTimeOfImpact(collision, body.centre, body.motion, 4, 1) < 0.0f)
+				missed240++;
+		}
+
+		printf("Spheres: %u hit (%u by %u sub-steps), %u wrong, at most %.2e m before the first touching sub-step\n", hitCount, realHitCount, kSubStepCount, wrongCount, worstEarly);
+		printf("  overlap tests instead would miss %u at 60 Hz and %u at 240 Hz\n", missed60, missed240);
+
+		passed = passed && wrongCount == 0;
+
+		//------------------------ Capsules ------------------------//
+		unsigned int capsuleHitCount = 0, chainHitCount = 0, capsuleWrongCount = 0;
+		float        worstLead = 0.0f, worstContact = 0.0f;
+
+		for (const Case& body : cases)
+		{
+			DirectX::XMFLOAT3 start   = Subtract(body.centre, body.halfAxis);
+			DirectX::XMFLOAT3 end     = Add(body.centre, body.halfAxis);
+			DirectX::XMFLOAT3 segment = Subtract(end, start);
+
+			float        time;
+			CollisionHit hit;
+			bool         found = collision.CapsuleTimeOfImpact(start, end, kRadius, body.motion, time, hit);
+
+			// The capsule is the union of the spheres along its segment, so it can touch no later than the first of them
+			float chainTime = 2.0f;
+
+			for (unsigned int sphere = 0; sphere <= kChainSphereCount; sphere++)
+			{
+				float        sphereTime;
+				CollisionHit sphereHit;
+
+				if (collision.SphereTimeOfImpact(Add(start, segment, (float)sphere / kChainSphereCount), kRadius, body.motion, sphereTime, sphereHit))
+					chainTime = std::min(chainTime, sphereTime);
+			}
+
+			bool chainHit = chainTime <= 1.0f;
+			bool correct  = !chainHit || (found && time <= chainTime + 1e-5f);
+
+			// Ahead of the chain only by as much as the chain bulges in between its spheres
+			if (found)
+			{
+				float lead = ((chainHit ? chainTime : 1.0f) - time) * stepLength;
+
+				correct   = correct && lead <= kMaxChainLead;
+				worstLead = std::max(worstLead, lead);
+			}
+
+			// At the time of impact, the contact is one radius from the moved segment
+			if (found && time > 0.0f)
+			{
+				DirectX::XMFLOAT3 movedStart = Add(start, body.motion, time);
+				DirectX::XMFLOAT3 toContact  = Subtract(hit.position, movedStart);
+				float             along      = (toContact.x * segment.x + toContact.y * segment.y + toContact.z * segment.z) / (segment.x * segment.x + segment.y * segment.y + segment.z * segment.z);
+				float             contact    = fabsf(Length(Subtract(hit.position, Add(movedStart, segment, std::min(std::max(along, 0.0f), 1.0f)))) - kRadius);
+
+				correct      = correct && contact <= kMaxContactError;
+				worstContact = std::max(worstContact, contact);
+			}
+
+			capsuleHitCount   += found ? 1 : 0;
+			chainHitCount     += chainHit ? 1 : 0;
+			capsuleWrongCount += correct ? 0 : 1;
+		}
+
+		printf("Capsules, %.2f m long: %u hit (%u by a chain of %u spheres), %u wrong, at most %.2e m ahead of the chain, contact within %.2e m of the surface\n",
+		       kCapsuleHalfLength * 2.0f, capsuleHitCount, chainHitCount, kChainSphereCount + 1, capsuleWrongCount, worstLead, worstContact);
+
+		passed = passed && capsuleWrongCount == 0;
+
+		//------------------------ Cost per query ------------------------//
+		unsigned int queryCount = kCaseCount * kBenchmarkRepeats;
+		double       sink       = 0.0; // Printed, so that the timed loops are not optimised away
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int repeat = 0; repeat < kBenchmarkRepeats; repeat++)
+		{
+			for (const Case& body : cases)
+			{
+				float        time;
+				CollisionHit hit;
+
+				if (collision.SphereTimeOfImpact(body.centre, kRadius, body.motion, time, hit))
+					sink += time;
+			}
+		}
+
+		double sphereCost = MicrosecondsPerQuery(startTime, queryCount);
+
+		startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int repeat = 0; repeat < kBenchmarkRepeats; repeat++)
+		{
+			for (const Case& body : cases)
+			{
+				float        time;
+				CollisionHit hit;
+
+				if (collision.CapsuleTimeOfImpact(Subtract(body.centre, body.halfAxis), Add(body.centre, body.halfAxis), kRadius, body.motion, time, hit))
+					sink += time;
+			}
+		}
+
+		double capsuleCost = MicrosecondsPerQuery(startTime, queryCount);
+
+		startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int repeat = 0; repeat < kBenchmarkRepeats; repeat++)
+		{
+			for (const Case& body : cases)
+				sink += SubStepTimeOfImpact(collision, body.centre, body.motion, 4, 1);
+		}
+
+		double overlapCost = MicrosecondsPerQuery(startTime, queryCount);
+
+		printf("Per query: sphere %.2f us, capsule %.2f us, four 240 Hz overlap tests %.2f us (checksum %.0f)\n", sphereCost, capsuleCost, overlapCost, sink);
+	}
+
+	std::filesystem::remove(trackPath, error);
+	std::filesystem::remove(trackPath + kCollisionCacheExtension, error);
+
+	printf("%s\n", passed ? "Every time of impact is right" : "Some times of impact are wrong");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
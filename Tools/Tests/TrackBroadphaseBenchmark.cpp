@@ -0,0 +1,283 @@
+// Times TrackBroadphase over a long track with packs of cars driving along it, and checks what it finds against testing everything
+// against everything - see Code/Collisions/TrackBroadphase.h.
+//
+//     TrackBroadphaseBenchmark [piece count] [frames]
+//
+// Defaults to a 100k piece track laid by a random walk through the grid, and 300 frames each with 1k, 4k and 10k cars bunched up along
+// the first stretch of it. Each frame moves every car, updates the sweep, and gathers the overlapping pairs and the pieces under each
+// car. The pairs are then checked against testing every pair of boxes, and the pieces under the first few hundred cars against every
+// piece on the track. Exits with 1 if the broadphase misses anything or finds something that is not there.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\TrackBroadphaseBenchmark.cpp Code\Collisions\*.cpp Code\Track\TrackGrid.cpp Code\Track\TrackPiece.cpp
+//        Code\Models\*.cpp Code\Shaders\ShaderHandler.cpp Code\Memory\*.cpp Code\Maths\*.cpp Code\Camera\Frustum.cpp Code\Threading\WorkerPool.cpp
+//        d3d11.lib d3dcompiler.lib
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+#include "../../Code/Collisions/TrackBroadphase.h"
+#include "../../Code/Collisions/TrackCollision.h"
+#include "../../Code/Models/Model.h"
+#include "../../Code/Shaders/ShaderHandler.h"
+#include "../../Code/Track/TrackGrid.h"
+#include "../../Code/Track/TrackPiece.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const float        kCellSize          = 10.0f;
+	const unsigned int kBodyCounts[]      = { 1000, 4000, 10000 };
+	const unsigned int kPieceCheckCount   = 300;
+
+	// Where the walk starts, well inside the grid so that it can wander any way
+	const unsigned int kStartCoordinate   = 100000;
+
+	const float        kTurnChance        = 0.1f;
+	const float        kClimbChance       = 0.02f;
+
+	typedef std::pair<unsigned int, unsigned int> BodyPair;
+
+	// A car driving along the track - how far along it (in pieces), how fast, and how far off the centre line
+	struct Car final
+	{
+		float distance;
+		float speed;
+		float offset;
+	};
+
+	// Turns left or right now and then, and climbs or drops a level now and then. Cells the walk has already been through are skipped.
+	void LayTrack(unsigned int pieceCount, Model& model, TrackCollision& collision, TrackGrid& gridOut, std::vector<TrackPiece*>& pathOut)
+	{
+		const int directionX[4] = { 1, 0, -1, 0 };
+		const int directionZ[4] = { 0, 1, 0, -1 };
+
+		std::mt19937                          random(3);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		DirectX::XMUINT3 cell(kStartCoordinate, 10, kStartCoordinate);
+		unsigned int     direction = 0;
+
+		gridOut.Reserve(pieceCount);
+		pathOut.reserve(pieceCount);
+
+		while ((unsigned int)pathOut.size() < pieceCount)
+		{
+			TrackPiece* piece = new TrackPiece(TrackPieceType(0), model, collision);
+
+			piece->SetGridPosition(cell);
+			piece->SetFacingDirection(DirectX::XMFLOAT3((float)directionX[direction], 0.0f, (float)directionZ[direction]));
+
+			if (gridOut.Insert(piece))
+				pathOut.push_back(piece);
+			else
+				delete piece;
+
+			float turn = unit(random);
+
+			if (turn < kTurnChance)
+				direction = (direction + 1) & 3;
+			else if (turn < kTurnChance * 2.0f)
+				direction = (direction + 3) & 3;
+
+			cell.x += directionX[direction];
+			cell.z += directionZ[direction];
+
+			if (unit(random) < kClimbChance)
+				cell.y += unit(random) < 0.5f ? 1 : -1;
+		}
+	}
+
+	// A 2 x 2 x 2 box around the car, between the two pieces it is between
+	void GetCarBounds(const Car& car, const std::vector<TrackPiece*>& path, DirectX::XMFLOAT3& boundsMinOut, DirectX::XMFLOAT3& boundsMaxOut)
+	{
+		unsigned int piece    = (unsigned int)car.distance % ((unsigned int)path.size() - 1);
+		float        fraction = car.distance - (float)(unsigned int)car.distance;
+
+		const DirectX::XMUINT3& from = path[piece]->GetGridPosition();
+		const DirectX::XMUINT3& to   = path[piece + 1]->GetGridPosition();
+
+		float x = ((float)from.x + ((float)to.x - (float)from.x) * fraction) * kCellSize + car.offset;
+		float y = ((float)from.y + ((float)to.y - (float)from.y) * fraction) * kCellSize;
+		float z = ((float)from.z + ((float)to.z - (float)from.z) * fraction) * kCellSize + car.offset;
+
+		boundsMinOut = DirectX::XMFLOAT3(x - 1.0f, y - 0.5f, z - 1.0f);
+		boundsMaxOut = DirectX::XMFLOAT3(x + 1.0f, y + 1.5f, z + 1.0f);
+	}
+
+	bool GetDoBoxesOverlap(const DirectX::XMFLOAT3& minA, const DirectX::XMFLOAT3& maxA, const DirectX::XMFLOAT3& minB, const DirectX::XMFLOAT3& maxB)
+	{
+		return minA.x <= maxB.x && minB.x <= maxA.x && minA.y <= maxB.y && minB.y <= maxA.y && minA.z <= maxB.z && minB.z <= maxA.z;
+	}
+
+	double Microseconds(std::chrono::steady_clock::time_point startTime)
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	// Returns false if the broadphase disagrees with brute force
+	bool Run(unsigned int bodyCount, unsigned int frameCount, const std::vector<TrackPiece*>& path, const TrackGrid& grid)
+	{
+		std::mt19937                          random(bodyCount);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		TrackBroadphase   broadphase(grid, kCellSize);
+		std::vector<Car>  cars(bodyCount);
+		DirectX::XMFLOAT3 boundsMin, boundsMax;
+
+		// Spread over half a piece per car, so that they run in packs that keep overtaking each other
+		for (Car& car : cars)
+		{
+			car.distance = unit(random) * bodyCount * 0.5f;
+			car.speed    = 0.05f + unit(random) * 0.05f;
+			car.offset   = (unit(random) - 0.5f) * 8.0f;
+
+			GetCarBounds(car, path, boundsMin, boundsMax);
+			broadphase.AddBody(boundsMin, boundsMax);
+		}
+
+		broadphase.Update();
+
+		//------------------------ Frames ------------------------//
+		double       moveTime = 0.0, updateTime = 0.0, pairTime = 0.0, pieceTime = 0.0;
+		unsigned int pairCount = 0, candidateCount = 0;
+
+		for (unsigned int frame = 0; frame < frameCount; frame++)
+		{
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			for (unsigned int body = 0; body < bodyCount; body++)
+			{
+				cars[body].distance += cars[body].speed;
+
+				GetCarBounds(cars[body], path, boundsMin, boundsMax);
+				broadphase.MoveBody(body, boundsMin, boundsMax);
+			}
+
+			moveTime  += Microseconds(startTime);
+			startTime  = std::chrono::steady_clock::now();
+
+			broadphase.Update();
+
+			updateTime += Microseconds(startTime);
+			startTime   = std::chrono::steady_clock::now();
+
+			broadphase.ForEachBodyPair([&](unsigned int, unsigned int) { pairCount++; });
+
+			pairTime  += Microseconds(startTime);
+			startTime  = std::chrono::steady_clock::now();
+
+			broadphase.ForEachPieceCandidate([&](const TrackPieceCandidate&) { candidateCount++; });
+
+			pieceTime += Microseconds(startTime);
+		}
+
+		printf("%u cars, per frame over %u frames\n", bodyCount, frameCount);
+		printf("  move %.1f us, update %.1f us, pairs %.1f us (%.1f found), pieces %.1f us (%.1f found)\n", moveTime / frameCount, updateTime / frameCount,
+		       pairTime / frameCount, (double)pairCount / frameCount, pieceTime / frameCount, (double)candidateCount / frameCount);
+
+		//------------------------ Pairs against brute force ------------------------//
+		std::vector<DirectX::XMFLOAT3> mins(bodyCount), maxs(bodyCount);
+
+		for (unsigned int body = 0; body < bodyCount; body++)
+			GetCarBounds(cars[body], path, mins[body], maxs[body]);
+
+		std::vector<BodyPair> sweepPairs, brutePairs;
+
+		broadphase.ForEachBodyPair([&](unsigned int a, unsigned int b) { sweepPairs.push_back(BodyPair(std::min(a, b), std::max(a, b))); });
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		for (unsigned int a = 0; a < bodyCount; a++)
+		{
+			for (unsigned int b = a + 1; b < bodyCount; b++)
+			{
+				if (GetDoBoxesOverlap(mins[a], maxs[a], mins[b], maxs[b]))
+					brutePairs.push_back(BodyPair(a, b));
+			}
+		}
+
+		double bruteTime = Microseconds(startTime);
+
+		std::sort(sweepPairs.begin(), sweepPairs.end());
+
+		bool pairsMatch = sweepPairs == brutePairs;
+
+		printf("  every pair against every other %.1f us (%.0fx the update and sweep), %u pairs - %s\n", bruteTime, bruteTime * frameCount / (updateTime + pairTime),
+		       (unsigned int)brutePairs.size(), pairsMatch ? "the same" : "DIFFERENT");
+
+		//------------------------ Pieces against brute force ------------------------//
+		std::vector<unsigned int> sweepPieces(bodyCount, 0), brutePieces(bodyCount, 0);
+		unsigned int              checkCount = std::min(bodyCount, kPieceCheckCount);
+
+		broadphase.ForEachPieceCandidate([&](const TrackPieceCandidate& candidate) { sweepPieces[candidate.body]++; });
+
+		for (unsigned int body = 0; body < checkCount; body++)
+		{
+			for (const TrackPiece* piece : path)
+			{
+				const DirectX::XMUINT3& cell = piece->GetGridPosition();
+
+				DirectX::XMFLOAT3 cellMin(((float)cell.x - 0.5f) * kCellSize, ((float)cell.y - 0.5f) * kCellSize, ((float)cell.z - 0.5f) * kCellSize);
+				DirectX::XMFLOAT3 cellMax(((float)cell.x + 0.5f) * kCellSize, ((float)cell.y + 0.5f) * kCellSize, ((float)cell.z + 0.5f) * kCellSize);
+
+				if (GetDoBoxesOverlap(mins[body], maxs[body], cellMin, cellMax))
+					brutePieces[body]++;
+			}
+		}
+
+		unsigned int pieceMismatches = 0;
+
+		for (unsigned int body = 0; body < checkCount; body++)
+			pieceMismatches += sweepPieces[body] == brutePieces[body] ? 0 : 1;
+
+		printf("  pieces under the first %u cars against every piece - %u differ\n", checkCount, pieceMismatches);
+
+		return pairsMatch && pieceMismatches == 0;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int pieceCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 100000;
+	unsigned int frameCount = argc > 2 ? (unsigned int)atoi(argv[2]) : 300;
+
+	if (pieceCount < 2 || frameCount == 0)
+	{
+		printf("Usage: TrackBroadphaseBenchmark [piece count] [frames]\n");
+		return 1;
+	}
+
+	// Every piece shares one empty model and one empty set of collision data - nothing here draws or collides with them
+	ShaderHandler  shaderHandler(nullptr, nullptr);
+	Model          model(shaderHandler);
+	TrackCollision collision("");
+
+	TrackGrid                grid;
+	std::vector<TrackPiece*> path;
+
+	LayTrack(pieceCount, model, collision, grid, path);
+
+	printf("Track of %u pieces\n", grid.GetCount());
+
+	bool passed = true;
+
+	for (unsigned int bodyCount : kBodyCounts)
+		passed = Run(bodyCount, frameCount, path, grid) && passed;
+
+	for (TrackPiece* piece : path)
+		delete piece;
+
+	printf("%s\n", passed ? "The broadphase finds everything brute force does" : "The broadphase and brute force disagree");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,242 @@
+// Checks TrackGrid against std::unordered_map over a long run of random edits, then times each operation on a large track - see
+// Code/Track/TrackGrid.h.
+//
+//     TrackGridBenchmark [piece count]
+//
+// Defaults to 1M pieces, laid as a 100 x 100 x 100 block of cells spread out along x and z and inserted in shuffled order. Inserts,
+// lookups of cells that are taken and of cells that are not, 6-neighbour queries and removes are each timed over every piece, beside
+// std::unordered_map doing the same inserts and lookups. Before that, 2M random inserts, removes and finds in a small region are
+// compared with std::unordered_map one by one, and so is what ForEach() visits at the end. Exits with 1 if they ever disagree.
+//
+//     cl /std:c++17 /O2 /EHsc Tools\Tests\TrackGridBenchmark.cpp Code\Track\TrackGrid.cpp
+//     g++ -std=c++17 -O2 Tools/Tests/TrackGridBenchmark.cpp Code/Track/TrackGrid.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+
+#include "../../Code/Track/TrackGrid.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	const unsigned int kRandomEditCount = 2000000;
+
+	// Small enough that the random edits keep landing on cells that are already taken
+	const unsigned int kRegionX         = 64;
+	const unsigned int kRegionY         = 8;
+	const unsigned int kRegionZ         = 64;
+
+	unsigned long long GetKey(const DirectX::XMUINT3& cell)
+	{
+		return ((unsigned long long)cell.x << 42) | ((unsigned long long)cell.y << 21) | (unsigned long long)cell.z;
+	}
+
+	// Never dereferenced - the grid only stores the pointers, so any distinct values will do
+	TrackPiece* GetPiece(unsigned long long index)
+	{
+		return reinterpret_cast<TrackPiece*>((uintptr_t)(index + 1) * 8);
+	}
+
+	double MillionsPerSecond(std::chrono::steady_clock::time_point startTime, unsigned int operationCount)
+	{
+		return operationCount / std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	// Returns false at the first result that differs from std::unordered_map's
+	bool CheckRandomEdits()
+	{
+		// A fixed seed, so that every run makes the same edits
+		std::mt19937 random(3);
+
+		TrackGrid                                            grid(8);
+		std::unordered_map<unsigned long long, TrackPiece*> reference;
+
+		for (unsigned int edit = 0; edit < kRandomEditCount; edit++)
+		{
+			DirectX::XMUINT3   cell(random() % kRegionX, random() % kRegionY, random() % kRegionZ);
+			unsigned long long key = GetKey(cell);
+
+			switch (random() % 3)
+			{
+				case 0:
+				{
+					if (grid.Insert(cell, GetPiece(key)) != reference.emplace(key, GetPiece(key)).second)
+					{
+						printf("Insert %u differs\n", edit);
+						return false;
+					}
+
+					break;
+				}
+				case 1:
+				{
+					if (grid.Remove(cell) != (reference.erase(key) > 0))
+					{
+						printf("Remove %u differs\n", edit);
+						return false;
+					}
+
+					break;
+				}
+				default:
+				{
+					auto found = reference.find(key);
+
+					if (grid.Find(cell) != (found == reference.end() ? nullptr : found->second))
+					{
+						printf("Find %u differs\n", edit);
+						return false;
+					}
+
+					break;
+				}
+			}
+		}
+
+		unsigned int visitedCount = 0, wrongCount = 0;
+
+		grid.ForEach([&](const DirectX::XMUINT3& cell, TrackPiece* piece)
+		{
+			auto found = reference.find(GetKey(cell));
+
+			visitedCount++;
+			wrongCount += found != reference.end() && found->second == piece ? 0 : 1;
+		});
+
+		printf("%u random edits, %u pieces left: ForEach() visits %u, %u of them wrong\n", kRandomEditCount, grid.GetCount(), visitedCount, wrongCount);
+
+		return grid.GetCount() == reference.size() && visitedCount == reference.size() && wrongCount == 0;
+	}
+
+	// Cells at the very edge of the grid have no neighbours past it, and cells past it cannot be inserted
+	bool CheckEdges()
+	{
+		TrackGrid   grid;
+		TrackPiece* neighbours[(unsigned int)GridDirection::MAX];
+
+		grid.Insert(DirectX::XMUINT3(0, 0, 0), GetPiece(0));
+		grid.Insert(DirectX::XMUINT3(1, 0, 0), GetPiece(1));
+
+		unsigned int neighbourCount = grid.GetNeighbours(DirectX::XMUINT3(0, 0, 0), neighbours);
+		bool         outsideInsert  = grid.Insert(DirectX::XMUINT3(TrackGrid::kMaxGridCoordinate + 1, 0, 0), GetPiece(2));
+
+		printf("Corner cell has %u neighbours, a cell past the edge %s inserted\n", neighbourCount, outsideInsert ? "IS" : "is not");
+
+		return neighbourCount == 1 && neighbours[(unsigned int)GridDirection::POSITIVE_X] == GetPiece(1) && !outsideInsert;
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int pieceCount = argc > 1 ? (unsigned int)atoi(argv[1]) : 1000000;
+
+	if (pieceCount == 0)
+	{
+		printf("Usage: TrackGridBenchmark [piece count]\n");
+		return 1;
+	}
+
+	//------------------------ Against std::unordered_map ------------------------//
+	bool passed = CheckRandomEdits();
+	passed      = CheckEdges() && passed;
+
+	//------------------------ Throughput ------------------------//
+	unsigned int                  side = 1;
+	std::vector<DirectX::XMUINT3> cells;
+
+	while (side * side * side < pieceCount)
+		side++;
+
+	cells.reserve(side * side * side);
+
+	for (unsigned int x = 0; x < side; x++)
+	{
+		for (unsigned int y = 0; y < side; y++)
+		{
+			for (unsigned int z = 0; z < side; z++)
+				cells.push_back(DirectX::XMUINT3(x * 3 + 1000, y + 5, z * 2 + 77));
+		}
+	}
+
+	cells.resize(pieceCount);
+	std::shuffle(cells.begin(), cells.end(), std::mt19937(7));
+
+	TrackGrid    grid;
+	unsigned int insertCount = 0, hitCount = 0, missCount = 0, neighbourCount = 0, removeCount = 0;
+	TrackPiece*  neighbours[(unsigned int)GridDirection::MAX];
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < pieceCount; i++)
+		insertCount += grid.Insert(cells[i], GetPiece(i)) ? 1 : 0;
+
+	double insertRate = MillionsPerSecond(startTime, pieceCount);
+	startTime         = std::chrono::steady_clock::now();
+
+	for (const DirectX::XMUINT3& cell : cells)
+		hitCount += grid.Find(cell) ? 1 : 0;
+
+	double hitRate = MillionsPerSecond(startTime, pieceCount);
+	startTime      = std::chrono::steady_clock::now();
+
+	// One along from a taken cell - x is spread out in steps of three, so these are all empty
+	for (const DirectX::XMUINT3& cell : cells)
+		missCount += grid.Find(DirectX::XMUINT3(cell.x + 1, cell.y, cell.z)) ? 1 : 0;
+
+	double missRate = MillionsPerSecond(startTime, pieceCount);
+	startTime       = std::chrono::steady_clock::now();
+
+	for (const DirectX::XMUINT3& cell : cells)
+		neighbourCount += grid.GetNeighbours(cell, neighbours);
+
+	double neighbourRate = MillionsPerSecond(startTime, pieceCount);
+	startTime            = std::chrono::steady_clock::now();
+
+	for (const DirectX::XMUINT3& cell : cells)
+		removeCount += grid.Remove(cell) ? 1 : 0;
+
+	double removeRate = MillionsPerSecond(startTime, pieceCount);
+
+	printf("%u pieces, %u slots at the largest\n", pieceCount, grid.GetCapacity());
+	printf("  insert             %6.1f M/s (%u)\n", insertRate, insertCount);
+	printf("  lookup (hit)       %6.1f M/s (%u)\n", hitRate, hitCount);
+	printf("  lookup (miss)      %6.1f M/s (%u)\n", missRate, missCount);
+	printf("  6-neighbour query  %6.1f M/s (%u found)\n", neighbourRate, neighbourCount);
+	printf("  remove             %6.1f M/s (%u)\n", removeRate, removeCount);
+
+	passed = passed && insertCount == pieceCount && hitCount == pieceCount && missCount == 0 && removeCount == pieceCount && grid.GetCount() == 0;
+
+	//------------------------ std::unordered_map ------------------------//
+	std::unordered_map<unsigned long long, TrackPiece*> reference;
+	unsigned int                                         referenceHitCount = 0;
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < pieceCount; i++)
+		reference[GetKey(cells[i])] = GetPiece(i);
+
+	double referenceInsertRate = MillionsPerSecond(startTime, pieceCount);
+	startTime                  = std::chrono::steady_clock::now();
+
+	for (const DirectX::XMUINT3& cell : cells)
+		referenceHitCount += (unsigned int)reference.count(GetKey(cell));
+
+	double referenceHitRate = MillionsPerSecond(startTime, pieceCount);
+
+	printf("  std::unordered_map: insert %.1f M/s, lookup (hit) %.1f M/s (%u)\n", referenceInsertRate, referenceHitRate, referenceHitCount);
+
+	printf("%s\n", passed ? "TrackGrid agrees with std::unordered_map" : "TrackGrid and std::unordered_map disagree");
+
+	return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //
@@ -0,0 +1,229 @@
+// Checks the Vector3Batch and Vector4Batch kernels against the same maths done one Vector3D/Vector4D at a time, then times a
+// transform followed by a normalise both ways - see Code/Maths/VectorBatch.h.
+//
+//     VectorBatchBenchmark [vector count] [repeats]
+//
+// Defaults to 1M vectors and 20 repeats. Exits with 1 if any kernel strays from the per-element result by more than rounding.
+// The kernels are picked at compile time, so build it once per instruction set to compare them.
+//
+//     cl /std:c++17 /O2 /EHsc /arch:AVX Tools\Tests\VectorBatchBenchmark.cpp Code\Maths\VectorBatch.cpp Code\Maths\CommonMaths.cpp
+//     g++ -std=c++17 -O2 -mavx Tools/Tests/VectorBatchBenchmark.cpp Code/Maths/VectorBatch.cpp Code/Maths/CommonMaths.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../../Code/Maths/SIMDLanes.h"
+#include "../../Code/Maths/VectorBatch.h"
+
+// -------------------------------------------------------------------- //
+
+namespace
+{
+	// Both paths round differently (a divide against a multiply by the reciprocal, and so on), so they only have to agree this closely
+	const float kMaxRelativeError = 1e-5f;
+
+	unsigned int gFailureCount = 0;
+
+	float RelativeError(float expected, float actual)
+	{
+		return fabsf(expected - actual) / std::max(1.0f, fabsf(expected));
+	}
+
+	float RelativeError(const Vector3D& expected, const Vector3D& actual)
+	{
+		return std::max(RelativeError(expected.x, actual.x), std::max(RelativeError(expected.y, actual.y), RelativeError(expected.z, actual.z)));
+	}
+
+	float RelativeError(const Vector4D& expected, const Vector4D& actual)
+	{
+		return std::max(std::max(RelativeError(expected.x, actual.x), RelativeError(expected.y, actual.y)),
+		                std::max(RelativeError(expected.z, actual.z), RelativeError(expected.w, actual.w)));
+	}
+
+	void Report(const char* kernel, float maxError)
+	{
+		bool passed = maxError <= kMaxRelativeError;
+
+		printf("  %-24s max relative error %.2e %s\n", kernel, maxError, passed ? "" : "FAILED");
+
+		if (!passed)
+			gFailureCount++;
+	}
+
+	// Runs a kernel over the whole batch, then compares every output against expected(i)
+	template<typename Batch, typename Expected>
+	void Check(const char* kernel, const Batch& batchOut, unsigned int count, Expected expected)
+	{
+		float maxError = batchOut.Count() == count ? 0.0f : 1.0f;
+
+		for (unsigned int i = 0; i < count && i < batchOut.Count(); i++)
+			maxError = std::max(maxError, RelativeError(expected(i), batchOut.Get(i)));
+
+		Report(kernel, maxError);
+	}
+
+	template<typename Expected>
+	void CheckScalars(const char* kernel, const std::vector<float>& out, unsigned int count, Expected expected)
+	{
+		float maxError = out.size() == count ? 0.0f : 1.0f;
+
+		for (unsigned int i = 0; i < count && i < out.size(); i++)
+			maxError = std::max(maxError, RelativeError(expected(i), out[i]));
+
+		Report(kernel, maxError);
+	}
+
+	// Row vector * matrix, the convention Vector4Batch::Transform() follows
+	Vector4D Transform(const Vector4D& vector, const DirectX::XMFLOAT4X4& matrix)
+	{
+		return Vector4D((vector.x * matrix._11) + (vector.y * matrix._21) + (vector.z * matrix._31) + (vector.w * matrix._41),
+		                (vector.x * matrix._12) + (vector.y * matrix._22) + (vector.z * matrix._32) + (vector.w * matrix._42),
+		                (vector.x * matrix._13) + (vector.y * matrix._23) + (vector.z * matrix._33) + (vector.w * matrix._43),
+		                (vector.x * matrix._14) + (vector.y * matrix._24) + (vector.z * matrix._34) + (vector.w * matrix._44));
+	}
+
+	double NanosecondsPerVector(std::chrono::steady_clock::time_point startTime, unsigned int vectorCount, unsigned int repeats)
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / ((double)vectorCount * repeats);
+	}
+}
+
+// -------------------------------------------------------------------- //
+
+int main(int argc, char** argv)
+{
+	unsigned int count   = argc > 1 ? (unsigned int)atoi(argv[1]) : 1u << 20;
+	unsigned int repeats = argc > 2 ? (unsigned int)atoi(argv[2]) : 20;
+
+	if (count == 0 || repeats == 0)
+	{
+		printf("Usage: VectorBatchBenchmark [vector count] [repeats]\n");
+		return 1;
+	}
+
+#if defined(SIMD_LANES_AVX)
+	printf("AVX kernels, %u lanes\n", kLaneWidth);
+#elif defined(SIMD_LANES_SSE)
+	printf("SSE kernels, %u lanes\n", kLaneWidth);
+#else
+	printf("Scalar kernels\n");
+#endif
+
+	// A fixed seed, so that every build checks the same vectors
+	std::mt19937                          random(1);
+	std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+
+	std::vector<Vector3D> a3(count), b3(count);
+	std::vector<Vector4D> a4(count), b4(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		a3[i] = Vector3D(coordinate(random), coordinate(random), coordinate(random));
+		b3[i] = Vector3D(coordinate(random), coordinate(random), coordinate(random));
+		a4[i] = Vector4D(coordinate(random), coordinate(random), coordinate(random), coordinate(random));
+		b4[i] = Vector4D(coordinate(random), coordinate(random), coordinate(random), coordinate(random));
+	}
+
+	DirectX::XMFLOAT3X3 rotation = MatrixMaths::AxisRotationMatrix(Vector3D(0.0f, 1.0f, 0.0f), 0.3f);
+	DirectX::XMFLOAT4X4 transform( 0.8f, 0.1f, -0.6f, 0.0f,
+	                               0.2f, 0.9f,  0.3f, 0.0f,
+	                               0.6f, -0.4f, 0.7f, 0.0f,
+	                               1.0f, -2.0f, 3.0f, 1.0f);
+
+	//------------------------ Accuracy ------------------------//
+	printf("Vector3Batch against Vector3D over %u vectors\n", count);
+
+	Vector3Batch       a3Batch(a3.data(), count), b3Batch(b3.data(), count), out3;
+	std::vector<float> scalarsOut;
+
+	Vector3Batch::Add(a3Batch, b3Batch, out3);        Check("Add",            out3, count, [&](unsigned int i) { return a3[i] + b3[i]; });
+	Vector3Batch::Subtract(a3Batch, b3Batch, out3);   Check("Subtract",       out3, count, [&](unsigned int i) { return a3[i] - b3[i]; });
+	Vector3Batch::Scale(a3Batch, 2.5f, out3);         Check("Scale",          out3, count, [&](unsigned int i) { return a3[i] * 2.5f; });
+	Vector3Batch::Cross(a3Batch, b3Batch, out3);      Check("Cross",          out3, count, [&](unsigned int i) { return a3[i].Cross(b3[i]); });
+	Vector3Batch::Normalise(a3Batch, out3);           Check("Normalise",      out3, count, [&](unsigned int i) { return a3[i].Normalised(); });
+	Vector3Batch::Transform(a3Batch, rotation, out3); Check("Transform",      out3, count, [&](unsigned int i) { return a3[i] * rotation; });
+
+	Vector3Batch::TransformPoint(a3Batch, transform, out3);
+	Check("TransformPoint", out3, count, [&](unsigned int i)
+	{
+		Vector4D point = Transform(Vector4D(a3[i].x, a3[i].y, a3[i].z, 1.0f), transform);
+
+		return Vector3D(point.x, point.y, point.z);
+	});
+
+	Vector3Batch::Dot(a3Batch, b3Batch, scalarsOut);  CheckScalars("Dot",         scalarsOut, count, [&](unsigned int i) { return a3[i].Dot(b3[i]); });
+	Vector3Batch::Length(a3Batch, scalarsOut);        CheckScalars("Length",      scalarsOut, count, [&](unsigned int i) { return a3[i].Length(); });
+
+	printf("Vector4Batch against Vector4D over %u vectors\n", count);
+
+	Vector4Batch a4Batch(a4.data(), count), b4Batch(b4.data(), count), out4;
+
+	Vector4Batch::Add(a4Batch, b4Batch, out4);         Check("Add",           out4, count, [&](unsigned int i) { return a4[i] + b4[i]; });
+	Vector4Batch::Subtract(a4Batch, b4Batch, out4);    Check("Subtract",      out4, count, [&](unsigned int i) { return a4[i] - b4[i]; });
+	Vector4Batch::Scale(a4Batch, 2.5f, out4);          Check("Scale",         out4, count, [&](unsigned int i) { return a4[i] * 2.5f; });
+	Vector4Batch::Normalise(a4Batch, out4);            Check("Normalise",     out4, count, [&](unsigned int i) { return a4[i].Normalised(); });
+	Vector4Batch::Transform(a4Batch, transform, out4); Check("Transform",     out4, count, [&](unsigned int i) { return Transform(a4[i], transform); });
+
+	Vector4Batch::Dot(a4Batch, b4Batch, scalarsOut);   CheckScalars("Dot",    scalarsOut, count, [&](unsigned int i) { return a4[i].Dot(b4[i]); });
+	Vector4Batch::Length(a4Batch, scalarsOut);         CheckScalars("Length", scalarsOut, count, [&](unsigned int i) { return a4[i].Length(); });
+
+	// Kernels taking two batches must stop at the end of the shorter one
+	Vector3Batch shorter3(b3.data(), count / 2);
+	Vector4Batch shorter4(b4.data(), count / 2);
+
+	Vector3Batch::Add(a3Batch, shorter3, out3);
+	Vector4Batch::Dot(a4Batch, shorter4, scalarsOut);
+
+	bool shorterPassed = out3.Count() == count / 2 && scalarsOut.size() == count / 2;
+
+	printf("  %-24s %s\n", "Shorter second batch", shorterPassed ? "stops at the shorter batch" : "FAILED");
+
+	if (!shorterPassed)
+		gFailureCount++;
+
+	//------------------------ Throughput ------------------------//
+	// Rotate then normalise every vector, feeding each repeat's output into the next as a game loop would
+	std::vector<Vector3D> elements = a3;
+	Vector3Batch          batch(a3.data(), count);
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int repeat = 0; repeat < repeats; repeat++)
+	{
+		for (unsigned int i = 0; i < count; i++)
+			elements[i] = (elements[i] * rotation).Normalised();
+	}
+
+	double elementNanoseconds = NanosecondsPerVector(startTime, count, repeats);
+
+	startTime = std::chrono::steady_clock::now();
+
+	for (unsigned int repeat = 0; repeat < repeats; repeat++)
+	{
+		Vector3Batch::Transform(batch, rotation, batch);
+		Vector3Batch::Normalise(batch, batch);
+	}
+
+	double batchNanoseconds = NanosecondsPerVector(startTime, count, repeats);
+
+	// Also keeps the timed loops from being optimised away
+	float maxDrift = 0.0f;
+
+	for (unsigned int i = 0; i < count; i++)
+		maxDrift = std::max(maxDrift, RelativeError(elements[i], batch.Get(i)));
+
+	printf("Transform then normalise, %u repeats\n", repeats);
+	printf("  per element %.2f ns/vector, batch %.2f ns/vector (%.1fx), results within %.2e of each other\n",
+	       elementNanoseconds, batchNanoseconds, elementNanoseconds / batchNanoseconds, maxDrift);
+
+	printf("%s\n", gFailureCount == 0 ? "All kernels match" : "Some kernels do not match");
+
+	return gFailureCount == 0 ? 0 : 1;
+}
+
+// -------------------------------------------------------------------- //